@@ -34,9 +34,9 @@
 #include "core/math/geometry_3d.h"
 
 int64_t AStar3D::get_available_point_id() const {
-	if (points.has(last_free_id)) {
+	if (has_point(last_free_id)) {
 		int64_t cur_new_id = last_free_id + 1;
-		while (points.has(cur_new_id)) {
+		while (has_point(cur_new_id)) {
 			cur_new_id++;
 		}
 		last_free_id = cur_new_id;
@@ -49,6 +49,14 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 	ERR_FAIL_COND_MSG(p_id < 0, vformat("Can't add a point with negative id: %d.", p_id));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't add a point with weight scale less than 0.0: %f.", p_weight_scale));
 
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_MSG(index == UINT32_MAX, vformat("Can't add a point with id: %d to a frozen graph, call unfreeze() first.", p_id));
+		frozen_points[index].pos = p_pos;
+		frozen_points[index].weight_scale = p_weight_scale;
+		return;
+	}
+
 	Point **point_entry = points.getptr(p_id);
 
 	if (!point_entry) {
@@ -69,6 +77,12 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 }
 
 Vector3 AStar3D::get_point_position(int64_t p_id) const {
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_V_MSG(index == UINT32_MAX, Vector3(), vformat("Can't get point's position. Point with id: %d doesn't exist.", p_id));
+		return frozen_points[index].pos;
+	}
+
 	Point *const *point_entry = points.getptr(p_id);
 	ERR_FAIL_COND_V_MSG(!point_entry, Vector3(), vformat("Can't get point's position. Point with id: %d doesn't exist.", p_id));
 
@@ -76,6 +90,13 @@ Vector3 AStar3D::get_point_position(int64_t p_id) const {
 }
 
 void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_MSG(index == UINT32_MAX, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
+		frozen_points[index].pos = p_pos;
+		return;
+	}
+
 	Point **point_entry = points.getptr(p_id);
 	ERR_FAIL_COND_MSG(!point_entry, vformat("Can't set point's position. Point with id: %d doesn't exist.", p_id));
 
@@ -83,6 +104,12 @@ void AStar3D::set_point_position(int64_t p_id, const Vector3 &p_pos) {
 }
 
 real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_V_MSG(index == UINT32_MAX, 0, vformat("Can't get point's weight scale. Point with id: %d doesn't exist.", p_id));
+		return frozen_points[index].weight_scale;
+	}
+
 	Point *const *point_entry = points.getptr(p_id);
 	ERR_FAIL_COND_V_MSG(!point_entry, 0, vformat("Can't get point's weight scale. Point with id: %d doesn't exist.", p_id));
 
@@ -90,14 +117,24 @@ real_t AStar3D::get_point_weight_scale(int64_t p_id) const {
 }
 
 void AStar3D::set_point_weight_scale(int64_t p_id, real_t p_weight_scale) {
+	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
+
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_MSG(index == UINT32_MAX, vformat("Can't set point's weight scale. Point with id: %d doesn't exist.", p_id));
+		frozen_points[index].weight_scale = p_weight_scale;
+		return;
+	}
+
 	Point **point_entry = points.getptr(p_id);
 	ERR_FAIL_COND_MSG(!point_entry, vformat("Can't set point's weight scale. Point with id: %d doesn't exist.", p_id));
-	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
 
 	(*point_entry)->weight_scale = p_weight_scale;
 }
 
 void AStar3D::remove_point(int64_t p_id) {
+	ERR_FAIL_COND_MSG(frozen, vformat("Can't remove point with id: %d from a frozen graph, call unfreeze() first.", p_id));
+
 	Point **point_entry = points.getptr(p_id);
 	ERR_FAIL_COND_MSG(!point_entry, vformat("Can't remove point. Point with id: %d doesn't exist.", p_id));
 	Point *p = *point_entry;
@@ -125,6 +162,7 @@ void AStar3D::remove_point(int64_t p_id) {
 
 void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
 	ERR_FAIL_COND_MSG(p_id == p_with_id, vformat("Can't connect point with id: %d to itself.", p_id));
+	ERR_FAIL_COND_MSG(frozen, vformat("Can't connect points with id: %d and %d in a frozen graph, call unfreeze() first.", p_id, p_with_id));
 
 	Point **a_entry = points.getptr(p_id);
 	ERR_FAIL_COND_MSG(!a_entry, vformat("Can't connect points. Point with id: %d doesn't exist.", p_id));
@@ -162,6 +200,8 @@ void AStar3D::connect_points(int64_t p_id, int64_t p_with_id, bool bidirectional
 }
 
 void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectional) {
+	ERR_FAIL_COND_MSG(frozen, vformat("Can't disconnect points with id: %d and %d in a frozen graph, call unfreeze() first.", p_id, p_with_id));
+
 	Point **a_entry = points.getptr(p_id);
 	ERR_FAIL_COND_MSG(!a_entry, vformat("Can't disconnect points. Point with id: %d doesn't exist.", p_id));
 	Point *a = *a_entry;
@@ -202,12 +242,22 @@ void AStar3D::disconnect_points(int64_t p_id, int64_t p_with_id, bool bidirectio
 }
 
 bool AStar3D::has_point(int64_t p_id) const {
+	if (frozen) {
+		return frozen_point_indices.has(p_id);
+	}
 	return points.has(p_id);
 }
 
 PackedInt64Array AStar3D::get_point_ids() {
 	PackedInt64Array point_list;
 
+	if (frozen) {
+		for (const FrozenPoint &frozen_point : frozen_points) {
+			point_list.push_back(frozen_point.id);
+		}
+		return point_list;
+	}
+
 	for (KeyValue<int64_t, Point *> &kv : points) {
 		point_list.push_back(kv.key);
 	}
@@ -216,6 +266,17 @@ PackedInt64Array AStar3D::get_point_ids() {
 }
 
 Vector<int64_t> AStar3D::get_point_connections(int64_t p_id) {
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_V_MSG(index == UINT32_MAX, Vector<int64_t>(), vformat("Can't get point's connections. Point with id: %d doesn't exist.", p_id));
+
+		Vector<int64_t> point_list;
+		for (uint32_t i = frozen_neighbor_offsets[index]; i < frozen_neighbor_offsets[index + 1]; i++) {
+			point_list.push_back(frozen_points[frozen_neighbors[i]].id);
+		}
+		return point_list;
+	}
+
 	Point **p_entry = points.getptr(p_id);
 	ERR_FAIL_COND_V_MSG(!p_entry, Vector<int64_t>(), vformat("Can't get point's connections. Point with id: %d doesn't exist.", p_id));
 
@@ -229,6 +290,15 @@ Vector<int64_t> AStar3D::get_point_connections(int64_t p_id) {
 }
 
 bool AStar3D::are_points_connected(int64_t p_id, int64_t p_with_id, bool bidirectional) const {
+	if (frozen) {
+		const uint32_t a = _get_frozen_point_index(p_id);
+		const uint32_t b = _get_frozen_point_index(p_with_id);
+		if (a == UINT32_MAX || b == UINT32_MAX) {
+			return false;
+		}
+		return _has_frozen_connection(a, b) || (bidirectional && _has_frozen_connection(b, a));
+	}
+
 	Segment s(p_id, p_with_id);
 	const HashSet<Segment, Segment>::Iterator element = segments.find(s);
 
@@ -243,18 +313,34 @@ void AStar3D::clear() {
 	}
 	segments.clear();
 	points.clear();
+
+	frozen = false;
+	frozen_points.clear();
+	frozen_point_indices.clear();
+	frozen_neighbor_offsets.clear();
+	frozen_neighbors.clear();
+	frozen_search_states.clear();
+	frozen_open_list.clear();
+	frozen_last_closest_point = UINT32_MAX;
 }
 
 int64_t AStar3D::get_point_count() const {
+	if (frozen) {
+		return frozen_points.size();
+	}
 	return points.size();
 }
 
 int64_t AStar3D::get_point_capacity() const {
+	if (frozen) {
+		return frozen_points.size();
+	}
 	return points.get_capacity();
 }
 
 void AStar3D::reserve_space(int64_t p_num_nodes) {
 	ERR_FAIL_COND_MSG(p_num_nodes <= 0, vformat("New capacity must be greater than 0, new was: %d.", p_num_nodes));
+	ERR_FAIL_COND_MSG(frozen, "Can't reserve space in a frozen graph, call unfreeze() first.");
 	points.reserve(p_num_nodes);
 }
 
@@ -262,6 +348,24 @@ int64_t AStar3D::get_closest_point(const Vector3 &p_point, bool p_include_disabl
 	int64_t closest_id = -1;
 	real_t closest_dist = 1e20;
 
+	if (frozen) {
+		for (const FrozenPoint &frozen_point : frozen_points) {
+			if (!p_include_disabled && !frozen_point.enabled) {
+				continue; // Disabled points should not be considered.
+			}
+
+			real_t d = p_point.distance_squared_to(frozen_point.pos);
+			if (d <= closest_dist) {
+				if (d == closest_dist && frozen_point.id > closest_id) { // Keep lowest ID.
+					continue;
+				}
+				closest_dist = d;
+				closest_id = frozen_point.id;
+			}
+		}
+		return closest_id;
+	}
+
 	for (const KeyValue<int64_t, Point *> &kv : points) {
 		if (!p_include_disabled && !kv.value->enabled) {
 			continue; // Disabled points should not be considered.
@@ -287,6 +391,30 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 	real_t closest_dist = 1e20;
 	Vector3 closest_point;
 
+	if (frozen) {
+		for (uint32_t i = 0; i < frozen_points.size(); i++) {
+			const FrozenPoint &from_point = frozen_points[i];
+			if (!from_point.enabled) {
+				continue;
+			}
+
+			for (uint32_t j = frozen_neighbor_offsets[i]; j < frozen_neighbor_offsets[i + 1]; j++) {
+				const FrozenPoint &to_point = frozen_points[frozen_neighbors[j]];
+				if (!to_point.enabled) {
+					continue;
+				}
+
+				Vector3 p = Geometry3D::get_closest_point_to_segment(p_point, from_point.pos, to_point.pos);
+				real_t d = p_point.distance_squared_to(p);
+				if (d < closest_dist) {
+					closest_point = p;
+					closest_dist = d;
+				}
+			}
+		}
+		return closest_point;
+	}
+
 	for (const Segment &E : segments) {
 		const Point *from_point = *points.getptr(E.key.first);
 		const Point *to_point = *points.getptr(E.key.second);
@@ -378,12 +506,296 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_
 	return found_route;
 }
 
+void AStar3D::freeze() {
+	if (frozen) {
+		return;
+	}
+
+	frozen_points.resize(points.size());
+	frozen_point_indices.reserve(points.size());
+	frozen_neighbor_offsets.resize(points.size() + 1);
+
+	uint32_t index = 0;
+	uint32_t neighbor_count = 0;
+	for (const KeyValue<int64_t, Point *> &kv : points) {
+		FrozenPoint &frozen_point = frozen_points[index];
+		frozen_point.id = kv.key;
+		frozen_point.pos = kv.value->pos;
+		frozen_point.weight_scale = kv.value->weight_scale;
+		frozen_point.enabled = kv.value->enabled;
+		frozen_point_indices.insert_new(kv.key, index);
+
+		frozen_neighbor_offsets[index] = neighbor_count;
+		neighbor_count += kv.value->neighbors.size();
+		index++;
+	}
+	frozen_neighbor_offsets[index] = neighbor_count;
+
+	frozen_neighbors.resize(neighbor_count);
+	index = 0;
+	for (const KeyValue<int64_t, Point *> &kv : points) {
+		uint32_t neighbor_index = frozen_neighbor_offsets[index++];
+		for (const KeyValue<int64_t, Point *> &neighbor_kv : kv.value->neighbors) {
+			frozen_neighbors[neighbor_index++] = frozen_point_indices[neighbor_kv.key];
+		}
+	}
+
+	// The unlinked neighbors and segments can be rebuilt from the connections, so the per point allocations are released.
+	for (KeyValue<int64_t, Point *> &kv : points) {
+		memdelete(kv.value);
+	}
+	points.reset();
+	segments.reset();
+	last_closest_point = nullptr;
+
+	frozen = true;
+}
+
+void AStar3D::unfreeze() {
+	if (!frozen) {
+		return;
+	}
+
+	frozen = false;
+
+	points.reserve(frozen_points.size());
+	for (const FrozenPoint &frozen_point : frozen_points) {
+		Point *pt = memnew(Point);
+		pt->id = frozen_point.id;
+		pt->pos = frozen_point.pos;
+		pt->weight_scale = frozen_point.weight_scale;
+		pt->enabled = frozen_point.enabled;
+		points.insert_new(frozen_point.id, pt);
+	}
+
+	for (uint32_t i = 0; i < frozen_points.size(); i++) {
+		for (uint32_t j = frozen_neighbor_offsets[i]; j < frozen_neighbor_offsets[i + 1]; j++) {
+			connect_points(frozen_points[i].id, frozen_points[frozen_neighbors[j]].id, false);
+		}
+	}
+
+	frozen_points.reset();
+	frozen_point_indices.reset();
+	frozen_neighbor_offsets.reset();
+	frozen_neighbors.reset();
+	frozen_search_states.reset();
+	frozen_open_list.reset();
+	frozen_last_closest_point = UINT32_MAX;
+}
+
+bool AStar3D::is_frozen() const {
+	return frozen;
+}
+
+uint32_t AStar3D::_get_frozen_point_index(int64_t p_id) const {
+	const uint32_t *index = frozen_point_indices.getptr(p_id);
+	return index ? *index : UINT32_MAX;
+}
+
+uint32_t AStar3D::_get_frozen_cost_point_index(int64_t p_id, uint32_t p_hint) const {
+	if (p_hint < frozen_points.size() && frozen_points[p_hint].id == p_id) {
+		return p_hint;
+	}
+	return _get_frozen_point_index(p_id);
+}
+
+bool AStar3D::_has_frozen_connection(uint32_t p_from, uint32_t p_to) const {
+	for (uint32_t i = frozen_neighbor_offsets[p_from]; i < frozen_neighbor_offsets[p_from + 1]; i++) {
+		if (frozen_neighbors[i] == p_to) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool AStar3D::_is_frozen_point_worse(uint32_t p_a, uint32_t p_b) const {
+	// Same order as SortPoints.
+	const FrozenSearchState &a = frozen_search_states[p_a];
+	const FrozenSearchState &b = frozen_search_states[p_b];
+	if (a.f_score != b.f_score) {
+		return a.f_score > b.f_score;
+	}
+	return a.g_score < b.g_score;
+}
+
+// The open list heap mirrors SortArray::push_heap() and SortArray::pop_heap(), so a frozen graph finds the same paths,
+// but it keeps the index of each open point to update it without searching the open list.
+void AStar3D::_frozen_open_list_push(uint32_t p_hole_index, uint32_t p_top_index, uint32_t p_point) {
+	uint32_t *open_list = frozen_open_list.ptr();
+	FrozenSearchState *states = frozen_search_states.ptr();
+
+	while (p_hole_index > p_top_index) {
+		const uint32_t parent = (p_hole_index - 1) / 2;
+		if (!_is_frozen_point_worse(open_list[parent], p_point)) {
+			break;
+		}
+		open_list[p_hole_index] = open_list[parent];
+		states[open_list[p_hole_index]].open_list_index = p_hole_index;
+		p_hole_index = parent;
+	}
+
+	open_list[p_hole_index] = p_point;
+	states[p_point].open_list_index = p_hole_index;
+}
+
+void AStar3D::_frozen_open_list_pop() {
+	uint32_t *open_list = frozen_open_list.ptr();
+	FrozenSearchState *states = frozen_search_states.ptr();
+
+	const uint32_t len = frozen_open_list.size() - 1;
+	const uint32_t last_point = open_list[len];
+
+	uint32_t hole_index = 0;
+	uint32_t second_child = 2;
+	while (second_child < len) {
+		if (_is_frozen_point_worse(open_list[second_child], open_list[second_child - 1])) {
+			second_child--;
+		}
+		open_list[hole_index] = open_list[second_child];
+		states[open_list[hole_index]].open_list_index = hole_index;
+		hole_index = second_child;
+		second_child = 2 * (second_child + 1);
+	}
+
+	if (second_child == len) {
+		open_list[hole_index] = open_list[second_child - 1];
+		states[open_list[hole_index]].open_list_index = hole_index;
+		hole_index = second_child - 1;
+	}
+
+	_frozen_open_list_push(hole_index, 0, last_point);
+	frozen_open_list.resize(len);
+}
+
+template <typename T>
+bool AStar3D::_solve_frozen(T *p_cost_owner, uint32_t p_begin_point, uint32_t p_end_point, bool p_allow_partial_path) {
+	frozen_last_closest_point = UINT32_MAX;
+	pass++;
+
+	if (!frozen_points[p_end_point].enabled && !p_allow_partial_path) {
+		return false;
+	}
+
+	if (frozen_search_states.size() != frozen_points.size()) {
+		frozen_search_states.resize(frozen_points.size());
+	}
+
+	const FrozenPoint *fps = frozen_points.ptr();
+	const uint32_t *neighbor_offsets = frozen_neighbor_offsets.ptr();
+	const uint32_t *neighbors = frozen_neighbors.ptr();
+	FrozenSearchState *states = frozen_search_states.ptr();
+	const int64_t end_id = fps[p_end_point].id;
+
+	bool found_route = false;
+
+	FrozenSearchState &begin_state = states[p_begin_point];
+	begin_state.g_score = 0;
+	frozen_cost_from_hint = p_begin_point;
+	frozen_cost_to_hint = p_end_point;
+	begin_state.f_score = p_cost_owner->_estimate_cost(fps[p_begin_point].id, end_id);
+	begin_state.abs_g_score = 0;
+	begin_state.abs_f_score = begin_state.f_score;
+	begin_state.open_pass = pass;
+	frozen_open_list.clear();
+	frozen_open_list.push_back(p_begin_point);
+	begin_state.open_list_index = 0;
+
+	while (!frozen_open_list.is_empty()) {
+		const uint32_t p = frozen_open_list[0]; // The currently processed point.
+		FrozenSearchState &p_state = states[p];
+
+		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
+		if (frozen_last_closest_point == UINT32_MAX || states[frozen_last_closest_point].abs_f_score > p_state.abs_f_score || (states[frozen_last_closest_point].abs_f_score >= p_state.abs_f_score && states[frozen_last_closest_point].abs_g_score > p_state.abs_g_score)) {
+			frozen_last_closest_point = p;
+		}
+
+		if (p == p_end_point) {
+			found_route = true;
+			break;
+		}
+
+		_frozen_open_list_pop(); // Remove the current point from the open list.
+		p_state.closed_pass = pass; // Mark the point as closed.
+
+		for (uint32_t i = neighbor_offsets[p]; i < neighbor_offsets[p + 1]; i++) {
+			const uint32_t e = neighbors[i]; // The neighbor point.
+			FrozenSearchState &e_state = states[e];
+
+			if (!fps[e].enabled || e_state.closed_pass == pass) {
+				continue;
+			}
+
+			frozen_cost_from_hint = p;
+			frozen_cost_to_hint = e;
+			real_t tentative_g_score = p_state.g_score + p_cost_owner->_compute_cost(fps[p].id, fps[e].id) * fps[e].weight_scale;
+
+			bool new_point = false;
+
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
+				frozen_open_list.push_back(e);
+				new_point = true;
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
+				continue;
+			}
+
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			frozen_cost_from_hint = e;
+			frozen_cost_to_hint = p_end_point;
+			e_state.f_score = e_state.g_score + p_cost_owner->_estimate_cost(fps[e].id, end_id);
+			e_state.abs_g_score = tentative_g_score;
+			e_state.abs_f_score = e_state.f_score - e_state.g_score;
+
+			if (new_point) { // The position of the new points is already known.
+				_frozen_open_list_push(frozen_open_list.size() - 1, 0, e);
+			} else {
+				_frozen_open_list_push(e_state.open_list_index, 0, e);
+			}
+		}
+	}
+
+	return found_route;
+}
+
+template <typename T>
+bool AStar3D::_get_frozen_path(T *p_cost_owner, uint32_t p_begin_point, uint32_t p_end_point, bool p_allow_partial_path, LocalVector<uint32_t> &r_path) {
+	uint32_t end_point = p_end_point;
+
+	bool found_route = _solve_frozen(p_cost_owner, p_begin_point, p_end_point, p_allow_partial_path);
+	if (!found_route) {
+		if (!p_allow_partial_path || frozen_last_closest_point == UINT32_MAX) {
+			return false;
+		}
+
+		// Use closest point instead.
+		end_point = frozen_last_closest_point;
+	}
+
+	r_path.clear();
+	for (uint32_t p = end_point; p != p_begin_point; p = frozen_search_states[p].prev_point) {
+		r_path.push_back(p);
+	}
+	r_path.push_back(p_begin_point);
+	r_path.reverse();
+
+	return true;
+}
+
 real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_end_id, scost)) {
 		return scost;
 	}
 
+	if (frozen) {
+		const uint32_t from_index = _get_frozen_cost_point_index(p_from_id, frozen_cost_from_hint);
+		ERR_FAIL_COND_V_MSG(from_index == UINT32_MAX, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t end_index = _get_frozen_cost_point_index(p_end_id, frozen_cost_to_hint);
+		ERR_FAIL_COND_V_MSG(end_index == UINT32_MAX, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_end_id));
+		return frozen_points[from_index].pos.distance_to(frozen_points[end_index].pos);
+	}
+
 	Point **from_entry = points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!from_entry, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 	Point *from_point = *from_entry;
@@ -401,6 +813,14 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
+	if (frozen) {
+		const uint32_t from_index = _get_frozen_cost_point_index(p_from_id, frozen_cost_from_hint);
+		ERR_FAIL_COND_V_MSG(from_index == UINT32_MAX, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t to_index = _get_frozen_cost_point_index(p_to_id, frozen_cost_to_hint);
+		ERR_FAIL_COND_V_MSG(to_index == UINT32_MAX, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
+		return frozen_points[from_index].pos.distance_to(frozen_points[to_index].pos);
+	}
+
 	Point **from_entry = points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!from_entry, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 	Point *from_point = *from_entry;
@@ -413,6 +833,29 @@ real_t AStar3D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 }
 
 Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (frozen) {
+		const uint32_t a = _get_frozen_point_index(p_from_id);
+		ERR_FAIL_COND_V_MSG(a == UINT32_MAX, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t b = _get_frozen_point_index(p_to_id);
+		ERR_FAIL_COND_V_MSG(b == UINT32_MAX, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
+
+		LocalVector<uint32_t> frozen_path;
+		if (a == b) {
+			frozen_path.push_back(a);
+		} else if (!_get_frozen_path(this, a, b, p_allow_partial_path, frozen_path)) {
+			return Vector<Vector3>();
+		}
+
+		Vector<Vector3> path;
+		path.resize(frozen_path.size());
+		Vector3 *w = path.ptrw();
+		for (uint32_t i = 0; i < frozen_path.size(); i++) {
+			const FrozenPoint &frozen_point = frozen_points[frozen_path[i]];
+			w[i] = frozen_point.pos;
+		}
+		return path;
+	}
+
 	Point **a_entry = points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!a_entry, Vector<Vector3>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 	Point *a = *a_entry;
@@ -467,6 +910,33 @@ Vector<Vector3> AStar3D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (frozen) {
+		const uint32_t a = _get_frozen_point_index(p_from_id);
+		ERR_FAIL_COND_V_MSG(a == UINT32_MAX, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t b = _get_frozen_point_index(p_to_id);
+		ERR_FAIL_COND_V_MSG(b == UINT32_MAX, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
+
+		if (a != b && !frozen_points[a].enabled) {
+			return Vector<int64_t>();
+		}
+
+		LocalVector<uint32_t> frozen_path;
+		if (a == b) {
+			frozen_path.push_back(a);
+		} else if (!_get_frozen_path(this, a, b, p_allow_partial_path, frozen_path)) {
+			return Vector<int64_t>();
+		}
+
+		Vector<int64_t> path;
+		path.resize(frozen_path.size());
+		int64_t *w = path.ptrw();
+		for (uint32_t i = 0; i < frozen_path.size(); i++) {
+			const FrozenPoint &frozen_point = frozen_points[frozen_path[i]];
+			w[i] = frozen_point.id;
+		}
+		return path;
+	}
+
 	Point **a_entry = points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!a_entry, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 	Point *a = *a_entry;
@@ -525,6 +995,13 @@ Vector<int64_t> AStar3D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 }
 
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_MSG(index == UINT32_MAX, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
+		frozen_points[index].enabled = !p_disabled;
+		return;
+	}
+
 	Point **p_entry = points.getptr(p_id);
 	ERR_FAIL_COND_MSG(!p_entry, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
 	Point *p = *p_entry;
@@ -533,6 +1010,12 @@ void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 }
 
 bool AStar3D::is_point_disabled(int64_t p_id) const {
+	if (frozen) {
+		const uint32_t index = _get_frozen_point_index(p_id);
+		ERR_FAIL_COND_V_MSG(index == UINT32_MAX, false, vformat("Can't get if point is disabled. Point with id: %d doesn't exist.", p_id));
+		return !frozen_points[index].enabled;
+	}
+
 	Point *const *p_entry = points.getptr(p_id);
 	ERR_FAIL_COND_V_MSG(!p_entry, false, vformat("Can't get if point is disabled. Point with id: %d doesn't exist.", p_id));
 	Point *p = *p_entry;
@@ -564,6 +1047,10 @@ void AStar3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar3D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar3D::clear);
 
+	ClassDB::bind_method(D_METHOD("freeze"), &AStar3D::freeze);
+	ClassDB::bind_method(D_METHOD("unfreeze"), &AStar3D::unfreeze);
+	ClassDB::bind_method(D_METHOD("is_frozen"), &AStar3D::is_frozen);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar3D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar3D::get_closest_position_in_segment);
 
@@ -657,6 +1144,18 @@ void AStar2D::reserve_space(int64_t p_num_nodes) {
 	astar.reserve_space(p_num_nodes);
 }
 
+void AStar2D::freeze() {
+	astar.freeze();
+}
+
+void AStar2D::unfreeze() {
+	astar.unfreeze();
+}
+
+bool AStar2D::is_frozen() const {
+	return astar.is_frozen();
+}
+
 int64_t AStar2D::get_closest_point(const Vector2 &p_point, bool p_include_disabled) const {
 	return astar.get_closest_point(Vector3(p_point.x, p_point.y, 0), p_include_disabled);
 }
@@ -672,6 +1171,14 @@ real_t AStar2D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 		return scost;
 	}
 
+	if (astar.frozen) {
+		const uint32_t from_index = astar._get_frozen_cost_point_index(p_from_id, astar.frozen_cost_from_hint);
+		ERR_FAIL_COND_V_MSG(from_index == UINT32_MAX, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t end_index = astar._get_frozen_cost_point_index(p_end_id, astar.frozen_cost_to_hint);
+		ERR_FAIL_COND_V_MSG(end_index == UINT32_MAX, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_end_id));
+		return astar.frozen_points[from_index].pos.distance_to(astar.frozen_points[end_index].pos);
+	}
+
 	AStar3D::Point **from_entry = astar.points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!from_entry, 0, vformat("Can't estimate cost. Point with id: %d doesn't exist.", p_from_id));
 	AStar3D::Point *from_point = *from_entry;
@@ -689,6 +1196,14 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 		return scost;
 	}
 
+	if (astar.frozen) {
+		const uint32_t from_index = astar._get_frozen_cost_point_index(p_from_id, astar.frozen_cost_from_hint);
+		ERR_FAIL_COND_V_MSG(from_index == UINT32_MAX, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t to_index = astar._get_frozen_cost_point_index(p_to_id, astar.frozen_cost_to_hint);
+		ERR_FAIL_COND_V_MSG(to_index == UINT32_MAX, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_to_id));
+		return astar.frozen_points[from_index].pos.distance_to(astar.frozen_points[to_index].pos);
+	}
+
 	AStar3D::Point **from_entry = astar.points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!from_entry, 0, vformat("Can't compute cost. Point with id: %d doesn't exist.", p_from_id));
 	AStar3D::Point *from_point = *from_entry;
@@ -701,6 +1216,29 @@ real_t AStar2D::_compute_cost(int64_t p_from_id, int64_t p_to_id) {
 }
 
 Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (astar.frozen) {
+		const uint32_t a = astar._get_frozen_point_index(p_from_id);
+		ERR_FAIL_COND_V_MSG(a == UINT32_MAX, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t b = astar._get_frozen_point_index(p_to_id);
+		ERR_FAIL_COND_V_MSG(b == UINT32_MAX, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_to_id));
+
+		LocalVector<uint32_t> frozen_path;
+		if (a == b) {
+			frozen_path.push_back(a);
+		} else if (!astar._get_frozen_path(this, a, b, p_allow_partial_path, frozen_path)) {
+			return Vector<Vector2>();
+		}
+
+		Vector<Vector2> path;
+		path.resize(frozen_path.size());
+		Vector2 *w = path.ptrw();
+		for (uint32_t i = 0; i < frozen_path.size(); i++) {
+			const AStar3D::FrozenPoint &frozen_point = astar.frozen_points[frozen_path[i]];
+			w[i] = Vector2(frozen_point.pos.x, frozen_point.pos.y);
+		}
+		return path;
+	}
+
 	AStar3D::Point **a_entry = astar.points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!a_entry, Vector<Vector2>(), vformat("Can't get point path. Point with id: %d doesn't exist.", p_from_id));
 	AStar3D::Point *a = *a_entry;
@@ -754,6 +1292,33 @@ Vector<Vector2> AStar2D::get_point_path(int64_t p_from_id, int64_t p_to_id, bool
 }
 
 Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_allow_partial_path) {
+	if (astar.frozen) {
+		const uint32_t a = astar._get_frozen_point_index(p_from_id);
+		ERR_FAIL_COND_V_MSG(a == UINT32_MAX, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
+		const uint32_t b = astar._get_frozen_point_index(p_to_id);
+		ERR_FAIL_COND_V_MSG(b == UINT32_MAX, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_to_id));
+
+		if (a != b && !astar.frozen_points[a].enabled) {
+			return Vector<int64_t>();
+		}
+
+		LocalVector<uint32_t> frozen_path;
+		if (a == b) {
+			frozen_path.push_back(a);
+		} else if (!astar._get_frozen_path(this, a, b, p_allow_partial_path, frozen_path)) {
+			return Vector<int64_t>();
+		}
+
+		Vector<int64_t> path;
+		path.resize(frozen_path.size());
+		int64_t *w = path.ptrw();
+		for (uint32_t i = 0; i < frozen_path.size(); i++) {
+			const AStar3D::FrozenPoint &frozen_point = astar.frozen_points[frozen_path[i]];
+			w[i] = frozen_point.id;
+		}
+		return path;
+	}
+
 	AStar3D::Point **a_entry = astar.points.getptr(p_from_id);
 	ERR_FAIL_COND_V_MSG(!a_entry, Vector<int64_t>(), vformat("Can't get id path. Point with id: %d doesn't exist.", p_from_id));
 	AStar3D::Point *a = *a_entry;
@@ -907,6 +1472,10 @@ void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("reserve_space", "num_nodes"), &AStar2D::reserve_space);
 	ClassDB::bind_method(D_METHOD("clear"), &AStar2D::clear);
 
+	ClassDB::bind_method(D_METHOD("freeze"), &AStar2D::freeze);
+	ClassDB::bind_method(D_METHOD("unfreeze"), &AStar2D::unfreeze);
+	ClassDB::bind_method(D_METHOD("is_frozen"), &AStar2D::is_frozen);
+
 	ClassDB::bind_method(D_METHOD("get_closest_point", "to_position", "include_disabled"), &AStar2D::get_closest_point, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_closest_position_in_segment", "to_position"), &AStar2D::get_closest_position_in_segment);
 
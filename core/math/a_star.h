@@ -33,6 +33,7 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/templates/a_hash_map.h"
+#include "core/templates/local_vector.h"
 
 /**
 	A* pathfinding algorithm.
@@ -107,6 +108,28 @@ class AStar3D : public RefCounted {
 		}
 	};
 
+	// Compact point of a frozen graph, its connections and search state are stored in separate arrays by point index.
+	struct FrozenPoint {
+		int64_t id = 0;
+		Vector3 pos;
+		real_t weight_scale = 0;
+		bool enabled = false;
+	};
+
+	struct FrozenSearchState {
+		uint32_t prev_point = UINT32_MAX;
+		// Position in the open list while the point is open.
+		uint32_t open_list_index = UINT32_MAX;
+		real_t g_score = 0;
+		real_t f_score = 0;
+		uint64_t open_pass = 0;
+		uint64_t closed_pass = 0;
+
+		// Used for getting closest_point_of_last_pathing_call.
+		real_t abs_g_score = 0;
+		real_t abs_f_score = 0;
+	};
+
 	mutable int64_t last_free_id = 0;
 	uint64_t pass = 1;
 
@@ -114,8 +137,34 @@ class AStar3D : public RefCounted {
 	HashSet<Segment, Segment> segments;
 	Point *last_closest_point = nullptr;
 
+	// Once frozen the graph is only stored in the arrays below, `points` and `segments` are empty.
+	bool frozen = false;
+	LocalVector<FrozenPoint> frozen_points;
+	AHashMap<int64_t, uint32_t> frozen_point_indices;
+	// The connections of point `i` range from `frozen_neighbor_offsets[i]` to `frozen_neighbor_offsets[i + 1]` in `frozen_neighbors`.
+	LocalVector<uint32_t> frozen_neighbor_offsets;
+	LocalVector<uint32_t> frozen_neighbors;
+	// Kept between solves, only the entries whose pass matches the current pass are valid.
+	LocalVector<FrozenSearchState> frozen_search_states;
+	LocalVector<uint32_t> frozen_open_list;
+	uint32_t frozen_last_closest_point = UINT32_MAX;
+	// Indices of the points `_solve_frozen()` asks the cost of, so the default costs don't look them up by id.
+	uint32_t frozen_cost_from_hint = UINT32_MAX;
+	uint32_t frozen_cost_to_hint = UINT32_MAX;
+
 	bool _solve(Point *begin_point, Point *end_point, bool p_allow_partial_path);
 
+	uint32_t _get_frozen_point_index(int64_t p_id) const;
+	uint32_t _get_frozen_cost_point_index(int64_t p_id, uint32_t p_hint) const;
+	bool _has_frozen_connection(uint32_t p_from, uint32_t p_to) const;
+	bool _is_frozen_point_worse(uint32_t p_a, uint32_t p_b) const;
+	void _frozen_open_list_push(uint32_t p_hole_index, uint32_t p_top_index, uint32_t p_point);
+	void _frozen_open_list_pop();
+	template <typename T>
+	bool _solve_frozen(T *p_cost_owner, uint32_t p_begin_point, uint32_t p_end_point, bool p_allow_partial_path);
+	template <typename T>
+	bool _get_frozen_path(T *p_cost_owner, uint32_t p_begin_point, uint32_t p_end_point, bool p_allow_partial_path, LocalVector<uint32_t> &r_path);
+
 protected:
 	static void _bind_methods();
 
@@ -156,6 +205,10 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void freeze();
+	void unfreeze();
+	bool is_frozen() const;
+
 	int64_t get_closest_point(const Vector3 &p_point, bool p_include_disabled = false) const;
 	Vector3 get_closest_position_in_segment(const Vector3 &p_point) const;
 
@@ -168,6 +221,7 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
+	friend class AStar3D;
 	AStar3D astar;
 
 	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path);
@@ -212,6 +266,10 @@ public:
 	void reserve_space(int64_t p_num_nodes);
 	void clear();
 
+	void freeze();
+	void unfreeze();
+	bool is_frozen() const;
+
 	int64_t get_closest_point(const Vector2 &p_point, bool p_include_disabled = false) const;
 	Vector2 get_closest_position_in_segment(const Vector2 &p_point) const;
 
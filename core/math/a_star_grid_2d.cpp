@@ -31,6 +31,7 @@
 #include "a_star_grid_2d.h"
 #include "a_star_grid_2d.compat.inc"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 static real_t heuristic_euclidean(const Vector2i &p_from, const Vector2i &p_to) {
@@ -126,6 +127,8 @@ void AStarGrid2D::update() {
 		return;
 	}
 
+	_clear_search_contexts();
+	clear_flow_field();
 	points.clear();
 	solid_mask.clear();
 
@@ -154,7 +157,7 @@ void AStarGrid2D::update() {
 				default:
 					break;
 			}
-			line.push_back(Point(Vector2i(x, y), v));
+			line.push_back(Point(Vector2i(x, y), v, (y - region.position.y) * region.size.x + x - region.position.x));
 			solid_mask.push_back(false);
 		}
 		solid_mask.push_back(true);
@@ -191,6 +194,7 @@ bool AStarGrid2D::is_jumping_enabled() const {
 void AStarGrid2D::set_diagonal_mode(DiagonalMode p_diagonal_mode) {
 	ERR_FAIL_INDEX((int)p_diagonal_mode, (int)DIAGONAL_MODE_MAX);
 	diagonal_mode = p_diagonal_mode;
+	flow_field_full_update = true;
 }
 
 AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
@@ -200,6 +204,7 @@ AStarGrid2D::DiagonalMode AStarGrid2D::get_diagonal_mode() const {
 void AStarGrid2D::set_default_compute_heuristic(Heuristic p_heuristic) {
 	ERR_FAIL_INDEX((int)p_heuristic, (int)HEURISTIC_MAX);
 	default_compute_heuristic = p_heuristic;
+	flow_field_full_update = true;
 }
 
 AStarGrid2D::Heuristic AStarGrid2D::get_default_compute_heuristic() const {
@@ -218,7 +223,10 @@ AStarGrid2D::Heuristic AStarGrid2D::get_default_estimate_heuristic() const {
 void AStarGrid2D::set_point_solid(const Vector2i &p_id, bool p_solid) {
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set if point is disabled. Point %s out of bounds %s.", p_id, region));
-	_set_solid_unchecked(p_id, p_solid);
+	if (_get_solid_unchecked(p_id) != p_solid) {
+		_set_solid_unchecked(p_id, p_solid);
+		_flow_field_point_changed(p_id.x, p_id.y);
+	}
 }
 
 bool AStarGrid2D::is_point_solid(const Vector2i &p_id) const {
@@ -231,7 +239,11 @@ void AStarGrid2D::set_point_weight_scale(const Vector2i &p_id, real_t p_weight_s
 	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
 	ERR_FAIL_COND_MSG(!is_in_boundsv(p_id), vformat("Can't set point's weight scale. Point %s out of bounds %s.", p_id, region));
 	ERR_FAIL_COND_MSG(p_weight_scale < 0.0, vformat("Can't set point's weight scale less than 0.0: %f.", p_weight_scale));
-	_get_point_unchecked(p_id)->weight_scale = p_weight_scale;
+	Point *p = _get_point_unchecked(p_id);
+	if (p->weight_scale != p_weight_scale) {
+		p->weight_scale = p_weight_scale;
+		_flow_field_point_changed(p_id.x, p_id.y);
+	}
 }
 
 real_t AStarGrid2D::get_point_weight_scale(const Vector2i &p_id) const {
@@ -249,7 +261,10 @@ void AStarGrid2D::fill_solid_region(const Rect2i &p_region, bool p_solid) {
 
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_set_solid_unchecked(x, y, p_solid);
+			if (_get_solid_unchecked(Vector2i(x, y)) != p_solid) {
+				_set_solid_unchecked(x, y, p_solid);
+				_flow_field_point_changed(x, y);
+			}
 		}
 	}
 }
@@ -264,12 +279,16 @@ void AStarGrid2D::fill_weight_scale_region(const Rect2i &p_region, real_t p_weig
 
 	for (int32_t y = safe_region.position.y; y < end_y; y++) {
 		for (int32_t x = safe_region.position.x; x < end_x; x++) {
-			_get_point_unchecked(x, y)->weight_scale = p_weight_scale;
+			Point *p = _get_point_unchecked(x, y);
+			if (p->weight_scale != p_weight_scale) {
+				p->weight_scale = p_weight_scale;
+				_flow_field_point_changed(x, y);
+			}
 		}
 	}
 }
 
-AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
+AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to, Point *p_end) {
 	int32_t from_x = p_from->id.x;
 	int32_t from_y = p_from->id.y;
 
@@ -281,19 +300,19 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	if (diagonal_mode == DIAGONAL_MODE_ALWAYS || diagonal_mode == DIAGONAL_MODE_AT_LEAST_ONE_WALKABLE) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(to_x, to_y, dx, dy);
+			return _forced_successor(to_x, to_y, dx, dy, p_end);
 		}
 
 		while (_is_walkable(to_x, to_y) && (diagonal_mode == DIAGONAL_MODE_ALWAYS || _is_walkable(to_x, to_y - dy) || _is_walkable(to_x - dx, to_y))) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (p_end->id.x == to_x && p_end->id.y == to_y) {
+				return p_end;
 			}
 
 			if ((_is_walkable(to_x - dx, to_y + dy) && !_is_walkable(to_x - dx, to_y)) || (_is_walkable(to_x + dx, to_y - dy) && !_is_walkable(to_x, to_y - dy))) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x + dx, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y + dy, 0, dy) != nullptr) {
+			if (_forced_successor(to_x + dx, to_y, dx, 0, p_end) != nullptr || _forced_successor(to_x, to_y + dy, 0, dy, p_end) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -303,19 +322,19 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else if (diagonal_mode == DIAGONAL_MODE_ONLY_IF_NO_OBSTACLES) {
 		if (dx == 0 || dy == 0) {
-			return _forced_successor(from_x, from_y, dx, dy, true);
+			return _forced_successor(from_x, from_y, dx, dy, p_end, true);
 		}
 
 		while (_is_walkable(to_x, to_y) && _is_walkable(to_x, to_y - dy) && _is_walkable(to_x - dx, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (p_end->id.x == to_x && p_end->id.y == to_y) {
+				return p_end;
 			}
 
 			if ((_is_walkable(to_x + dx, to_y + dy) && !_is_walkable(to_x, to_y + dy)) || !_is_walkable(to_x + dx, to_y)) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x, to_y, dx, 0) != nullptr || _forced_successor(to_x, to_y, 0, dy) != nullptr) {
+			if (_forced_successor(to_x, to_y, dx, 0, p_end) != nullptr || _forced_successor(to_x, to_y, 0, dy, p_end) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -325,19 +344,19 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 
 	} else { // DIAGONAL_MODE_NEVER
 		if (dy == 0) {
-			return _forced_successor(from_x, from_y, dx, 0, true);
+			return _forced_successor(from_x, from_y, dx, 0, p_end, true);
 		}
 
 		while (_is_walkable(to_x, to_y)) {
-			if (end->id.x == to_x && end->id.y == to_y) {
-				return end;
+			if (p_end->id.x == to_x && p_end->id.y == to_y) {
+				return p_end;
 			}
 
 			if ((_is_walkable(to_x - 1, to_y) && !_is_walkable(to_x - 1, to_y - dy)) || (_is_walkable(to_x + 1, to_y) && !_is_walkable(to_x + 1, to_y - dy))) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
-			if (_forced_successor(to_x, to_y, 1, 0, true) != nullptr || _forced_successor(to_x, to_y, -1, 0, true) != nullptr) {
+			if (_forced_successor(to_x, to_y, 1, 0, p_end, true) != nullptr || _forced_successor(to_x, to_y, -1, 0, p_end, true) != nullptr) {
 				return _get_point_unchecked(to_x, to_y);
 			}
 
@@ -348,7 +367,7 @@ AStarGrid2D::Point *AStarGrid2D::_jump(Point *p_from, Point *p_to) {
 	return nullptr;
 }
 
-AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive) {
+AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Point *p_end, bool p_inclusive) {
 	// Remembering previous results can improve performance.
 	bool l_prev = false, r_prev = false, l = false, r = false;
 
@@ -362,8 +381,8 @@ AStarGrid2D::Point *AStarGrid2D::_forced_successor(int32_t p_x, int32_t p_y, int
 	int32_t r_x = p_x + p_dy, r_y = p_y + p_dx;
 
 	while (_is_walkable(o_x, o_y)) {
-		if (end->id.x == o_x && end->id.y == o_y) {
-			return end;
+		if (p_end->id.x == o_x && p_end->id.y == o_y) {
+			return p_end;
 		}
 
 		l_prev = l || _is_walkable(l_x, l_y);
@@ -491,9 +510,44 @@ void AStarGrid2D::_get_nbors(Point *p_point, LocalVector<Point *> &r_nbors) {
 	}
 }
 
-bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
-	last_closest_point = nullptr;
-	pass++;
+AStarGrid2D::SearchContext *AStarGrid2D::_acquire_search_context() {
+	SearchContext *context = nullptr;
+	{
+		MutexLock lock(search_contexts_mutex);
+		if (!search_contexts.is_empty()) {
+			context = search_contexts[search_contexts.size() - 1];
+			search_contexts.remove_at(search_contexts.size() - 1);
+		}
+	}
+
+	if (!context) {
+		context = memnew(SearchContext);
+	}
+
+	const uint32_t point_count = region.get_area();
+	if (context->states.size() != point_count) {
+		context->states.resize(point_count);
+	}
+
+	return context;
+}
+
+void AStarGrid2D::_release_search_context(SearchContext *p_context) {
+	MutexLock lock(search_contexts_mutex);
+	search_contexts.push_back(p_context);
+}
+
+void AStarGrid2D::_clear_search_contexts() {
+	MutexLock lock(search_contexts_mutex);
+	for (SearchContext *context : search_contexts) {
+		memdelete(context);
+	}
+	search_contexts.clear();
+}
+
+bool AStarGrid2D::_solve(SearchContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path) {
+	r_context.last_closest_point = nullptr;
+	r_context.pass++;
 
 	if (_get_solid_unchecked(p_end_point->id) && !p_allow_partial_path) {
 		return false;
@@ -501,23 +555,29 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 	bool found_route = false;
 
-	LocalVector<Point *> open_list;
+	const uint64_t pass = r_context.pass;
+	PointState *states = r_context.states.ptr();
+	LocalVector<Point *> &open_list = r_context.open_list;
+	LocalVector<Point *> &nbors = r_context.nbors;
 	SortArray<Point *, SortPoints> sorter;
-	LocalVector<Point *> nbors;
-
-	p_begin_point->g_score = 0;
-	p_begin_point->f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
-	p_begin_point->abs_g_score = 0;
-	p_begin_point->abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	sorter.compare.states = states;
+
+	PointState &begin_state = states[p_begin_point->index];
+	begin_state.g_score = 0;
+	begin_state.f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	begin_state.abs_g_score = 0;
+	begin_state.abs_f_score = _estimate_cost(p_begin_point->id, p_end_point->id);
+	open_list.clear();
 	open_list.push_back(p_begin_point);
-	end = p_end_point;
 
 	while (!open_list.is_empty()) {
 		Point *p = open_list[0]; // The currently processed point.
+		PointState &p_state = states[p->index];
 
 		// Find point closer to end_point, or same distance to end_point but closer to begin_point.
-		if (last_closest_point == nullptr || last_closest_point->abs_f_score > p->abs_f_score || (last_closest_point->abs_f_score >= p->abs_f_score && last_closest_point->abs_g_score > p->abs_g_score)) {
-			last_closest_point = p;
+		const PointState *last_closest_state = r_context.last_closest_point ? &states[r_context.last_closest_point->index] : nullptr;
+		if (last_closest_state == nullptr || last_closest_state->abs_f_score > p_state.abs_f_score || (last_closest_state->abs_f_score >= p_state.abs_f_score && last_closest_state->abs_g_score > p_state.abs_g_score)) {
+			r_context.last_closest_point = p;
 		}
 
 		if (p == p_end_point) {
@@ -527,7 +587,7 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 		sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
 		open_list.remove_at(open_list.size() - 1);
-		p->closed_pass = pass; // Mark the point as closed.
+		p_state.closed_pass = pass; // Mark the point as closed.
 
 		nbors.clear();
 		_get_nbors(p, nbors);
@@ -537,34 +597,35 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 
 			if (jumping_enabled) {
 				// TODO: Make it works with weight_scale.
-				e = _jump(p, e);
-				if (!e || e->closed_pass == pass) {
+				e = _jump(p, e, p_end_point);
+				if (!e || states[e->index].closed_pass == pass) {
 					continue;
 				}
 			} else {
-				if (_get_solid_unchecked(e->id) || e->closed_pass == pass) {
+				if (_get_solid_unchecked(e->id) || states[e->index].closed_pass == pass) {
 					continue;
 				}
 				weight_scale = e->weight_scale;
 			}
 
-			real_t tentative_g_score = p->g_score + _compute_cost(p->id, e->id) * weight_scale;
+			PointState &e_state = states[e->index];
+			real_t tentative_g_score = p_state.g_score + _compute_cost(p->id, e->id) * weight_scale;
 			bool new_point = false;
 
-			if (e->open_pass != pass) { // The point wasn't inside the open list.
-				e->open_pass = pass;
+			if (e_state.open_pass != pass) { // The point wasn't inside the open list.
+				e_state.open_pass = pass;
 				open_list.push_back(e);
 				new_point = true;
-			} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+			} else if (tentative_g_score >= e_state.g_score) { // The new path is worse than the previous.
 				continue;
 			}
 
-			e->prev_point = p;
-			e->g_score = tentative_g_score;
-			e->f_score = e->g_score + _estimate_cost(e->id, p_end_point->id);
+			e_state.prev_point = p;
+			e_state.g_score = tentative_g_score;
+			e_state.f_score = e_state.g_score + _estimate_cost(e->id, p_end_point->id);
 
-			e->abs_g_score = tentative_g_score;
-			e->abs_f_score = e->f_score - e->g_score;
+			e_state.abs_g_score = tentative_g_score;
+			e_state.abs_f_score = e_state.f_score - e_state.g_score;
 
 			if (new_point) { // The position of the new points is already known.
 				sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
@@ -577,6 +638,35 @@ bool AStarGrid2D::_solve(Point *p_begin_point, Point *p_end_point, bool p_allow_
 	return found_route;
 }
 
+bool AStarGrid2D::_get_path(SearchContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path, LocalVector<Point *> &r_path) {
+	r_path.clear();
+
+	if (p_begin_point == p_end_point) {
+		r_path.push_back(p_begin_point);
+		return true;
+	}
+
+	Point *end_point = p_end_point;
+
+	bool found_route = _solve(r_context, p_begin_point, p_end_point, p_allow_partial_path);
+	if (!found_route) {
+		if (!p_allow_partial_path || r_context.last_closest_point == nullptr) {
+			return false;
+		}
+
+		// Use closest point instead.
+		end_point = r_context.last_closest_point;
+	}
+
+	for (Point *p = end_point; p != p_begin_point; p = r_context.states[p->index].prev_point) {
+		r_path.push_back(p);
+	}
+	r_path.push_back(p_begin_point);
+	r_path.reverse();
+
+	return true;
+}
+
 real_t AStarGrid2D::_estimate_cost(const Vector2i &p_from_id, const Vector2i &p_end_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_end_id, scost)) {
@@ -594,6 +684,8 @@ real_t AStarGrid2D::_compute_cost(const Vector2i &p_from_id, const Vector2i &p_t
 }
 
 void AStarGrid2D::clear() {
+	_clear_search_contexts();
+	clear_flow_field();
 	points.clear();
 	region = Rect2i();
 }
@@ -639,46 +731,23 @@ Vector<Vector2> AStarGrid2D::get_point_path(const Vector2i &p_from_id, const Vec
 	Point *a = _get_point(p_from_id.x, p_from_id.y);
 	Point *b = _get_point(p_to_id.x, p_to_id.y);
 
-	if (a == b) {
-		Vector<Vector2> ret;
-		ret.push_back(a->pos);
-		return ret;
-	}
+	SearchContext *context = _acquire_search_context();
+	LocalVector<Point *> path_points;
+	bool found_path = _get_path(*context, a, b, p_allow_partial_path, path_points);
+	_release_search_context(context);
 
-	Point *begin_point = a;
-	Point *end_point = b;
-
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return Vector<Vector2>();
-		}
-
-		// Use closest point instead.
-		end_point = last_closest_point;
-	}
-
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
+	if (!found_path) {
+		return Vector<Vector2>();
 	}
 
 	Vector<Vector2> path;
-	path.resize(pc);
+	path.resize(path_points.size());
 
 	{
 		Vector2 *w = path.ptrw();
-
-		p = end_point;
-		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			w[idx--] = p->pos;
-			p = p->prev_point;
+		for (uint32_t i = 0; i < path_points.size(); i++) {
+			w[i] = path_points[i]->pos;
 		}
-
-		w[0] = p->pos;
 	}
 
 	return path;
@@ -692,47 +761,271 @@ TypedArray<Vector2i> AStarGrid2D::get_id_path(const Vector2i &p_from_id, const V
 	Point *a = _get_point(p_from_id.x, p_from_id.y);
 	Point *b = _get_point(p_to_id.x, p_to_id.y);
 
-	if (a == b) {
-		TypedArray<Vector2i> ret;
-		ret.push_back(a->id);
-		return ret;
+	SearchContext *context = _acquire_search_context();
+	LocalVector<Point *> path_points;
+	bool found_path = _get_path(*context, a, b, p_allow_partial_path, path_points);
+	_release_search_context(context);
+
+	if (!found_path) {
+		return TypedArray<Vector2i>();
 	}
 
-	Point *begin_point = a;
-	Point *end_point = b;
+	TypedArray<Vector2i> path;
+	path.resize(path_points.size());
+	for (uint32_t i = 0; i < path_points.size(); i++) {
+		path[i] = path_points[i]->id;
+	}
 
-	bool found_route = _solve(begin_point, end_point, p_allow_partial_path);
-	if (!found_route) {
-		if (!p_allow_partial_path || last_closest_point == nullptr) {
-			return TypedArray<Vector2i>();
+	return path;
+}
+
+void AStarGrid2D::_get_id_paths_task(uint32_t p_index, IdPathsTaskData *p_data) {
+	SearchContext *context = _acquire_search_context();
+	_get_path(*context, p_data->begin_points[p_index], p_data->end_points[p_index], p_data->allow_partial_path, p_data->paths[p_index]);
+	_release_search_context(context);
+}
+
+TypedArray<Array> AStarGrid2D::get_id_paths(const TypedArray<Vector2i> &p_from, const TypedArray<Vector2i> &p_to, bool p_allow_partial_path) {
+	ERR_FAIL_COND_V_MSG(dirty, TypedArray<Array>(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(p_from.size() != p_to.size(), TypedArray<Array>(), vformat("Can't get id paths. The number of start points %d doesn't match the number of end points %d.", p_from.size(), p_to.size()));
+
+	const uint32_t path_count = p_from.size();
+
+	IdPathsTaskData data;
+	data.allow_partial_path = p_allow_partial_path;
+	data.begin_points.resize(path_count);
+	data.end_points.resize(path_count);
+	data.paths.resize(path_count);
+
+	for (uint32_t i = 0; i < path_count; i++) {
+		const Vector2i from_id = p_from[i];
+		const Vector2i to_id = p_to[i];
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(from_id), TypedArray<Array>(), vformat("Can't get id paths. Point %s out of bounds %s.", from_id, region));
+		ERR_FAIL_COND_V_MSG(!is_in_boundsv(to_id), TypedArray<Array>(), vformat("Can't get id paths. Point %s out of bounds %s.", to_id, region));
+		data.begin_points[i] = _get_point_unchecked(from_id);
+		data.end_points[i] = _get_point_unchecked(to_id);
+	}
+
+	// Script cost overrides are not assumed to be thread-safe, and waiting on a group from a pool thread could starve the pool.
+	const bool use_threads = path_count > 1 && !GDVIRTUAL_IS_OVERRIDDEN(_estimate_cost) && !GDVIRTUAL_IS_OVERRIDDEN(_compute_cost) && WorkerThreadPool::get_singleton()->get_thread_index() == -1;
+	if (use_threads) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &AStarGrid2D::_get_id_paths_task, &data, path_count, -1, true, SNAME("AStarGrid2DGetIdPaths"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < path_count; i++) {
+			_get_id_paths_task(i, &data);
 		}
+	}
 
-		// Use closest point instead.
-		end_point = last_closest_point;
+	TypedArray<Array> paths;
+	paths.resize(path_count);
+	for (uint32_t i = 0; i < path_count; i++) {
+		const LocalVector<Point *> &path_points = data.paths[i];
+		TypedArray<Vector2i> path;
+		path.resize(path_points.size());
+		for (uint32_t j = 0; j < path_points.size(); j++) {
+			path[j] = path_points[j]->id;
+		}
+		paths[i] = path;
 	}
 
-	Point *p = end_point;
-	int32_t pc = 1;
-	while (p != begin_point) {
-		pc++;
-		p = p->prev_point;
+	return paths;
+}
+
+void AStarGrid2D::_flow_field_point_changed(int32_t p_x, int32_t p_y) {
+	if (flow_field_full_update || flow_field_distances.is_empty()) {
+		return;
 	}
 
-	TypedArray<Vector2i> path;
-	path.resize(pc);
+	// Past some amount of changes a full update is cheaper than repairing the field.
+	if (flow_field_changed_points.size() >= flow_field_distances.size() / 8) {
+		flow_field_changed_points.clear();
+		flow_field_full_update = true;
+		return;
+	}
 
-	{
-		p = end_point;
-		int32_t idx = pc - 1;
-		while (p != begin_point) {
-			path[idx--] = p->id;
-			p = p->prev_point;
+	flow_field_changed_points.push_back(_get_point_unchecked(p_x, p_y)->index);
+}
+
+void AStarGrid2D::_repair_flow_field(LocalVector<FlowFieldEntry> &r_open_list) {
+	const uint32_t point_count = flow_field_distances.size();
+
+	// 0: not visited yet, 1: the path towards the goals is affected by a change, 2: the path is unaffected.
+	LocalVector<uint8_t> path_states;
+	path_states.resize(point_count);
+	memset(path_states.ptr(), 0, point_count);
+
+	// A change also adds or removes the diagonal connections around the changed point.
+	for (uint32_t index : flow_field_changed_points) {
+		const Vector2i id = _get_point_by_index(index)->id;
+		for (int32_t y = id.y - 1; y <= id.y + 1; y++) {
+			for (int32_t x = id.x - 1; x <= id.x + 1; x++) {
+				if (region.has_point(Vector2i(x, y))) {
+					path_states[_get_point_unchecked(x, y)->index] = 1;
+				}
+			}
 		}
+	}
 
-		path[0] = p->id;
+	LocalVector<uint32_t> chain;
+	for (uint32_t i = 0; i < point_count; i++) {
+		uint32_t p = i;
+		while (path_states[p] == 0 && flow_field_next_points[p] != UINT32_MAX) {
+			chain.push_back(p);
+			p = flow_field_next_points[p];
+		}
+		if (path_states[p] == 0) {
+			path_states[p] = 2; // A goal or a point that can't reach any goal.
+		}
+		for (uint32_t c : chain) {
+			path_states[c] = path_states[p];
+		}
+		chain.clear();
 	}
 
-	return path;
+	for (uint32_t i = 0; i < point_count; i++) {
+		if (path_states[i] == 1) {
+			flow_field_distances[i] = Math::INF;
+			flow_field_next_points[i] = UINT32_MAX;
+		}
+	}
+
+	// The affected points are reached again from their unaffected neighbors and the goals.
+	LocalVector<Point *> nbors;
+	for (uint32_t i = 0; i < point_count; i++) {
+		if (path_states[i] != 1) {
+			continue;
+		}
+
+		nbors.clear();
+		_get_nbors(_get_point_by_index(i), nbors);
+		for (const Point *e : nbors) {
+			if (path_states[e->index] == 2 && flow_field_distances[e->index] != Math::INF) {
+				r_open_list.push_back({ flow_field_distances[e->index], e->index });
+			}
+		}
+	}
+
+	for (const Vector2i &goal : flow_field_goals) {
+		if (_get_solid_unchecked(goal)) {
+			continue;
+		}
+		const uint32_t index = _get_point_unchecked(goal)->index;
+		flow_field_distances[index] = 0;
+		flow_field_next_points[index] = UINT32_MAX;
+		r_open_list.push_back({ 0, index });
+	}
+}
+
+void AStarGrid2D::_propagate_flow_field(LocalVector<FlowFieldEntry> &r_open_list) {
+	SortArray<FlowFieldEntry, SortFlowFieldEntries> sorter;
+	sorter.make_heap(0, r_open_list.size(), r_open_list.ptr());
+
+	real_t *distances = flow_field_distances.ptr();
+	uint32_t *next_points = flow_field_next_points.ptr();
+	LocalVector<Point *> nbors;
+
+	while (!r_open_list.is_empty()) {
+		const FlowFieldEntry entry = r_open_list[0];
+		sorter.pop_heap(0, r_open_list.size(), r_open_list.ptr());
+		r_open_list.remove_at(r_open_list.size() - 1);
+
+		if (entry.distance > distances[entry.index]) {
+			continue; // A shorter distance was found after this entry was added.
+		}
+
+		Point *p = _get_point_by_index(entry.index);
+		nbors.clear();
+		_get_nbors(p, nbors);
+
+		for (Point *e : nbors) {
+			// The neighbors step into this point, so it is the weight scale of this point that applies.
+			const real_t distance = entry.distance + _compute_cost(e->id, p->id) * p->weight_scale;
+			if (distance < distances[e->index]) {
+				distances[e->index] = distance;
+				next_points[e->index] = entry.index;
+				r_open_list.push_back({ distance, e->index });
+				sorter.push_heap(0, r_open_list.size() - 1, 0, r_open_list[r_open_list.size() - 1], r_open_list.ptr());
+			}
+		}
+	}
+}
+
+void AStarGrid2D::update_flow_field(const TypedArray<Vector2i> &p_goals) {
+	ERR_FAIL_COND_MSG(dirty, "Grid is not initialized. Call the update method.");
+
+	LocalVector<Vector2i> goals;
+	goals.reserve(p_goals.size());
+	for (int i = 0; i < p_goals.size(); i++) {
+		const Vector2i goal = p_goals[i];
+		ERR_FAIL_COND_MSG(!is_in_boundsv(goal), vformat("Can't update flow field. Goal %s out of bounds %s.", goal, region));
+		goals.push_back(goal);
+	}
+
+	const uint32_t point_count = region.get_area();
+	bool same_goals = goals.size() == flow_field_goals.size();
+	for (uint32_t i = 0; same_goals && i < goals.size(); i++) {
+		same_goals = goals[i] == flow_field_goals[i];
+	}
+	if (!same_goals || flow_field_distances.size() != point_count) {
+		flow_field_full_update = true;
+	}
+	flow_field_goals = goals;
+
+	LocalVector<FlowFieldEntry> open_list;
+	if (flow_field_full_update) {
+		flow_field_distances.resize(point_count);
+		flow_field_next_points.resize(point_count);
+		for (uint32_t i = 0; i < point_count; i++) {
+			flow_field_distances[i] = Math::INF;
+			flow_field_next_points[i] = UINT32_MAX;
+		}
+
+		for (const Vector2i &goal : flow_field_goals) {
+			if (_get_solid_unchecked(goal)) {
+				continue;
+			}
+			const uint32_t index = _get_point_unchecked(goal)->index;
+			flow_field_distances[index] = 0;
+			open_list.push_back({ 0, index });
+		}
+	} else if (!flow_field_changed_points.is_empty()) {
+		_repair_flow_field(open_list);
+	}
+
+	flow_field_changed_points.clear();
+	flow_field_full_update = false;
+
+	_propagate_flow_field(open_list);
+}
+
+void AStarGrid2D::clear_flow_field() {
+	flow_field_goals.clear();
+	flow_field_distances.clear();
+	flow_field_next_points.clear();
+	flow_field_changed_points.clear();
+	flow_field_full_update = true;
+}
+
+Vector2i AStarGrid2D::get_flow_direction(const Vector2i &p_id) const {
+	ERR_FAIL_COND_V_MSG(dirty, Vector2i(), "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(flow_field_distances.is_empty(), Vector2i(), "Flow field is not initialized. Call the update_flow_field method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Vector2i(), vformat("Can't get flow direction. Point %s out of bounds %s.", p_id, region));
+
+	const uint32_t next_index = flow_field_next_points[_get_point_unchecked(p_id)->index];
+	if (next_index == UINT32_MAX) {
+		return Vector2i();
+	}
+	const Vector2i next_id = region.position + Vector2i(next_index % region.size.x, next_index / region.size.x);
+	return next_id - p_id;
+}
+
+real_t AStarGrid2D::get_flow_distance(const Vector2i &p_id) const {
+	ERR_FAIL_COND_V_MSG(dirty, Math::INF, "Grid is not initialized. Call the update method.");
+	ERR_FAIL_COND_V_MSG(flow_field_distances.is_empty(), Math::INF, "Flow field is not initialized. Call the update_flow_field method.");
+	ERR_FAIL_COND_V_MSG(!is_in_boundsv(p_id), Math::INF, vformat("Can't get flow distance. Point %s out of bounds %s.", p_id, region));
+
+	return flow_field_distances[_get_point_unchecked(p_id)->index];
 }
 
 void AStarGrid2D::_bind_methods() {
@@ -770,6 +1063,12 @@ void AStarGrid2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_point_data_in_region", "region"), &AStarGrid2D::get_point_data_in_region);
 	ClassDB::bind_method(D_METHOD("get_point_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_point_path, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("get_id_path", "from_id", "to_id", "allow_partial_path"), &AStarGrid2D::get_id_path, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_id_paths", "from_ids", "to_ids", "allow_partial_path"), &AStarGrid2D::get_id_paths, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("update_flow_field", "goal_ids"), &AStarGrid2D::update_flow_field);
+	ClassDB::bind_method(D_METHOD("clear_flow_field"), &AStarGrid2D::clear_flow_field);
+	ClassDB::bind_method(D_METHOD("get_flow_direction", "id"), &AStarGrid2D::get_flow_direction);
+	ClassDB::bind_method(D_METHOD("get_flow_distance", "id"), &AStarGrid2D::get_flow_distance);
 
 	GDVIRTUAL_BIND(_estimate_cost, "from_id", "end_id")
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
@@ -802,3 +1101,7 @@ void AStarGrid2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(CELL_SHAPE_ISOMETRIC_DOWN);
 	BIND_ENUM_CONSTANT(CELL_SHAPE_MAX);
 }
+
+AStarGrid2D::~AStarGrid2D() {
+	_clear_search_contexts();
+}
@@ -32,6 +32,7 @@
 
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/local_vector.h"
 
 class AStarGrid2D : public RefCounted {
@@ -79,7 +80,17 @@ private:
 		Vector2 pos;
 		real_t weight_scale = 1.0;
 
-		// Used for pathfinding.
+		// Index of the point in the search states.
+		uint32_t index = 0;
+
+		Point() {}
+
+		Point(const Vector2i &p_id, const Vector2 &p_pos, uint32_t p_index) :
+				id(p_id), pos(p_pos), index(p_index) {}
+	};
+
+	// Used for pathfinding, kept apart from the points so several searches can run on the same grid at once.
+	struct PointState {
 		Point *prev_point = nullptr;
 		real_t g_score = 0;
 		real_t f_score = 0;
@@ -89,31 +100,66 @@ private:
 		// Used for getting last_closest_point.
 		real_t abs_g_score = 0;
 		real_t abs_f_score = 0;
-
-		Point() {}
-
-		Point(const Vector2i &p_id, const Vector2 &p_pos) :
-				id(p_id), pos(p_pos) {}
 	};
 
 	struct SortPoints {
+		const PointState *states = nullptr;
+
 		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
-			if (A->f_score > B->f_score) {
+			const PointState &a = states[A->index];
+			const PointState &b = states[B->index];
+			if (a.f_score > b.f_score) {
 				return true;
-			} else if (A->f_score < B->f_score) {
+			} else if (a.f_score < b.f_score) {
 				return false;
 			} else {
-				return A->g_score < B->g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
+				return a.g_score < b.g_score; // If the f_costs are the same then prioritize the points that are further away from the start.
 			}
 		}
 	};
 
+	// Reusable buffers of a single search, only the states whose pass matches the current pass are valid.
+	struct SearchContext {
+		LocalVector<PointState> states;
+		uint64_t pass = 1;
+
+		LocalVector<Point *> open_list;
+		LocalVector<Point *> nbors;
+		Point *last_closest_point = nullptr;
+	};
+
+	struct IdPathsTaskData {
+		LocalVector<Point *> begin_points;
+		LocalVector<Point *> end_points;
+		bool allow_partial_path = false;
+		LocalVector<LocalVector<Point *>> paths;
+	};
+
+	struct FlowFieldEntry {
+		real_t distance = 0;
+		uint32_t index = 0;
+	};
+
+	struct SortFlowFieldEntries {
+		_FORCE_INLINE_ bool operator()(const FlowFieldEntry &A, const FlowFieldEntry &B) const { // Returns true when the entry A is farther than entry B.
+			return A.distance > B.distance;
+		}
+	};
+
 	LocalVector<bool> solid_mask;
 	LocalVector<LocalVector<Point>> points;
-	Point *end = nullptr;
-	Point *last_closest_point = nullptr;
 
-	uint64_t pass = 1;
+	// Integration field towards the goals of the last `update_flow_field()` call, indexed like the search states.
+	LocalVector<Vector2i> flow_field_goals;
+	LocalVector<real_t> flow_field_distances;
+	// Next point towards the closest goal, UINT32_MAX for the goals and the points that can't reach any.
+	LocalVector<uint32_t> flow_field_next_points;
+	// Points whose solid state or weight scale changed since the flow field was updated.
+	LocalVector<uint32_t> flow_field_changed_points;
+	bool flow_field_full_update = true;
+
+	Mutex search_contexts_mutex;
+	LocalVector<SearchContext *> search_contexts;
 
 private: // Internal routines.
 	_FORCE_INLINE_ size_t _to_mask_index(int32_t p_x, int32_t p_y) const {
@@ -155,10 +201,24 @@ private: // Internal routines.
 		return &points[p_id.y - region.position.y][p_id.x - region.position.x];
 	}
 
+	_FORCE_INLINE_ Point *_get_point_by_index(uint32_t p_index) {
+		return &points[p_index / region.size.x][p_index % region.size.x];
+	}
+
 	void _get_nbors(Point *p_point, LocalVector<Point *> &r_nbors);
-	Point *_jump(Point *p_from, Point *p_to);
-	bool _solve(Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
-	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, bool p_inclusive = false);
+	Point *_jump(Point *p_from, Point *p_to, Point *p_end);
+	bool _solve(SearchContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path);
+	bool _get_path(SearchContext &r_context, Point *p_begin_point, Point *p_end_point, bool p_allow_partial_path, LocalVector<Point *> &r_path);
+	Point *_forced_successor(int32_t p_x, int32_t p_y, int32_t p_dx, int32_t p_dy, Point *p_end, bool p_inclusive = false);
+
+	SearchContext *_acquire_search_context();
+	void _release_search_context(SearchContext *p_context);
+	void _clear_search_contexts();
+	void _get_id_paths_task(uint32_t p_index, IdPathsTaskData *p_data);
+
+	void _flow_field_point_changed(int32_t p_x, int32_t p_y);
+	void _repair_flow_field(LocalVector<FlowFieldEntry> &r_open_list);
+	void _propagate_flow_field(LocalVector<FlowFieldEntry> &r_open_list);
 
 protected:
 	static void _bind_methods();
@@ -224,6 +284,14 @@ public:
 	TypedArray<Dictionary> get_point_data_in_region(const Rect2i &p_region) const;
 	Vector<Vector2> get_point_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
 	TypedArray<Vector2i> get_id_path(const Vector2i &p_from, const Vector2i &p_to, bool p_allow_partial_path = false);
+	TypedArray<Array> get_id_paths(const TypedArray<Vector2i> &p_from, const TypedArray<Vector2i> &p_to, bool p_allow_partial_path = false);
+
+	void update_flow_field(const TypedArray<Vector2i> &p_goals);
+	void clear_flow_field();
+	Vector2i get_flow_direction(const Vector2i &p_id) const;
+	real_t get_flow_distance(const Vector2i &p_id) const;
+
+	~AStarGrid2D();
 };
 
 VARIANT_ENUM_CAST(AStarGrid2D::DiagonalMode);
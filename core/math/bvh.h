@@ -177,6 +177,12 @@ public:
 		set_tree(h, p_tree_id, p_tree_collision_mask, p_force_collision_check);
 	}
 
+	void set_tree_keep_pairs(uint32_t p_handle, uint32_t p_tree_id, uint32_t p_tree_collision_mask) {
+		BVHHandle h;
+		h.set(p_handle);
+		set_tree_keep_pairs(h, p_tree_id, p_tree_collision_mask);
+	}
+
 	uint32_t get_tree_id(uint32_t p_handle) const {
 		BVHHandle h;
 		h.set(p_handle);
@@ -345,6 +351,16 @@ public:
 		}
 	}
 
+	// Like set_tree(), but the existing pairs are kept as they are instead of being checked again,
+	// even if they would no longer be allowed by the new tree and mask. This is meant for items
+	// that stop moving and can be parked in a tree that is only tested against moving items.
+	// Pairs that no longer overlap are still removed if the item moves again.
+	void set_tree_keep_pairs(const BVHHandle &p_handle, uint32_t p_tree_id, uint32_t p_tree_collision_mask) {
+		DEV_ASSERT(!p_handle.is_invalid());
+		BVH_LOCKED_FUNCTION
+		tree.item_set_tree(p_handle, p_tree_id, p_tree_collision_mask);
+	}
+
 	// cull tests
 	int cull_aabb(const BOUNDS &p_aabb, T **p_result_array, int p_result_max, const T *p_tester, uint32_t p_tree_collision_mask = 0xFFFFFFFF, int *p_subindex_array = nullptr) {
 		BVH_LOCKED_FUNCTION
@@ -231,6 +231,9 @@ void RasterizerGLES3::finalize() {
 	memdelete(texture_storage);
 	memdelete(utilities);
 	memdelete(config);
+
+	// Finishes writing queued compile results.
+	ShaderCompiler::set_result_cache_dir(String());
 }
 
 RasterizerGLES3 *RasterizerGLES3::singleton = nullptr;
@@ -355,6 +358,12 @@ RasterizerGLES3::RasterizerGLES3() {
 
 				if (!shader_cache_dir.is_empty()) {
 					ShaderGLES3::set_shader_cache_dir(shader_cache_dir);
+
+					// Results of the shader language front end are cached next to the compiled variants.
+					String compiler_cache_dir = shader_cache_dir.path_join("shader_compiler");
+					if (DirAccess::dir_exists_absolute(compiler_cache_dir) || DirAccess::make_dir_absolute(compiler_cache_dir) == OK) {
+						ShaderCompiler::set_result_cache_dir(compiler_cache_dir);
+					}
 				}
 			}
 		}
@@ -147,6 +147,15 @@ void GodotBody2D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	// The broadphase isn't thread-safe, the space moves the shapes on its next update.
+	if (get_space() && !sleep_update_list.in_list()) {
+		get_space()->body_add_to_sleep_update_list(&sleep_update_list);
+	}
+}
+
+void GodotBody2D::update_broadphase_sleeping() {
+	_set_sleeping(!active && mode >= PhysicsServer2D::BODY_MODE_RIGID);
 }
 
 void GodotBody2D::set_param(PhysicsServer2D::BodyParameter p_param, const Variant &p_value) {
@@ -260,6 +269,8 @@ void GodotBody2D::set_mode(PhysicsServer2D::BodyMode p_mode) {
 			_set_inv_transform(get_transform().affine_inverse());
 			_inv_mass = 0;
 			_inv_inertia = 0;
+			// Only rigid bodies use the sleeping tier.
+			_set_sleeping(false);
 			_set_static(p_mode == PhysicsServer2D::BODY_MODE_STATIC);
 			set_active(p_mode == PhysicsServer2D::BODY_MODE_KINEMATIC && contacts.size());
 			linear_velocity = Vector2();
@@ -402,6 +413,9 @@ void GodotBody2D::set_space(GodotSpace2D *p_space) {
 		if (direct_state_query_list.in_list()) {
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
 		}
+		if (sleep_update_list.in_list()) {
+			get_space()->body_remove_from_sleep_update_list(&sleep_update_list);
+		}
 	}
 
 	_set_space(p_space);
@@ -412,6 +426,9 @@ void GodotBody2D::set_space(GodotSpace2D *p_space) {
 		if (active && !active_list.in_list()) {
 			get_space()->body_add_to_active_list(&active_list);
 		}
+		if (!sleep_update_list.in_list()) {
+			get_space()->body_add_to_sleep_update_list(&sleep_update_list);
+		}
 	}
 }
 
@@ -612,6 +629,36 @@ void GodotBody2D::integrate_forces(real_t p_step) {
 	contact_count = 0;
 }
 
+void GodotBody2D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody2D::set_snapshot_state(const SnapshotState &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+
+	// Let the direct body state and the nodes see the restored transform on the next sync.
+	if ((fi_callback_data || body_state_callback.is_valid()) && get_space() && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody2D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer2D::BODY_MODE_STATIC) {
 		return;
@@ -749,7 +796,8 @@ GodotBody2D::GodotBody2D() :
 		GodotCollisionObject2D(TYPE_BODY),
 		active_list(this),
 		mass_properties_update_list(this),
-		direct_state_query_list(this) {
+		direct_state_query_list(this),
+		sleep_update_list(this) {
 	_set_static(false);
 }
 
@@ -593,6 +593,59 @@ void GodotBodyPair2D::solve(real_t p_step) {
 	}
 }
 
+GodotConstraint2D::OrderKey GodotBodyPair2D::get_order_key() const {
+	OrderKey key;
+	key.ids[0] = A->get_self().get_id();
+	key.ids[1] = B->get_self().get_id();
+	key.subindices[0] = shape_A;
+	key.subindices[1] = shape_B;
+	// Outside of deterministic mode the bodies may be stored either way around, the key doesn't depend on it.
+	if (key.ids[0] > key.ids[1]) {
+		SWAP(key.ids[0], key.ids[1]);
+		SWAP(key.subindices[0], key.subindices[1]);
+	}
+	return key;
+}
+
+void GodotBodyPair2D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.sep_axis = sep_axis;
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+	r_state.oneway_disabled = oneway_disabled;
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		SnapshotContact &sc = r_state.contacts[i];
+		sc.local_A = c.local_A;
+		sc.local_B = c.local_B;
+		sc.normal = c.normal;
+		sc.acc_normal_impulse = c.acc_normal_impulse;
+		sc.acc_tangent_impulse = c.acc_tangent_impulse;
+		sc.acc_bias_impulse = c.acc_bias_impulse;
+		sc.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		sc.used = c.used;
+	}
+}
+
+void GodotBodyPair2D::set_snapshot_state(const SnapshotState &p_state) {
+	sep_axis = p_state.sep_axis;
+	contact_count = CLAMP(p_state.contact_count, 0, (int)MAX_CONTACTS);
+	collided = p_state.collided;
+	oneway_disabled = p_state.oneway_disabled;
+	for (int i = 0; i < contact_count; i++) {
+		const SnapshotContact &sc = p_state.contacts[i];
+		Contact &c = contacts[i];
+		c = Contact();
+		c.local_A = sc.local_A;
+		c.local_B = sc.local_B;
+		c.normal = sc.normal;
+		c.acc_normal_impulse = sc.acc_normal_impulse;
+		c.acc_tangent_impulse = sc.acc_tangent_impulse;
+		c.acc_bias_impulse = sc.acc_bias_impulse;
+		c.acc_bias_impulse_center_of_mass = sc.acc_bias_impulse_center_of_mass;
+		c.used = sc.used;
+	}
+}
+
 GodotBodyPair2D::GodotBodyPair2D(GodotBody2D *p_A, int p_shape_A, GodotBody2D *p_B, int p_shape_B) :
 		GodotConstraint2D(_arr, 2) {
 	A = p_A;
@@ -34,9 +34,12 @@
 #include "godot_constraint_2d.h"
 
 class GodotBodyPair2D : public GodotConstraint2D {
+public:
 	enum {
 		MAX_CONTACTS = 2
 	};
+
+private:
 	union {
 		struct {
 			GodotBody2D *A;
@@ -89,6 +92,31 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	// Data carried over from one step to the next, saved and restored by space snapshots.
+	struct SnapshotContact {
+		Vector2 local_A, local_B;
+		Vector2 normal;
+		real_t acc_normal_impulse = 0.0;
+		real_t acc_tangent_impulse = 0.0;
+		real_t acc_bias_impulse = 0.0;
+		real_t acc_bias_impulse_center_of_mass = 0.0;
+		bool used = false;
+	};
+
+	struct SnapshotState {
+		Vector2 sep_axis;
+		SnapshotContact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		bool collided = false;
+		bool oneway_disabled = false;
+	};
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	void set_snapshot_state(const SnapshotState &p_state);
+
+	virtual OrderKey get_order_key() const override;
+	virtual GodotBodyPair2D *get_body_pair() override { return this; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
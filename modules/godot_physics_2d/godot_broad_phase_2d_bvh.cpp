@@ -33,7 +33,7 @@
 
 GodotBroadPhase2D::ID GodotBroadPhase2DBVH::create(GodotCollisionObject2D *p_object, int p_subindex, const Rect2 &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? TREE_MASK_STATIC : TREE_MASK_DYNAMIC;
 	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
 	return oid + 1;
 }
@@ -46,10 +46,22 @@ void GodotBroadPhase2DBVH::move(ID p_id, const Rect2 &p_aabb) {
 void GodotBroadPhase2DBVH::set_static(ID p_id, bool p_static) {
 	ERR_FAIL_COND(!p_id);
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? TREE_MASK_STATIC : TREE_MASK_DYNAMIC;
 	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
 }
 
+void GodotBroadPhase2DBVH::set_sleeping(ID p_id, bool p_sleeping) {
+	ERR_FAIL_COND(!p_id);
+	uint32_t tree_id = bvh.get_tree_id(p_id - 1);
+	if (p_sleeping && tree_id == TREE_DYNAMIC) {
+		// Falling asleep doesn't change what the object touches, so there's no need to check its pairs.
+		bvh.set_tree_keep_pairs(p_id - 1, TREE_SLEEPING, TREE_MASK_SLEEPING);
+	} else if (!p_sleeping && tree_id == TREE_SLEEPING) {
+		// Pair it with the sleeping objects it was skipped against while asleep.
+		bvh.set_tree(p_id - 1, TREE_DYNAMIC, TREE_MASK_DYNAMIC);
+	}
+}
+
 void GodotBroadPhase2DBVH::remove(ID p_id) {
 	ERR_FAIL_COND(!p_id);
 	bvh.erase(p_id - 1);
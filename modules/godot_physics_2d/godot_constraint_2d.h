@@ -32,6 +32,9 @@
 
 #include "godot_body_2d.h"
 
+class GodotBodyPair2D;
+class GodotJoint2D;
+
 class GodotConstraint2D {
 	GodotBody2D **_body_ptr;
 	int _body_count;
@@ -47,6 +50,34 @@ protected:
 	}
 
 public:
+	// Identifies a constraint by the objects it connects rather than by creation order.
+	struct OrderKey {
+		uint64_t ids[2] = {};
+		int subindices[2] = {};
+
+		_FORCE_INLINE_ bool operator<(const OrderKey &p_key) const {
+			if (ids[0] != p_key.ids[0]) {
+				return ids[0] < p_key.ids[0];
+			}
+			if (ids[1] != p_key.ids[1]) {
+				return ids[1] < p_key.ids[1];
+			}
+			if (subindices[0] != p_key.subindices[0]) {
+				return subindices[0] < p_key.subindices[0];
+			}
+			return subindices[1] < p_key.subindices[1];
+		}
+		_FORCE_INLINE_ bool operator==(const OrderKey &p_key) const {
+			return ids[0] == p_key.ids[0] && ids[1] == p_key.ids[1] && subindices[0] == p_key.subindices[0] && subindices[1] == p_key.subindices[1];
+		}
+	};
+
+	struct OrderComparator {
+		_FORCE_INLINE_ bool operator()(const GodotConstraint2D *p_a, const GodotConstraint2D *p_b) const {
+			return p_a->get_order_key() < p_b->get_order_key();
+		}
+	};
+
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
 
@@ -59,6 +90,15 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	virtual OrderKey get_order_key() const {
+		OrderKey key;
+		key.ids[0] = self.get_id();
+		return key;
+	}
+
+	virtual GodotBodyPair2D *get_body_pair() { return nullptr; }
+	virtual GodotJoint2D *get_joint() { return nullptr; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
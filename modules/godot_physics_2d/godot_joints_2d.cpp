@@ -256,6 +256,16 @@ void GodotPinJoint2D::solve(real_t p_step) {
 	P += impulse;
 }
 
+void GodotPinJoint2D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.impulse = P;
+	r_state.angular_impulse = j_acc;
+}
+
+void GodotPinJoint2D::set_snapshot_state(const SnapshotState &p_state) {
+	P = p_state.impulse;
+	j_acc = p_state.angular_impulse;
+}
+
 void GodotPinJoint2D::set_param(PhysicsServer2D::PinJointParam p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::PIN_JOINT_SOFTNESS: {
@@ -470,6 +480,14 @@ void GodotGrooveJoint2D::solve(real_t p_step) {
 	}
 }
 
+void GodotGrooveJoint2D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.impulse = jn_acc;
+}
+
+void GodotGrooveJoint2D::set_snapshot_state(const SnapshotState &p_state) {
+	jn_acc = p_state.impulse;
+}
+
 GodotGrooveJoint2D::GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b) :
 		GodotJoint2D(_arr, 2) {
 	A = p_body_a;
@@ -58,6 +58,17 @@ public:
 
 	void copy_settings_from(GodotJoint2D *p_joint);
 
+	// Impulses accumulated over previous steps and applied again as a warm start, saved and restored by space snapshots.
+	struct SnapshotState {
+		Vector2 impulse;
+		real_t angular_impulse = 0.0;
+	};
+
+	virtual void get_snapshot_state(SnapshotState &r_state) const {}
+	virtual void set_snapshot_state(const SnapshotState &p_state) {}
+
+	virtual GodotJoint2D *get_joint() override { return this; }
+
 	virtual PhysicsServer2D::JointType get_type() const { return PhysicsServer2D::JOINT_TYPE_MAX; }
 	GodotJoint2D(GodotBody2D **p_body_ptr = nullptr, int p_body_count = 0) :
 			GodotConstraint2D(p_body_ptr, p_body_count) {}
@@ -108,6 +119,9 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual void get_snapshot_state(SnapshotState &r_state) const override;
+	virtual void set_snapshot_state(const SnapshotState &p_state) override;
+
 	void set_param(PhysicsServer2D::PinJointParam p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::PinJointParam p_param) const;
 
@@ -148,6 +162,9 @@ public:
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
+	virtual void get_snapshot_state(SnapshotState &r_state) const override;
+	virtual void set_snapshot_state(const SnapshotState &p_state) override;
+
 	GodotGrooveJoint2D(const Vector2 &p_a_groove1, const Vector2 &p_a_groove2, const Vector2 &p_b_anchor, GodotBody2D *p_body_a, GodotBody2D *p_body_b);
 };
 
@@ -34,8 +34,11 @@
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_space_state.h"
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
+#include "godot_joints_2d.h"
 
 #define TEST_MOTION_MARGIN_MIN_VALUE 0.0001
 #define TEST_MOTION_MIN_CONTACT_DEPTH_FACTOR 0.05
@@ -118,14 +121,18 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_shapes(p_parameters, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray_shapes(const RayParameters &p_parameters, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const {
 	Vector2 begin, end;
 	Vector2 normal;
 	begin = p_parameters.from;
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -134,18 +141,18 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject2D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -205,6 +212,41 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState2D::_intersect_ray_batch(uint32_t p_index, RayBatch *p_batch) {
+	const uint32_t from = p_batch->offsets[p_index];
+	const int amount = p_batch->offsets[p_index + 1] - from;
+	p_batch->hits[p_index] = _intersect_ray_shapes(p_batch->parameters[p_index], p_batch->objects.ptr() + from, p_batch->subindices.ptr() + from, amount, p_batch->results[p_index]);
+}
+
+void GodotPhysicsDirectSpaceState2D::intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	if (p_count <= 0) {
+		return;
+	}
+
+	// The broadphase isn't thread-safe, so all rays are culled first and their shapes are then tested in parallel.
+	RayBatch batch;
+	batch.parameters = p_parameters;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.offsets.resize(p_count + 1);
+
+	for (int i = 0; i < p_count; i++) {
+		batch.offsets[i] = batch.objects.size();
+
+		int amount = space->broadphase->cull_segment(p_parameters[i].from, p_parameters[i].to, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		for (int j = 0; j < amount; j++) {
+			batch.objects.push_back(space->intersection_query_results[j]);
+			batch.subindices.push_back(space->intersection_query_subindex_results[j]);
+		}
+	}
+	batch.offsets[p_count] = batch.objects.size();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState2D::_intersect_ray_batch, &batch, p_count, -1, true, SNAME("Physics2DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1035,6 +1077,11 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 		}
 
 	} else {
+		if (self->deterministic && A->get_self().get_id() > B->get_self().get_id()) {
+			// Don't let the pairing order decide which body is A, it changes how contacts are computed.
+			SWAP(A, B);
+			SWAP(p_subindex_A, p_subindex_B);
+		}
 		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
 		return b;
 	}
@@ -1071,6 +1118,14 @@ void GodotSpace2D::body_remove_from_mass_properties_update_list(SelfList<GodotBo
 	mass_properties_update_list.remove(p_body);
 }
 
+void GodotSpace2D::body_add_to_sleep_update_list(SelfList<GodotBody2D> *p_body) {
+	sleep_update_list.add(p_body);
+}
+
+void GodotSpace2D::body_remove_from_sleep_update_list(SelfList<GodotBody2D> *p_body) {
+	sleep_update_list.remove(p_body);
+}
+
 GodotBroadPhase2D *GodotSpace2D::get_broadphase() {
 	return broadphase;
 }
@@ -1141,9 +1196,201 @@ void GodotSpace2D::setup() {
 }
 
 void GodotSpace2D::update() {
+	while (sleep_update_list.first()) {
+		sleep_update_list.first()->self()->update_broadphase_sleeping();
+		sleep_update_list.remove(sleep_update_list.first());
+	}
+
 	broadphase->update();
 }
 
+static const uint32_t SPACE_STATE_MAGIC = 0x44325347; // "GS2D"
+
+// Pair keys put the body with the lower RID first, converts pair state between the order of the pair and the order of its key.
+static void _swap_space_state_pair(GodotBodyPair2D::SnapshotState &r_state) {
+	r_state.sep_axis = -r_state.sep_axis;
+	for (int i = 0; i < r_state.contact_count; i++) {
+		GodotBodyPair2D::SnapshotContact &contact = r_state.contacts[i];
+		SWAP(contact.local_A, contact.local_B);
+		// The tangent is derived from the normal, so negating the normal alone reverses the whole impulse.
+		contact.normal = -contact.normal;
+	}
+}
+
+static _FORCE_INLINE_ bool _is_space_state_pair_swapped(const GodotConstraint2D *p_pair, const GodotConstraint2D::OrderKey &p_key) {
+	return p_pair->get_body_ptr()[0]->get_self().get_id() != p_key.ids[0];
+}
+
+// Pairs and joints of a space, sorted by the RIDs they connect so that equal simulation states give equal snapshots.
+static void _get_space_state_constraints(const HashSet<GodotCollisionObject2D *> &p_objects, LocalVector<GodotConstraint2D *> &r_pairs, LocalVector<GodotConstraint2D *> &r_joints) {
+	for (GodotCollisionObject2D *object : p_objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+		for (const Pair<GodotConstraint2D *, int> &E : static_cast<GodotBody2D *>(object)->get_constraint_list()) {
+			// Each constraint is listed by all of its bodies, only keep it once.
+			if (E.second != 0) {
+				continue;
+			}
+			if (E.first->get_body_pair()) {
+				r_pairs.push_back(E.first);
+			} else if (E.first->get_joint()) {
+				r_joints.push_back(E.first);
+			}
+		}
+	}
+	r_pairs.sort_custom<GodotConstraint2D::OrderComparator>();
+	r_joints.sort_custom<GodotConstraint2D::OrderComparator>();
+}
+
+PackedByteArray GodotSpace2D::save_state() const {
+	ERR_FAIL_COND_V_MSG(locked, PackedByteArray(), "Space state can't be saved while the space is being stepped.");
+
+	LocalVector<GodotBody2D *> bodies;
+	PhysicsSpaceState::get_bodies(objects, bodies);
+
+	LocalVector<GodotConstraint2D *> pairs;
+	LocalVector<GodotConstraint2D *> joints;
+	_get_space_state_constraints(objects, pairs, joints);
+
+	PhysicsSpaceState::Writer writer(SPACE_STATE_MAGIC, bodies.size() * sizeof(GodotBody2D::SnapshotState) + pairs.size() * sizeof(GodotBodyPair2D::SnapshotState) + joints.size() * sizeof(GodotJoint2D::SnapshotState));
+	PhysicsSpaceState::write_bodies(writer, bodies);
+
+	writer.write(pairs.size());
+	for (GodotConstraint2D *constraint : pairs) {
+		GodotConstraint2D::OrderKey key = constraint->get_order_key();
+		GodotBodyPair2D::SnapshotState state;
+		constraint->get_body_pair()->get_snapshot_state(state);
+		if (_is_space_state_pair_swapped(constraint, key)) {
+			_swap_space_state_pair(state);
+		}
+		writer.write(key.ids[0]);
+		writer.write(key.ids[1]);
+		writer.write((int32_t)key.subindices[0]);
+		writer.write((int32_t)key.subindices[1]);
+		writer.write(state.sep_axis);
+		writer.write((uint8_t)state.collided);
+		writer.write((uint8_t)state.oneway_disabled);
+		writer.write((uint8_t)state.contact_count);
+		for (int i = 0; i < state.contact_count; i++) {
+			const GodotBodyPair2D::SnapshotContact &contact = state.contacts[i];
+			writer.write(contact.local_A);
+			writer.write(contact.local_B);
+			writer.write(contact.normal);
+			writer.write(contact.acc_normal_impulse);
+			writer.write(contact.acc_tangent_impulse);
+			writer.write(contact.acc_bias_impulse);
+			writer.write(contact.acc_bias_impulse_center_of_mass);
+			writer.write((uint8_t)contact.used);
+		}
+	}
+
+	writer.write(joints.size());
+	for (GodotConstraint2D *constraint : joints) {
+		GodotJoint2D::SnapshotState state;
+		constraint->get_joint()->get_snapshot_state(state);
+		writer.write(constraint->get_self().get_id());
+		writer.write(state.impulse);
+		writer.write(state.angular_impulse);
+	}
+
+	return writer.get_state();
+}
+
+bool GodotSpace2D::restore_state(const PackedByteArray &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+
+	PhysicsSpaceState::Reader reader(p_state);
+	if (!reader.read_header(SPACE_STATE_MAGIC)) {
+		return false;
+	}
+
+	// Parse everything before touching the simulation, so a truncated state doesn't leave the space half restored.
+	LocalVector<Pair<GodotBody2D *, GodotBody2D::SnapshotState>> body_states;
+	if (!PhysicsSpaceState::read_bodies(reader, objects, body_states)) {
+		return false;
+	}
+
+	uint32_t pair_count = 0;
+	ERR_FAIL_COND_V_MSG(!reader.read(pair_count), false, "Invalid space state.");
+
+	LocalVector<Pair<GodotConstraint2D::OrderKey, GodotBodyPair2D::SnapshotState>> pair_states;
+	for (uint32_t i = 0; i < pair_count; i++) {
+		GodotConstraint2D::OrderKey key;
+		GodotBodyPair2D::SnapshotState state;
+		int32_t subindices[2] = {};
+		uint8_t collided = 0;
+		uint8_t oneway_disabled = 0;
+		uint8_t contact_count = 0;
+		bool valid = reader.read(key.ids[0], key.ids[1], subindices[0], subindices[1], state.sep_axis, collided, oneway_disabled, contact_count);
+		ERR_FAIL_COND_V_MSG(!valid || contact_count > GodotBodyPair2D::MAX_CONTACTS, false, "Invalid space state.");
+		key.subindices[0] = subindices[0];
+		key.subindices[1] = subindices[1];
+		state.collided = collided;
+		state.oneway_disabled = oneway_disabled;
+		state.contact_count = contact_count;
+		for (int j = 0; j < state.contact_count; j++) {
+			GodotBodyPair2D::SnapshotContact &contact = state.contacts[j];
+			uint8_t used = 0;
+			valid = reader.read(contact.local_A, contact.local_B, contact.normal, contact.acc_normal_impulse,
+					contact.acc_tangent_impulse, contact.acc_bias_impulse, contact.acc_bias_impulse_center_of_mass, used);
+			ERR_FAIL_COND_V_MSG(!valid, false, "Invalid space state.");
+			contact.used = used;
+		}
+		pair_states.push_back({ key, state });
+	}
+
+	uint32_t joint_count = 0;
+	ERR_FAIL_COND_V_MSG(!reader.read(joint_count), false, "Invalid space state.");
+
+	LocalVector<Pair<uint64_t, GodotJoint2D::SnapshotState>> joint_states;
+	for (uint32_t i = 0; i < joint_count; i++) {
+		uint64_t id = 0;
+		GodotJoint2D::SnapshotState state;
+		ERR_FAIL_COND_V_MSG(!reader.read(id, state.impulse, state.angular_impulse), false, "Invalid space state.");
+		joint_states.push_back({ id, state });
+	}
+	ERR_FAIL_COND_V_MSG(!reader.is_at_end(), false, "Invalid space state.");
+
+	for (const Pair<GodotBody2D *, GodotBody2D::SnapshotState> &E : body_states) {
+		E.first->set_snapshot_state(E.second);
+	}
+
+	// Create the pairs of the restored positions now, so their cached contacts can be restored as well.
+	update();
+
+	LocalVector<GodotConstraint2D *> pairs;
+	LocalVector<GodotConstraint2D *> joints;
+	_get_space_state_constraints(objects, pairs, joints);
+
+	// Pairs that didn't exist when the state was saved start over.
+	PhysicsSpaceState::apply_sorted(
+			pair_states, pairs,
+			[](const GodotConstraint2D *p_constraint) { return p_constraint->get_order_key(); },
+			[](GodotConstraint2D *p_constraint, const GodotBodyPair2D::SnapshotState *p_state) {
+				GodotBodyPair2D::SnapshotState state;
+				if (p_state) {
+					state = *p_state;
+					if (_is_space_state_pair_swapped(p_constraint, p_constraint->get_order_key())) {
+						_swap_space_state_pair(state);
+					}
+				}
+				p_constraint->get_body_pair()->set_snapshot_state(state);
+			});
+
+	// Joints are keyed by their own RID, those created since the state was saved keep their warm start.
+	PhysicsSpaceState::apply_sorted(
+			joint_states, joints,
+			[](const GodotConstraint2D *p_constraint) { return p_constraint->get_self().get_id(); },
+			[](GodotConstraint2D *p_constraint, const GodotJoint2D::SnapshotState *p_state) {
+				if (p_state) {
+					p_constraint->get_joint()->set_snapshot_state(*p_state);
+				}
+			});
+
+	return true;
+}
+
 void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer2D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -1226,6 +1473,7 @@ GodotSpace2D::GodotSpace2D() {
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
+	deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
 
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
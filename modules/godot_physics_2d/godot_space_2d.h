@@ -40,11 +40,25 @@
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+		// Broadphase candidates of every ray, the ones of ray `i` start at `offsets[i]` and end at `offsets[i + 1]`.
+		LocalVector<GodotCollisionObject2D *> objects;
+		LocalVector<int> subindices;
+		LocalVector<uint32_t> offsets;
+	};
+
+	bool _intersect_ray_shapes(const RayParameters &p_parameters, GodotCollisionObject2D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const;
+	void _intersect_ray_batch(uint32_t p_index, RayBatch *p_batch);
+
 public:
 	GodotSpace2D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) override;
@@ -80,6 +94,7 @@ private:
 	GodotBroadPhase2D *broadphase = nullptr;
 	SelfList<GodotBody2D>::List active_list;
 	SelfList<GodotBody2D>::List mass_properties_update_list;
+	SelfList<GodotBody2D>::List sleep_update_list;
 	SelfList<GodotBody2D>::List state_query_list;
 	SelfList<GodotArea2D>::List monitor_query_list;
 	SelfList<GodotArea2D>::List area_moved_list;
@@ -111,6 +126,7 @@ private:
 	real_t body_time_to_sleep = 0.0;
 
 	bool locked = false;
+	bool deterministic = false;
 
 	real_t last_step = 0.001;
 
@@ -137,6 +153,8 @@ public:
 	void body_remove_from_active_list(SelfList<GodotBody2D> *p_body);
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody2D> *p_body);
 	void body_remove_from_mass_properties_update_list(SelfList<GodotBody2D> *p_body);
+	void body_add_to_sleep_update_list(SelfList<GodotBody2D> *p_body);
+	void body_remove_from_sleep_update_list(SelfList<GodotBody2D> *p_body);
 	void area_add_to_moved_list(SelfList<GodotArea2D> *p_area);
 	void area_remove_from_moved_list(SelfList<GodotArea2D> *p_area);
 	const SelfList<GodotArea2D>::List &get_moved_area_list() const;
@@ -167,6 +185,11 @@ public:
 	void setup();
 	void call_queries();
 
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
+
+	PackedByteArray save_state() const;
+	bool restore_state(const PackedByteArray &p_state);
+
 	bool is_locked() const;
 	void lock();
 	void unlock();
@@ -79,6 +79,12 @@ void GodotStep2D::_setup_constraint(uint32_t p_constraint_index, void *p_userdat
 }
 
 void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const {
+	if (deterministic) {
+		// Island traversal follows the order in which pairs and joints were created, use a fixed order instead
+		// so that impulses are always accumulated the same way for the same state.
+		p_constraint_island.sort_custom<GodotConstraint2D::OrderComparator>();
+	}
+
 	uint32_t constraint_count = p_constraint_island.size();
 	uint32_t valid_constraint_count = 0;
 	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
@@ -135,6 +141,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	iterations = p_space->get_solver_iterations();
 	delta = p_delta;
+	deterministic = p_space->is_deterministic();
 
 	const SelfList<GodotBody2D>::List *body_list = &p_space->get_active_body_list();
 
@@ -193,13 +200,25 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	island_seeds.clear();
+	for (b = body_list->first(); b; b = b->next()) {
+		island_seeds.push_back(b->self());
+	}
 
-	uint32_t body_island_count = 0;
+	if (deterministic) {
+		// The active list follows the order in which bodies woke up. Start each island from its body with the lowest RID
+		// instead, so that islands are discovered and filled in the same order for the same state.
+		struct BodyComparator {
+			_FORCE_INLINE_ bool operator()(const GodotBody2D *p_a, const GodotBody2D *p_b) const {
+				return p_a->get_self().get_id() < p_b->get_self().get_id();
+			}
+		};
+		island_seeds.sort_custom<BodyComparator>();
+	}
 
-	while (b) {
-		GodotBody2D *body = b->self();
+	uint32_t body_island_count = 0;
 
+	for (GodotBody2D *body : island_seeds) {
 		if (body->get_island_step() != _step) {
 			++body_island_count;
 			if (body_islands.size() < body_island_count) {
@@ -227,7 +246,6 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 				--island_count;
 			}
 		}
-		b = b->next();
 	}
 
 	p_space->set_island_count((int)island_count);
@@ -31,11 +31,13 @@
 #include "godot_area_pair_3d.h"
 
 #include "godot_collision_solver_3d.h"
+#include "godot_space_3d.h"
 
 bool GodotAreaPair3D::setup(real_t p_step) {
 	bool result = false;
-	if (area->collides_with(body) && GodotCollisionSolver3D::solve_static(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), nullptr, this)) {
-		result = true;
+	if (area->collides_with(body)) {
+		area->get_space()->add_narrowphase_test();
+		result = GodotCollisionSolver3D::solve_static(body->get_shape(body_shape), body->get_transform() * body->get_shape_transform(body_shape), area->get_shape(area_shape), area->get_transform() * area->get_shape_transform(area_shape), nullptr, this);
 	}
 
 	process_collision = false;
@@ -123,9 +125,12 @@ GodotAreaPair3D::~GodotAreaPair3D() {
 bool GodotArea2Pair3D::setup(real_t p_step) {
 	bool result_a = area_a->collides_with(area_b);
 	bool result_b = area_b->collides_with(area_a);
-	if ((result_a || result_b) && !GodotCollisionSolver3D::solve_static(area_a->get_shape(shape_a), area_a->get_transform() * area_a->get_shape_transform(shape_a), area_b->get_shape(shape_b), area_b->get_transform() * area_b->get_shape_transform(shape_b), nullptr, this)) {
-		result_a = false;
-		result_b = false;
+	if (result_a || result_b) {
+		area_a->get_space()->add_narrowphase_test();
+		if (!GodotCollisionSolver3D::solve_static(area_a->get_shape(shape_a), area_a->get_transform() * area_a->get_shape_transform(shape_a), area_b->get_shape(shape_b), area_b->get_transform() * area_b->get_shape_transform(shape_b), nullptr, this)) {
+			result_a = false;
+			result_b = false;
+		}
 	}
 
 	bool process_collision = false;
@@ -207,16 +212,15 @@ GodotArea2Pair3D::~GodotArea2Pair3D() {
 
 bool GodotAreaSoftBodyPair3D::setup(real_t p_step) {
 	bool result = false;
-	if (
-			area->collides_with(soft_body) &&
-			GodotCollisionSolver3D::solve_static(
-					soft_body->get_shape(soft_body_shape),
-					soft_body->get_transform() * soft_body->get_shape_transform(soft_body_shape),
-					area->get_shape(area_shape),
-					area->get_transform() * area->get_shape_transform(area_shape),
-					nullptr,
-					this)) {
-		result = true;
+	if (area->collides_with(soft_body)) {
+		area->get_space()->add_narrowphase_test();
+		result = GodotCollisionSolver3D::solve_static(
+				soft_body->get_shape(soft_body_shape),
+				soft_body->get_transform() * soft_body->get_shape_transform(soft_body_shape),
+				area->get_shape(area_shape),
+				area->get_transform() * area->get_shape_transform(area_shape),
+				nullptr,
+				this);
 	}
 
 	process_collision = false;
@@ -171,6 +171,36 @@ void GodotBody3D::reset_mass_properties() {
 	_mass_properties_changed();
 }
 
+void GodotBody3D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.transform = get_transform();
+	r_state.inv_transform = get_inv_transform();
+	r_state.new_transform = new_transform;
+	r_state.linear_velocity = linear_velocity;
+	r_state.angular_velocity = angular_velocity;
+	r_state.applied_force = applied_force;
+	r_state.applied_torque = applied_torque;
+	r_state.still_time = still_time;
+	r_state.active = active;
+}
+
+void GodotBody3D::set_snapshot_state(const SnapshotState &p_state) {
+	_set_transform(p_state.transform);
+	_set_inv_transform(p_state.inv_transform);
+	_update_transform_dependent();
+	new_transform = p_state.new_transform;
+	linear_velocity = p_state.linear_velocity;
+	angular_velocity = p_state.angular_velocity;
+	applied_force = p_state.applied_force;
+	applied_torque = p_state.applied_torque;
+	still_time = p_state.still_time;
+	set_active(p_state.active);
+
+	// Let the direct body state and the nodes see the restored transform on the next sync.
+	if ((fi_callback_data || body_state_callback.is_valid()) && get_space() && !direct_state_query_list.in_list()) {
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+}
+
 void GodotBody3D::set_active(bool p_active) {
 	if (active == p_active) {
 		return;
@@ -188,6 +218,15 @@ void GodotBody3D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	// The broadphase isn't thread-safe, the space moves the shapes on its next update.
+	if (get_space() && !sleep_update_list.in_list()) {
+		get_space()->body_add_to_sleep_update_list(&sleep_update_list);
+	}
+}
+
+void GodotBody3D::update_broadphase_sleeping() {
+	_set_sleeping(!active && mode >= PhysicsServer3D::BODY_MODE_RIGID);
 }
 
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
@@ -306,6 +345,8 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 			_set_inv_transform(get_transform().affine_inverse());
 			_inv_mass = 0;
 			_inv_inertia = Vector3();
+			// Only rigid bodies use the sleeping tier.
+			_set_sleeping(false);
 			_set_static(p_mode == PhysicsServer3D::BODY_MODE_STATIC);
 			set_active(p_mode == PhysicsServer3D::BODY_MODE_KINEMATIC && contacts.size());
 			linear_velocity = Vector3();
@@ -449,6 +490,9 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 		if (direct_state_query_list.in_list()) {
 			get_space()->body_remove_from_state_query_list(&direct_state_query_list);
 		}
+		if (sleep_update_list.in_list()) {
+			get_space()->body_remove_from_sleep_update_list(&sleep_update_list);
+		}
 	}
 
 	_set_space(p_space);
@@ -459,6 +503,9 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 		if (active && !active_list.in_list()) {
 			get_space()->body_add_to_active_list(&active_list);
 		}
+		if (!sleep_update_list.in_list()) {
+			get_space()->body_add_to_sleep_update_list(&sleep_update_list);
+		}
 	}
 }
 
@@ -665,7 +712,8 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_linear_velocity = Vector3();
 
 	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
+		_compute_shapes_aabb_with_motion(motion);
+		broadphase_update_pending = true;
 	}
 
 	contact_count = 0;
@@ -679,7 +727,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 	ERR_FAIL_NULL(get_space());
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
-		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+		state_query_pending = true;
 	}
 
 	//apply axis lock linear
@@ -702,7 +750,7 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 		_set_transform(new_transform, false);
 		_set_inv_transform(new_transform.affine_inverse());
 		if (contacts.is_empty() && linear_velocity == Vector3() && angular_velocity == Vector3()) {
-			set_active(false); //stopped moving, deactivate
+			deactivation_pending = true; //stopped moving, deactivate
 		}
 
 		return;
@@ -731,12 +779,31 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 
 	transform_new.origin += total_linear_velocity * p_step;
 
-	_set_transform(transform_new);
+	_set_transform(transform_new, false);
 	_set_inv_transform(get_transform().inverse());
+	_compute_shapes_aabb();
+	broadphase_update_pending = true;
 
 	_update_transform_dependent();
 }
 
+void GodotBody3D::flush_integration() {
+	if (state_query_pending) {
+		state_query_pending = false;
+		get_space()->body_add_to_state_query_list(&direct_state_query_list);
+	}
+
+	if (broadphase_update_pending) {
+		broadphase_update_pending = false;
+		_update_shapes_broadphase();
+	}
+
+	if (deactivation_pending) {
+		deactivation_pending = false;
+		set_active(false);
+	}
+}
+
 void GodotBody3D::wakeup_neighbours() {
 	for (const KeyValue<GodotConstraint3D *, int> &E : constraint_map) {
 		const GodotConstraint3D *c = E.key;
@@ -828,7 +895,8 @@ GodotBody3D::GodotBody3D() :
 		GodotCollisionObject3D(TYPE_BODY),
 		active_list(this),
 		mass_properties_update_list(this),
-		direct_state_query_list(this) {
+		direct_state_query_list(this),
+		sleep_update_list(this) {
 	_set_static(false);
 }
 
@@ -98,6 +98,7 @@ class GodotBody3D : public GodotCollisionObject3D {
 	SelfList<GodotBody3D> active_list;
 	SelfList<GodotBody3D> mass_properties_update_list;
 	SelfList<GodotBody3D> direct_state_query_list;
+	SelfList<GodotBody3D> sleep_update_list;
 
 	VSet<RID> exceptions;
 	bool omit_force_integration = false;
@@ -107,6 +108,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 
+	// Work deferred by the integration steps because it modifies the space.
+	bool broadphase_update_pending = false;
+	bool state_query_pending = false;
+	bool deactivation_pending = false;
+
 	void _mass_properties_changed();
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
@@ -150,6 +156,22 @@ class GodotBody3D : public GodotCollisionObject3D {
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
 public:
+	// Simulation state that changes from one step to the next, saved and restored by space snapshots.
+	struct SnapshotState {
+		Transform3D transform;
+		Transform3D inv_transform;
+		Transform3D new_transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		Vector3 applied_force;
+		Vector3 applied_torque;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	void set_snapshot_state(const SnapshotState &p_state);
+
 	void set_state_sync_callback(const Callable &p_callable);
 	void set_force_integration_callback(const Callable &p_callable, const Variant &p_udata = Variant());
 
@@ -229,6 +251,12 @@ public:
 		angular_velocity += _inv_inertia_tensor.xform((p_position - center_of_mass).cross(p_impulse));
 	}
 
+	// Same as apply_impulse(), with the angular velocity change already computed by the caller.
+	_FORCE_INLINE_ void apply_impulse_with_angular_delta(const Vector3 &p_impulse, const Vector3 &p_angular_delta) {
+		linear_velocity += p_impulse * _inv_mass;
+		angular_velocity += p_angular_delta;
+	}
+
 	_FORCE_INLINE_ void apply_torque_impulse(const Vector3 &p_impulse) {
 		angular_velocity += _inv_inertia_tensor.xform(p_impulse);
 	}
@@ -244,6 +272,17 @@ public:
 		}
 	}
 
+	_FORCE_INLINE_ void apply_bias_impulse_with_angular_delta(const Vector3 &p_impulse, const Vector3 &p_angular_delta, real_t p_max_delta_av = -1.0) {
+		biased_linear_velocity += p_impulse * _inv_mass;
+		if (p_max_delta_av != 0.0) {
+			Vector3 delta_av = p_angular_delta;
+			if (p_max_delta_av > 0 && delta_av.length() > p_max_delta_av) {
+				delta_av = delta_av.normalized() * p_max_delta_av;
+			}
+			biased_angular_velocity += delta_av;
+		}
+	}
+
 	_FORCE_INLINE_ void apply_bias_torque_impulse(const Vector3 &p_impulse) {
 		biased_angular_velocity += _inv_inertia_tensor.xform(p_impulse);
 	}
@@ -305,6 +344,8 @@ public:
 	void set_space(GodotSpace3D *p_space) override;
 
 	void update_mass_properties();
+	// Moves the shapes to the sleeping tier of the broadphase, or out of it, to match the active state.
+	void update_broadphase_sleeping();
 	void reset_mass_properties();
 
 	_FORCE_INLINE_ real_t get_inv_mass() const { return _inv_mass; }
@@ -316,8 +357,10 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
+	// The integration steps can run on several bodies in parallel, `flush_integration()` must then be called serially.
 	void integrate_forces(real_t p_step);
 	void integrate_velocities(real_t p_step);
+	void flush_integration();
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
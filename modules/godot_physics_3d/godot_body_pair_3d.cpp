@@ -294,6 +294,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
+	space->add_narrowphase_test();
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
 	if (!collided) {
@@ -401,6 +402,8 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		real_t kNormal = inv_mass_A + inv_mass_B;
 		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
 		c.mass_normal = 1.0f / kNormal;
+		c.angular_normal_A = inertia_A;
+		c.angular_normal_B = inertia_B;
 
 		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
 		c.depth = depth;
@@ -466,6 +469,9 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 	real_t inv_mass_A = collide_A ? A->get_inv_mass() : 0.0;
 	real_t inv_mass_B = collide_B ? B->get_inv_mass() : 0.0;
+	const real_t inv_mass_sum = inv_mass_A + inv_mass_B;
+
+	const real_t friction = combine_friction(A, B);
 
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
@@ -488,13 +494,14 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			real_t jbnOld = c.acc_bias_impulse;
 			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
 
-			Vector3 jb = c.normal * (c.acc_bias_impulse - jbnOld);
+			const real_t jb_len = c.acc_bias_impulse - jbnOld;
+			Vector3 jb = c.normal * jb_len;
 
 			if (collide_A) {
-				A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), max_bias_av);
+				A->apply_bias_impulse_with_angular_delta(-jb, c.angular_normal_A * -jb_len, max_bias_av);
 			}
 			if (collide_B) {
-				B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), max_bias_av);
+				B->apply_bias_impulse_with_angular_delta(jb, c.angular_normal_B * jb_len, max_bias_av);
 			}
 
 			crbA = A->get_biased_angular_velocity().cross(c.rA);
@@ -504,7 +511,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			vbn = dbv.dot(c.normal);
 
 			if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
-				real_t jbn_com = (-vbn + c.bias) / (inv_mass_A + inv_mass_B);
+				real_t jbn_com = (-vbn + c.bias) / inv_mass_sum;
 				real_t jbnOld_com = c.acc_bias_impulse_center_of_mass;
 				c.acc_bias_impulse_center_of_mass = MAX(jbnOld_com + jbn_com, 0.0f);
 
@@ -533,13 +540,14 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			real_t jnOld = c.acc_normal_impulse;
 			c.acc_normal_impulse = MAX(jnOld + jn, 0.0f);
 
-			Vector3 j = c.normal * (c.acc_normal_impulse - jnOld);
+			const real_t j_len = c.acc_normal_impulse - jnOld;
+			Vector3 j = c.normal * j_len;
 
 			if (collide_A) {
-				A->apply_impulse(-j, c.rA + A->get_center_of_mass());
+				A->apply_impulse_with_angular_delta(-j, c.angular_normal_A * -j_len);
 			}
 			if (collide_B) {
-				B->apply_impulse(j, c.rB + B->get_center_of_mass());
+				B->apply_impulse_with_angular_delta(j, c.angular_normal_B * j_len);
 			}
 			c.acc_impulse -= j;
 
@@ -548,8 +556,6 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		//friction impulse
 
-		real_t friction = combine_friction(A, B);
-
 		Vector3 lvA = A->get_linear_velocity() + A->get_angular_velocity().cross(c.rA);
 		Vector3 lvB = B->get_linear_velocity() + B->get_angular_velocity().cross(c.rB);
 
@@ -566,7 +572,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 			Vector3 temp1 = inv_inertia_tensor_A.xform(c.rA.cross(tv));
 			Vector3 temp2 = inv_inertia_tensor_B.xform(c.rB.cross(tv));
 
-			real_t t = -tvl / (inv_mass_A + inv_mass_B + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
+			real_t t = -tvl / (inv_mass_sum + tv.dot(temp1.cross(c.rA) + temp2.cross(c.rB)));
 
 			Vector3 jt = t * tv;
 
@@ -595,6 +601,47 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::get_snapshot_state(SnapshotState &r_state) const {
+	r_state.sep_axis = sep_axis;
+	r_state.contact_count = contact_count;
+	r_state.collided = collided;
+	for (int i = 0; i < contact_count; i++) {
+		const Contact &c = contacts[i];
+		SnapshotContact &sc = r_state.contacts[i];
+		sc.index_A = c.index_A;
+		sc.index_B = c.index_B;
+		sc.local_A = c.local_A;
+		sc.local_B = c.local_B;
+		sc.normal = c.normal;
+		sc.acc_normal_impulse = c.acc_normal_impulse;
+		sc.acc_tangent_impulse = c.acc_tangent_impulse;
+		sc.acc_bias_impulse = c.acc_bias_impulse;
+		sc.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		sc.used = c.used;
+	}
+}
+
+void GodotBodyPair3D::set_snapshot_state(const SnapshotState &p_state) {
+	sep_axis = p_state.sep_axis;
+	contact_count = CLAMP(p_state.contact_count, 0, (int)MAX_CONTACTS);
+	collided = p_state.collided;
+	for (int i = 0; i < contact_count; i++) {
+		const SnapshotContact &sc = p_state.contacts[i];
+		Contact &c = contacts[i];
+		c = Contact();
+		c.index_A = sc.index_A;
+		c.index_B = sc.index_B;
+		c.local_A = sc.local_A;
+		c.local_B = sc.local_B;
+		c.normal = sc.normal;
+		c.acc_normal_impulse = sc.acc_normal_impulse;
+		c.acc_tangent_impulse = sc.acc_tangent_impulse;
+		c.acc_bias_impulse = sc.acc_bias_impulse;
+		c.acc_bias_impulse_center_of_mass = sc.acc_bias_impulse_center_of_mass;
+		c.used = sc.used;
+	}
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -722,6 +769,7 @@ bool GodotBodySoftBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = body->get_shape(body_shape);
 	GodotShape3D *shape_B_ptr = soft_body->get_shape(0);
 
+	space->add_narrowphase_test();
 	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
 
 	return collided;
@@ -56,6 +56,7 @@ protected:
 		bool active = false;
 		bool used = false;
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
+		Vector3 angular_normal_A, angular_normal_B; // Angular velocity change per unit of normal impulse, (inv_inertia * (r x normal))
 	};
 
 	Vector3 sep_axis;
@@ -70,10 +71,12 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+public:
 	enum {
 		MAX_CONTACTS = 4
 	};
 
+private:
 	union {
 		struct {
 			GodotBody3D *A;
@@ -104,6 +107,35 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
+	// Data carried over from one step to the next, saved and restored by space snapshots.
+	struct SnapshotContact {
+		int index_A = 0, index_B = 0;
+		Vector3 local_A, local_B;
+		Vector3 normal;
+		real_t acc_normal_impulse = 0.0;
+		Vector3 acc_tangent_impulse;
+		real_t acc_bias_impulse = 0.0;
+		real_t acc_bias_impulse_center_of_mass = 0.0;
+		bool used = false;
+	};
+
+	struct SnapshotState {
+		Vector3 sep_axis;
+		SnapshotContact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		bool collided = false;
+	};
+
+	void get_snapshot_state(SnapshotState &r_state) const;
+	void set_snapshot_state(const SnapshotState &p_state);
+
+	_FORCE_INLINE_ GodotBody3D *get_body_A() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_B() const { return B; }
+	_FORCE_INLINE_ int get_shape_A() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_B() const { return shape_B; }
+
+	virtual GodotBodyPair3D *get_body_pair() override { return this; }
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
@@ -75,6 +75,7 @@ private:
 	Transform3D transform;
 	Transform3D inv_transform;
 	bool _static = true;
+	bool _sleeping = false;
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
 
@@ -82,6 +83,12 @@ private:
 
 protected:
 	void _update_shapes_with_motion(const Vector3 &p_motion);
+
+	// Only touch the object itself, can run on several objects in parallel.
+	void _compute_shapes_aabb();
+	void _compute_shapes_aabb_with_motion(const Vector3 &p_motion);
+	// Sends the cached shape AABBs to the broadphase, not thread-safe.
+	void _update_shapes_broadphase();
 	void _unregister_shapes();
 
 	_FORCE_INLINE_ void _set_transform(const Transform3D &p_transform, bool p_update_shapes = true) {
@@ -97,6 +104,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform3D &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_sleeping(bool p_sleeping);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(GodotSpace3D *p_space);
@@ -196,6 +196,20 @@ PhysicsDirectSpaceState3D *GodotPhysicsServer3D::space_get_direct_state(RID p_sp
 	return space->get_direct_state();
 }
 
+PackedByteArray GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+
+	return space->save_state();
+}
+
+bool GodotPhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+
+	return space->restore_state(p_state);
+}
+
 void GodotPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 	GodotSpace3D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL(space);
@@ -1670,6 +1684,14 @@ void GodotPhysicsServer3D::init() {
 	stepper = memnew(GodotStep3D);
 }
 
+static const char *elapsed_time_names[GodotSpace3D::ELAPSED_TIME_MAX] = {
+	"integrate_forces",
+	"generate_islands",
+	"setup_constraints",
+	"solve_constraints",
+	"integrate_velocities"
+};
+
 void GodotPhysicsServer3D::step(real_t p_step) {
 	if (!active) {
 		return;
@@ -1681,7 +1703,20 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	active_objects = 0;
 	collision_pairs = 0;
 	for (GodotSpace3D *E : active_spaces) {
-		stepper->step(E, p_step);
+		if (tracing) {
+			uint64_t step_begin = OS::get_singleton()->get_ticks_usec();
+			stepper->step(E, p_step);
+			uint64_t step_end = OS::get_singleton()->get_ticks_usec();
+
+			_add_trace_event("step", E->get_self(), step_begin, step_end);
+			for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+				GodotSpace3D::ElapsedTime phase = GodotSpace3D::ElapsedTime(i);
+				uint64_t phase_begin = E->get_elapsed_time_begin(phase);
+				_add_trace_event(elapsed_time_names[i], E->get_self(), phase_begin, phase_begin + E->get_elapsed_time(phase));
+			}
+		} else {
+			stepper->step(E, p_step);
+		}
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
@@ -1710,14 +1745,6 @@ void GodotPhysicsServer3D::flush_queries() {
 
 	if (EngineDebugger::is_profiling("servers")) {
 		uint64_t total_time[GodotSpace3D::ELAPSED_TIME_MAX];
-		static const char *time_name[GodotSpace3D::ELAPSED_TIME_MAX] = {
-			"integrate_forces",
-			"generate_islands",
-			"setup_constraints",
-			"solve_constraints",
-			"integrate_velocities"
-		};
-
 		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
 			total_time[i] = 0;
 		}
@@ -1731,7 +1758,7 @@ void GodotPhysicsServer3D::flush_queries() {
 		Array values;
 		values.resize(GodotSpace3D::ELAPSED_TIME_MAX * 2);
 		for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
-			values[i * 2 + 0] = time_name[i];
+			values[i * 2 + 0] = elapsed_time_names[i];
 			values[i * 2 + 1] = USEC_TO_SEC(total_time[i]);
 		}
 		values.push_back("flush_queries");
@@ -1766,6 +1793,28 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 	return 0;
 }
 
+Dictionary GodotPhysicsServer3D::space_get_profiling_info(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Dictionary());
+
+	Dictionary info;
+	info["active_objects"] = space->get_active_objects();
+	info["collision_pairs"] = space->get_collision_pairs();
+	info["narrowphase_tests"] = space->get_narrowphase_tests();
+	info["island_count"] = space->get_island_count();
+	info["largest_island"] = space->get_largest_island_size();
+	info["solver_iterations"] = space->get_solver_iterations();
+	info["sleeping_bodies"] = space->get_sleeping_body_count();
+
+	Dictionary phase_times;
+	for (int i = 0; i < GodotSpace3D::ELAPSED_TIME_MAX; i++) {
+		phase_times[elapsed_time_names[i]] = space->get_elapsed_time(GodotSpace3D::ElapsedTime(i));
+	}
+	info["phase_times_usec"] = phase_times;
+
+	return info;
+}
+
 void GodotPhysicsServer3D::_update_shapes() {
 	while (pending_shape_update_list.first()) {
 		pending_shape_update_list.first()->self()->_shape_changed();
@@ -1330,41 +1330,58 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+void GodotConcavePolygonShape3D::_quantize_aabb(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const {
+	const Vector3 from = (p_aabb.position - bvh_origin) * bvh_inv_scale;
+	const Vector3 to = (p_aabb.position + p_aabb.size - bvh_origin) * bvh_inv_scale;
 
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
+	// Rounded outwards with an extra step, so the quantized bounds always enclose the original ones despite precision loss.
+	for (int i = 0; i < 3; i++) {
+		r_min[i] = (uint16_t)CLAMP(Math::floor(from[i]) - 1.0, 0.0, (real_t)UINT16_MAX);
+		r_max[i] = (uint16_t)CLAMP(Math::ceil(to[i]) + 1.0, 0.0, (real_t)UINT16_MAX);
 	}
+}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		int face_index = params_bvh->face_index;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->face_index = face_index;
-				p_params->collisions++;
-			}
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
+AABB GodotConcavePolygonShape3D::_dequantize_aabb(const BVH &p_node) const {
+	const Vector3 from = Vector3(p_node.min[0], p_node.min[1], p_node.min[2]) * bvh_scale + bvh_origin;
+	const Vector3 to = Vector3(p_node.max[0], p_node.max[1], p_node.max[2]) * bvh_scale + bvh_origin;
+	return AABB(from, to - from);
+}
+
+void GodotConcavePolygonShape3D::_cull_segment(_SegmentCullParams *p_params) const {
+	int idx = 0;
+	while (idx < p_params->bvh_size) {
+		const BVH *params_bvh = &p_params->bvh[idx];
+
+		if (!_dequantize_aabb(*params_bvh).intersects_segment(p_params->from, p_params->to)) {
+			// Skip the whole subtree.
+			idx = params_bvh->get_next(idx);
+			continue;
 		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
+
+		if (params_bvh->is_leaf()) {
+			const Face *f = &p_params->faces[params_bvh->data];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+
+			Vector3 res;
+			Vector3 normal;
+			int face_index = params_bvh->data;
+			if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
+				real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
+				if ((d > 0) && (d < p_params->min_d)) {
+					p_params->min_d = d;
+					p_params->result = res;
+					p_params->normal = normal;
+					p_params->face_index = face_index;
+					p_params->collisions++;
+				}
+			}
 		}
+
+		idx++;
 	}
 }
 
@@ -1389,11 +1406,12 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_size = bvh.size();
 
 	params.face = &face;
 
 	// cull
-	_cull_segment(0, &params);
+	_cull_segment(&params);
 
 	if (params.collisions > 0) {
 		r_result = params.result;
@@ -1413,35 +1431,34 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+bool GodotConcavePolygonShape3D::_cull(_CullParams *p_params) const {
+	int idx = 0;
+	while (idx < p_params->bvh_size) {
+		const BVH *params_bvh = &p_params->bvh[idx];
 
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
+		const bool overlaps = params_bvh->min[0] <= p_params->aabb_max[0] && params_bvh->max[0] >= p_params->aabb_min[0] &&
+				params_bvh->min[1] <= p_params->aabb_max[1] && params_bvh->max[1] >= p_params->aabb_min[1] &&
+				params_bvh->min[2] <= p_params->aabb_max[2] && params_bvh->max[2] >= p_params->aabb_min[2];
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
+		if (!overlaps) {
+			// Skip the whole subtree.
+			idx = params_bvh->get_next(idx);
+			continue;
 		}
 
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
+		if (params_bvh->is_leaf()) {
+			const Face *f = &p_params->faces[params_bvh->data];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+			if (p_params->callback(p_params->userdata, face)) {
 				return true;
 			}
 		}
+
+		idx++;
 	}
 
 	return false;
@@ -1453,7 +1470,9 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
+	if (!get_aabb().intersects(p_local_aabb)) {
+		return;
+	}
 
 	// unlock data
 	const Face *fr = faces.ptr();
@@ -1465,16 +1484,17 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	face.invert_backface_collision = p_invert_backface_collision;
 
 	_CullParams params;
-	params.aabb = local_aabb;
+	_quantize_aabb(p_local_aabb, params.aabb_min, params.aabb_max);
 	params.face = &face;
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_size = bvh.size();
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	_cull(&params);
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1569,26 +1589,17 @@ _Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int
 }
 
 void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
-	int idx = p_idx;
-
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
-	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
+	int idx = p_idx++;
 
-	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
-		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
+	_quantize_aabb(p_bvh_tree->aabb, p_bvh_array[idx].min, p_bvh_array[idx].max);
 
+	if (p_bvh_tree->face_index >= 0) {
+		p_bvh_array[idx].data = p_bvh_tree->face_index;
 	} else {
-		p_bvh_array[p_idx].left = -1;
-	}
-
-	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
+		// Branches always have both children.
+		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
 		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].right = -1;
+		p_bvh_array[idx].data = -p_idx;
 	}
 
 	memdelete(p_bvh_tree);
@@ -1639,15 +1650,22 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 		}
 	}
 
+	// Node bounds are quantized to 16 bits per axis inside the shape's AABB, slightly grown so rounding never clamps.
+	const real_t quantization_margin = MAX(_aabb.get_longest_axis_size() * 0.001, (real_t)CMP_EPSILON);
+	bvh_origin = _aabb.position - Vector3(quantization_margin, quantization_margin, quantization_margin);
+	bvh_scale = (_aabb.size + Vector3(quantization_margin, quantization_margin, quantization_margin) * 2.0) / (real_t)UINT16_MAX;
+	bvh_inv_scale = Vector3(1.0 / bvh_scale.x, 1.0 / bvh_scale.y, 1.0 / bvh_scale.z);
+
 	int count = 0;
 	_Volume_BVH *bvh_tree = _volume_build_bvh(bvh_arrayw, src_face_count, count);
 
-	bvh.resize(count + 1);
+	bvh.resize(count);
 
 	BVH *bvh_arrayw2 = bvh.ptrw();
 
 	int idx = 0;
 	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
+	DEV_ASSERT(idx == count);
 
 	backface_collision = p_backface_collision;
 
@@ -315,23 +315,32 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Nodes are stored depth-first, so a branch's first child is the node right after it.
 	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+		// Bounds quantized to the shape's AABB, see `_quantize_aabb()`.
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Face index for leaves. For branches, minus the index of the node that follows their subtree.
+		int32_t data = 0;
+
+		_FORCE_INLINE_ bool is_leaf() const { return data >= 0; }
+		_FORCE_INLINE_ int get_next(int p_idx) const { return data >= 0 ? p_idx + 1 : -data; }
 	};
 
 	Vector<BVH> bvh;
+	Vector3 bvh_origin;
+	Vector3 bvh_scale;
+	Vector3 bvh_inv_scale;
 
 	struct _CullParams {
-		AABB aabb;
+		uint16_t aabb_min[3] = {};
+		uint16_t aabb_max[3] = {};
 		QueryCallback callback = nullptr;
 		void *userdata = nullptr;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
 		const BVH *bvh = nullptr;
+		int bvh_size = 0;
 		GodotFaceShape3D *face = nullptr;
 	};
 
@@ -342,6 +351,7 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
 		const BVH *bvh = nullptr;
+		int bvh_size = 0;
 		GodotFaceShape3D *face = nullptr;
 
 		Vector3 result;
@@ -353,8 +363,11 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	void _quantize_aabb(const AABB &p_aabb, uint16_t *r_min, uint16_t *r_max) const;
+	AABB _dequantize_aabb(const BVH &p_node) const;
+
+	void _cull_segment(_SegmentCullParams *p_params) const;
+	bool _cull(_CullParams *p_params) const;
 
 	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
 
@@ -34,6 +34,8 @@
 #include "godot_physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "servers/physics_space_state.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_pair_3d.h"
 
@@ -110,14 +112,18 @@ int GodotPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_par
 bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
 	ERR_FAIL_COND_V(space->locked, false);
 
+	int amount = space->broadphase->cull_segment(p_parameters.from, p_parameters.to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+
+	return _intersect_ray_shapes(p_parameters, space->intersection_query_results, space->intersection_query_subindex_results, amount, r_result);
+}
+
+bool GodotPhysicsDirectSpaceState3D::_intersect_ray_shapes(const RayParameters &p_parameters, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const {
 	Vector3 begin, end;
 	Vector3 normal;
 	begin = p_parameters.from;
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
-
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
 	bool collided = false;
@@ -127,22 +133,22 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	const GodotCollisionObject3D *res_obj = nullptr;
 	real_t min_d = 1e10;
 
-	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+	for (int i = 0; i < p_amount; i++) {
+		if (!_can_collide_with(p_objects[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.pick_ray && !(space->intersection_query_results[i]->is_ray_pickable())) {
+		if (p_parameters.pick_ray && !(p_objects[i]->is_ray_pickable())) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(p_objects[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject3D *col_obj = p_objects[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = p_subindices[i];
 		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector3 local_from = inv_xform.xform(begin);
@@ -207,6 +213,41 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
+void GodotPhysicsDirectSpaceState3D::_intersect_ray_batch(uint32_t p_index, RayBatch *p_batch) {
+	const uint32_t from = p_batch->offsets[p_index];
+	const int amount = p_batch->offsets[p_index + 1] - from;
+	p_batch->hits[p_index] = _intersect_ray_shapes(p_batch->parameters[p_index], p_batch->objects.ptr() + from, p_batch->subindices.ptr() + from, amount, p_batch->results[p_index]);
+}
+
+void GodotPhysicsDirectSpaceState3D::intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_hits) {
+	ERR_FAIL_COND(space->locked);
+
+	if (p_count <= 0) {
+		return;
+	}
+
+	// The broadphase isn't thread-safe, so all rays are culled first and their shapes are then tested in parallel.
+	RayBatch batch;
+	batch.parameters = p_parameters;
+	batch.results = r_results;
+	batch.hits = r_hits;
+	batch.offsets.resize(p_count + 1);
+
+	for (int i = 0; i < p_count; i++) {
+		batch.offsets[i] = batch.objects.size();
+
+		int amount = space->broadphase->cull_segment(p_parameters[i].from, p_parameters[i].to, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+		for (int j = 0; j < amount; j++) {
+			batch.objects.push_back(space->intersection_query_results[j]);
+			batch.subindices.push_back(space->intersection_query_subindex_results[j]);
+		}
+	}
+	batch.offsets[p_count] = batch.objects.size();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsDirectSpaceState3D::_intersect_ray_batch, &batch, p_count, -1, true, SNAME("Physics3DIntersectRays"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max <= 0) {
 		return 0;
@@ -1105,6 +1146,14 @@ void GodotSpace3D::body_remove_from_mass_properties_update_list(SelfList<GodotBo
 	mass_properties_update_list.remove(p_body);
 }
 
+void GodotSpace3D::body_add_to_sleep_update_list(SelfList<GodotBody3D> *p_body) {
+	sleep_update_list.add(p_body);
+}
+
+void GodotSpace3D::body_remove_from_sleep_update_list(SelfList<GodotBody3D> *p_body) {
+	sleep_update_list.remove(p_body);
+}
+
 GodotBroadPhase3D *GodotSpace3D::get_broadphase() {
 	return broadphase;
 }
@@ -1186,9 +1235,206 @@ void GodotSpace3D::setup() {
 }
 
 void GodotSpace3D::update() {
+	while (sleep_update_list.first()) {
+		sleep_update_list.first()->self()->update_broadphase_sleeping();
+		sleep_update_list.remove(sleep_update_list.first());
+	}
+
 	broadphase->update();
 }
 
+static const uint32_t SPACE_STATE_MAGIC = 0x44335347; // "GS3D"
+
+// Identifies a body pair by the bodies and shapes it connects, so it can be matched after the pair was recreated.
+// The broadphase doesn't report pairs in a fixed order, so the body with the lower RID always comes first.
+struct SpaceStatePairKey {
+	uint64_t ids[2] = {};
+	int32_t shapes[2] = {};
+	// The pair stores its bodies the other way around.
+	bool swapped = false;
+
+	SpaceStatePairKey() {}
+	SpaceStatePairKey(const GodotBodyPair3D *p_pair) {
+		ids[0] = p_pair->get_body_A()->get_self().get_id();
+		ids[1] = p_pair->get_body_B()->get_self().get_id();
+		shapes[0] = p_pair->get_shape_A();
+		shapes[1] = p_pair->get_shape_B();
+		if (ids[0] > ids[1]) {
+			SWAP(ids[0], ids[1]);
+			SWAP(shapes[0], shapes[1]);
+			swapped = true;
+		}
+	}
+
+	_FORCE_INLINE_ bool operator<(const SpaceStatePairKey &p_key) const {
+		if (ids[0] != p_key.ids[0]) {
+			return ids[0] < p_key.ids[0];
+		}
+		if (ids[1] != p_key.ids[1]) {
+			return ids[1] < p_key.ids[1];
+		}
+		if (shapes[0] != p_key.shapes[0]) {
+			return shapes[0] < p_key.shapes[0];
+		}
+		return shapes[1] < p_key.shapes[1];
+	}
+	_FORCE_INLINE_ bool operator==(const SpaceStatePairKey &p_key) const {
+		return ids[0] == p_key.ids[0] && ids[1] == p_key.ids[1] && shapes[0] == p_key.shapes[0] && shapes[1] == p_key.shapes[1];
+	}
+};
+
+struct SpaceStatePairComparator {
+	_FORCE_INLINE_ bool operator()(const GodotBodyPair3D *p_a, const GodotBodyPair3D *p_b) const {
+		return SpaceStatePairKey(p_a) < SpaceStatePairKey(p_b);
+	}
+};
+
+// Converts pair state between the order of the pair and the order of its key.
+static void _swap_space_state_pair(GodotBodyPair3D::SnapshotState &r_state) {
+	r_state.sep_axis = -r_state.sep_axis;
+	for (int i = 0; i < r_state.contact_count; i++) {
+		GodotBodyPair3D::SnapshotContact &contact = r_state.contacts[i];
+		SWAP(contact.index_A, contact.index_B);
+		SWAP(contact.local_A, contact.local_B);
+		// The impulse is applied as -j to A and +j to B.
+		contact.normal = -contact.normal;
+		contact.acc_tangent_impulse = -contact.acc_tangent_impulse;
+	}
+}
+
+static void _get_space_state_pairs(const HashSet<GodotCollisionObject3D *> &p_objects, LocalVector<GodotBodyPair3D *> &r_pairs) {
+	for (GodotCollisionObject3D *object : p_objects) {
+		if (object->get_type() != GodotCollisionObject3D::TYPE_BODY) {
+			continue;
+		}
+		for (const KeyValue<GodotConstraint3D *, int> &E : static_cast<GodotBody3D *>(object)->get_constraint_map()) {
+			// Each pair is listed by both of its bodies, only keep it once.
+			GodotBodyPair3D *pair = E.value == 0 ? E.key->get_body_pair() : nullptr;
+			if (pair) {
+				r_pairs.push_back(pair);
+			}
+		}
+	}
+	// Sort by RID so that equal simulation states give equal snapshots.
+	r_pairs.sort_custom<SpaceStatePairComparator>();
+}
+
+PackedByteArray GodotSpace3D::save_state() const {
+	ERR_FAIL_COND_V_MSG(locked, PackedByteArray(), "Space state can't be saved while the space is being stepped.");
+
+	LocalVector<GodotBody3D *> bodies;
+	PhysicsSpaceState::get_bodies(objects, bodies);
+
+	LocalVector<GodotBodyPair3D *> pairs;
+	_get_space_state_pairs(objects, pairs);
+
+	PhysicsSpaceState::Writer writer(SPACE_STATE_MAGIC, bodies.size() * sizeof(GodotBody3D::SnapshotState) + pairs.size() * sizeof(GodotBodyPair3D::SnapshotState));
+	PhysicsSpaceState::write_bodies(writer, bodies);
+
+	writer.write(pairs.size());
+	for (const GodotBodyPair3D *pair : pairs) {
+		SpaceStatePairKey key(pair);
+		GodotBodyPair3D::SnapshotState state;
+		pair->get_snapshot_state(state);
+		if (key.swapped) {
+			_swap_space_state_pair(state);
+		}
+		writer.write(key.ids[0]);
+		writer.write(key.ids[1]);
+		writer.write(key.shapes[0]);
+		writer.write(key.shapes[1]);
+		writer.write(state.sep_axis);
+		writer.write((uint8_t)state.collided);
+		writer.write((uint8_t)state.contact_count);
+		for (int i = 0; i < state.contact_count; i++) {
+			const GodotBodyPair3D::SnapshotContact &contact = state.contacts[i];
+			writer.write((int32_t)contact.index_A);
+			writer.write((int32_t)contact.index_B);
+			writer.write(contact.local_A);
+			writer.write(contact.local_B);
+			writer.write(contact.normal);
+			writer.write(contact.acc_normal_impulse);
+			writer.write(contact.acc_tangent_impulse);
+			writer.write(contact.acc_bias_impulse);
+			writer.write(contact.acc_bias_impulse_center_of_mass);
+			writer.write((uint8_t)contact.used);
+		}
+	}
+
+	return writer.get_state();
+}
+
+bool GodotSpace3D::restore_state(const PackedByteArray &p_state) {
+	ERR_FAIL_COND_V_MSG(locked, false, "Space state can't be restored while the space is being stepped.");
+
+	PhysicsSpaceState::Reader reader(p_state);
+	if (!reader.read_header(SPACE_STATE_MAGIC)) {
+		return false;
+	}
+
+	// Parse everything before touching the simulation, so a truncated state doesn't leave the space half restored.
+	LocalVector<Pair<GodotBody3D *, GodotBody3D::SnapshotState>> body_states;
+	if (!PhysicsSpaceState::read_bodies(reader, objects, body_states)) {
+		return false;
+	}
+
+	uint32_t pair_count = 0;
+	ERR_FAIL_COND_V_MSG(!reader.read(pair_count), false, "Invalid space state.");
+
+	LocalVector<Pair<SpaceStatePairKey, GodotBodyPair3D::SnapshotState>> pair_states;
+	for (uint32_t i = 0; i < pair_count; i++) {
+		SpaceStatePairKey key;
+		GodotBodyPair3D::SnapshotState state;
+		uint8_t collided = 0;
+		uint8_t contact_count = 0;
+		bool valid = reader.read(key.ids[0], key.ids[1], key.shapes[0], key.shapes[1], state.sep_axis, collided, contact_count);
+		ERR_FAIL_COND_V_MSG(!valid || contact_count > GodotBodyPair3D::MAX_CONTACTS, false, "Invalid space state.");
+		state.collided = collided;
+		state.contact_count = contact_count;
+		for (int j = 0; j < state.contact_count; j++) {
+			GodotBodyPair3D::SnapshotContact &contact = state.contacts[j];
+			int32_t index_A = 0;
+			int32_t index_B = 0;
+			uint8_t used = 0;
+			valid = reader.read(index_A, index_B, contact.local_A, contact.local_B, contact.normal,
+					contact.acc_normal_impulse, contact.acc_tangent_impulse, contact.acc_bias_impulse, contact.acc_bias_impulse_center_of_mass, used);
+			ERR_FAIL_COND_V_MSG(!valid, false, "Invalid space state.");
+			contact.index_A = index_A;
+			contact.index_B = index_B;
+			contact.used = used;
+		}
+		pair_states.push_back({ key, state });
+	}
+	ERR_FAIL_COND_V_MSG(!reader.is_at_end(), false, "Invalid space state.");
+
+	for (const Pair<GodotBody3D *, GodotBody3D::SnapshotState> &E : body_states) {
+		E.first->set_snapshot_state(E.second);
+	}
+
+	// Create the pairs of the restored positions now, so their cached contacts can be restored as well.
+	broadphase->update();
+
+	LocalVector<GodotBodyPair3D *> pairs;
+	_get_space_state_pairs(objects, pairs);
+
+	// Pairs that didn't exist when the state was saved start over.
+	PhysicsSpaceState::apply_sorted(
+			pair_states, pairs,
+			[](const GodotBodyPair3D *p_pair) { return SpaceStatePairKey(p_pair); },
+			[](GodotBodyPair3D *p_pair, const GodotBodyPair3D::SnapshotState *p_state) {
+				GodotBodyPair3D::SnapshotState state;
+				if (p_state) {
+					state = *p_state;
+					if (SpaceStatePairKey(p_pair).swapped) {
+						_swap_space_state_pair(state);
+					}
+				}
+				p_pair->set_snapshot_state(state);
+			});
+
+	return true;
+}
+
 void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -36,16 +36,31 @@
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/templates/safe_refcount.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	struct RayBatch {
+		const RayParameters *parameters = nullptr;
+		RayResult *results = nullptr;
+		bool *hits = nullptr;
+		// Broadphase candidates of every ray, the ones of ray `i` start at `offsets[i]` and end at `offsets[i + 1]`.
+		LocalVector<GodotCollisionObject3D *> objects;
+		LocalVector<int> subindices;
+		LocalVector<uint32_t> offsets;
+	};
+
+	bool _intersect_ray_shapes(const RayParameters &p_parameters, GodotCollisionObject3D *const *p_objects, const int *p_subindices, int p_amount, RayResult &r_result) const;
+	void _intersect_ray_batch(uint32_t p_index, RayBatch *p_batch);
+
 public:
 	GodotSpace3D *space = nullptr;
 
 	virtual int intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) override;
+	virtual void intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_hits) override;
 	virtual int intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) override;
 	virtual bool cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info = nullptr) override;
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) override;
@@ -69,6 +84,7 @@ public:
 
 private:
 	uint64_t elapsed_time[ELAPSED_TIME_MAX] = {};
+	uint64_t elapsed_time_begin[ELAPSED_TIME_MAX] = {};
 
 	GodotPhysicsDirectSpaceState3D *direct_access = nullptr;
 	RID self;
@@ -76,6 +92,7 @@ private:
 	GodotBroadPhase3D *broadphase = nullptr;
 	SelfList<GodotBody3D>::List active_list;
 	SelfList<GodotBody3D>::List mass_properties_update_list;
+	SelfList<GodotBody3D>::List sleep_update_list;
 	SelfList<GodotBody3D>::List state_query_list;
 	SelfList<GodotArea3D>::List monitor_query_list;
 	SelfList<GodotArea3D>::List area_moved_list;
@@ -111,6 +128,8 @@ private:
 	real_t last_step = 0.001;
 
 	int island_count = 0;
+	int largest_island_size = 0;
+	SafeNumeric<uint32_t> narrowphase_tests;
 	int active_objects = 0;
 	int collision_pairs = 0;
 
@@ -135,6 +154,8 @@ public:
 	void body_remove_from_active_list(SelfList<GodotBody3D> *p_body);
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
+	void body_add_to_sleep_update_list(SelfList<GodotBody3D> *p_body);
+	void body_remove_from_sleep_update_list(SelfList<GodotBody3D> *p_body);
 
 	void body_add_to_state_query_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_state_query_list(SelfList<GodotBody3D> *p_body);
@@ -168,6 +189,9 @@ public:
 	void setup();
 	void call_queries();
 
+	PackedByteArray save_state() const;
+	bool restore_state(const PackedByteArray &p_state);
+
 	bool is_locked() const;
 	void lock();
 	void unlock();
@@ -181,6 +205,16 @@ public:
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
+	void set_largest_island_size(int p_size) { largest_island_size = p_size; }
+	int get_largest_island_size() const { return largest_island_size; }
+
+	// Shape pairs tested by the narrowphase while setting up constraints, counted from the worker threads.
+	void reset_narrowphase_tests() { narrowphase_tests.set(0); }
+	_FORCE_INLINE_ void add_narrowphase_test() { narrowphase_tests.increment(); }
+	int get_narrowphase_tests() const { return narrowphase_tests.get(); }
+
+	int get_sleeping_body_count() const;
+
 	void set_active_objects(int p_active_objects) { active_objects = p_active_objects; }
 	int get_active_objects() const { return active_objects; }
 
@@ -204,6 +238,13 @@ public:
 	void set_elapsed_time(ElapsedTime p_time, uint64_t p_msec) { elapsed_time[p_time] = p_msec; }
 	uint64_t get_elapsed_time(ElapsedTime p_time) const { return elapsed_time[p_time]; }
 
+	// Ticks at which each phase of the last step started, used by step traces.
+	void set_elapsed_time_range(ElapsedTime p_time, uint64_t p_begin_usec, uint64_t p_end_usec) {
+		elapsed_time_begin[p_time] = p_begin_usec;
+		elapsed_time[p_time] = p_end_usec - p_begin_usec;
+	}
+	uint64_t get_elapsed_time_begin(ElapsedTime p_time) const { return elapsed_time_begin[p_time]; }
+
 	bool test_body_motion(GodotBody3D *p_body, const PhysicsServer3D::MotionParameters &p_parameters, PhysicsServer3D::MotionResult *r_result);
 
 	GodotSpace3D();
@@ -32,6 +32,7 @@
 
 #include "godot_joint_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
@@ -40,6 +41,8 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define ISLAND_MAX_COLORS 64
+#define ISLAND_MIN_COLOR_SIZE 16
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,6 +115,14 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
+void GodotStep3D::_integrate_velocities(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_velocities(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -158,6 +169,154 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+void GodotStep3D::_color_island(LocalVector<GodotConstraint3D *> &p_constraint_island, ColoredIsland &r_colored_island) {
+	const uint32_t constraint_count = p_constraint_island.size();
+	const uint32_t uncolored = ISLAND_MAX_COLORS;
+
+	uint32_t color_counts[ISLAND_MAX_COLORS + 1] = {};
+
+	// Greedy coloring in island order, which keeps the result independent from the number of threads.
+	// Only dynamic bodies receive impulses while solving, static and kinematic ones can be shared between colors.
+	body_color_masks.clear();
+	constraint_colors.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+
+		uint32_t color = uncolored;
+		if (constraint->get_soft_body_count() == 0) {
+			uint64_t used_colors = 0;
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				const GodotBody3D *body = constraint->get_body_ptr()[i];
+				if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+					const uint64_t *body_colors = body_color_masks.getptr(body);
+					if (body_colors) {
+						used_colors |= *body_colors;
+					}
+				}
+			}
+
+			for (uint32_t i = 0; i < ISLAND_MAX_COLORS; i++) {
+				if (!(used_colors & (uint64_t(1) << i))) {
+					color = i;
+					break;
+				}
+			}
+
+			if (color != uncolored) {
+				for (int i = 0; i < constraint->get_body_count(); i++) {
+					const GodotBody3D *body = constraint->get_body_ptr()[i];
+					if (body->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+						body_color_masks[body] |= uint64_t(1) << color;
+					}
+				}
+			}
+		}
+
+		constraint_colors[constraint_index] = color;
+		color_counts[color]++;
+	}
+
+	// Colors that are too small aren't worth a parallel dispatch, their constraints are solved serially instead.
+	uint32_t color_remap[ISLAND_MAX_COLORS + 1];
+	uint32_t color_count = 0;
+	for (uint32_t i = 0; i < ISLAND_MAX_COLORS; i++) {
+		if (color_counts[i] >= ISLAND_MIN_COLOR_SIZE) {
+			color_remap[i] = color_count++;
+		} else {
+			color_remap[i] = uncolored;
+		}
+	}
+	color_remap[uncolored] = uncolored;
+
+	r_colored_island.color_offsets.resize(color_count + 1);
+	uint32_t offset = 0;
+	for (uint32_t i = 0; i < ISLAND_MAX_COLORS; i++) {
+		if (color_remap[i] != uncolored) {
+			r_colored_island.color_offsets[color_remap[i]] = offset;
+			offset += color_counts[i];
+		}
+	}
+	r_colored_island.color_offsets[color_count] = offset;
+
+	r_colored_island.constraints.resize(offset);
+	r_colored_island.serial_constraints.clear();
+
+	uint32_t color_positions[ISLAND_MAX_COLORS];
+	for (uint32_t i = 0; i < color_count; i++) {
+		color_positions[i] = r_colored_island.color_offsets[i];
+	}
+
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		const uint32_t color = color_remap[constraint_colors[constraint_index]];
+		if (color == uncolored) {
+			r_colored_island.serial_constraints.push_back(p_constraint_island[constraint_index]);
+		} else {
+			r_colored_island.constraints[color_positions[color]++] = p_constraint_island[constraint_index];
+		}
+	}
+
+	// The island is now solved through its colors.
+	p_constraint_island.clear();
+}
+
+void GodotStep3D::_solve_constraint_batch(uint32_t p_constraint_index, GodotConstraint3D **p_constraint_batch) {
+	p_constraint_batch[p_constraint_index]->solve(delta);
+}
+
+void GodotStep3D::_solve_colored_island(ColoredIsland &p_colored_island) {
+	LocalVector<GodotConstraint3D *> &constraints = p_colored_island.constraints;
+	LocalVector<uint32_t> &color_offsets = p_colored_island.color_offsets;
+	LocalVector<GodotConstraint3D *> &serial_constraints = p_colored_island.serial_constraints;
+
+	int current_priority = 1;
+
+	while (!constraints.is_empty() || !serial_constraints.is_empty()) {
+		const uint32_t color_count = color_offsets.size() - 1;
+		for (int i = 0; i < iterations; i++) {
+			// Go through all iterations, constraints of the same color don't depend on each other.
+			for (uint32_t color = 0; color < color_count; color++) {
+				const uint32_t color_size = color_offsets[color + 1] - color_offsets[color];
+				if (color_size == 0) {
+					continue;
+				}
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_constraint_batch, constraints.ptr() + color_offsets[color], color_size, -1, true, SNAME("Physics3DConstraintSolveColor"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			}
+
+			for (GodotConstraint3D *constraint : serial_constraints) {
+				constraint->solve(delta);
+			}
+		}
+
+		// Check priority to keep only higher priority constraints, preserving their colors.
+		++current_priority;
+		uint32_t priority_constraint_count = 0;
+		for (uint32_t color = 0; color < color_count; color++) {
+			const uint32_t color_end = color_offsets[color + 1];
+			const uint32_t color_begin = color_offsets[color];
+			color_offsets[color] = priority_constraint_count;
+			for (uint32_t constraint_index = color_begin; constraint_index < color_end; ++constraint_index) {
+				GodotConstraint3D *constraint = constraints[constraint_index];
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					constraints[priority_constraint_count++] = constraint;
+				}
+			}
+		}
+		color_offsets[color_count] = priority_constraint_count;
+		constraints.resize(priority_constraint_count);
+
+		priority_constraint_count = 0;
+		for (uint32_t constraint_index = 0; constraint_index < serial_constraints.size(); ++constraint_index) {
+			GodotConstraint3D *constraint = serial_constraints[constraint_index];
+			if (constraint->get_priority() >= current_priority) {
+				serial_constraints[priority_constraint_count++] = constraint;
+			}
+		}
+		serial_constraints.resize(priority_constraint_count);
+	}
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -201,13 +360,22 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
+	active_bodies.clear();
 
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
-		active_count++;
+	}
+
+	int active_count = active_bodies.size();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_forces, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateForces"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// Broadphase updates are batched here, the broadphase itself isn't thread-safe.
+	for (GodotBody3D *body : active_bodies) {
+		body->flush_integration();
 	}
 
 	/* UPDATE SOFT BODY MOTION */
@@ -226,7 +394,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time_range(GodotSpace3D::ELAPSED_TIME_INTEGRATE_FORCES, profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -333,23 +501,30 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		sb = sb->next();
 	}
 
+	uint32_t largest_island_size = 0;
+	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+		largest_island_size = MAX(largest_island_size, constraint_islands[island_index].size());
+	}
+
 	p_space->set_island_count((int)island_count);
+	p_space->set_largest_island_size((int)largest_island_size);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time_range(GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS, profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
+	p_space->reset_narrowphase_tests();
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time_range(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -360,6 +535,24 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		_pre_solve_island(constraint_islands[island_index]);
 	}
 
+	/* COLOR LARGE CONSTRAINT ISLANDS */
+
+	uint32_t colored_island_count = 0;
+	if (parallel_island_min_constraints > 0 && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
+			LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_index];
+			if (constraint_island.size() < parallel_island_min_constraints) {
+				continue;
+			}
+
+			++colored_island_count;
+			if (colored_islands.size() < colored_island_count) {
+				colored_islands.resize(colored_island_count);
+			}
+			_color_island(constraint_island, colored_islands[colored_island_count - 1]);
+		}
+	}
+
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
@@ -367,19 +560,34 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
+	// Colored islands were emptied above, they are solved here one by one with their colors running in parallel.
+	for (uint32_t island_index = 0; island_index < colored_island_count; ++island_index) {
+		_solve_colored_island(colored_islands[island_index]);
+	}
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time_range(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
 	/* INTEGRATE VELOCITIES */
 
+	// Bodies may have been woken up since forces were integrated.
+	active_bodies.clear();
+
 	b = body_list->first();
 	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
+		active_bodies.push_back(b->self());
+		b = b->next();
+	}
+
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_integrate_velocities, nullptr, active_bodies.size(), -1, true, SNAME("Physics3DIntegrateVelocities"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	// May remove bodies from the active list, which is why the bodies were collected first.
+	for (GodotBody3D *body : active_bodies) {
+		body->flush_integration();
 	}
 
 	/* SLEEP / WAKE UP ISLANDS */
@@ -398,7 +606,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time_range(GodotSpace3D::ELAPSED_TIME_INTEGRATE_VELOCITIES, profile_begtime, profile_endtime);
 		profile_begtime = profile_endtime;
 	}
 
@@ -412,6 +620,9 @@ GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	active_bodies.reserve(BODY_ISLAND_SIZE_RESERVE);
+
+	parallel_island_min_constraints = GLOBAL_GET("physics/3d/solver/parallel_island_min_constraints");
 }
 
 GodotStep3D::~GodotStep3D() {
@@ -32,6 +32,7 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
@@ -43,12 +44,31 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBody3D *> active_bodies;
+
+	// Large islands are split into batches of constraints that don't share any dynamic body (colors),
+	// so that every color can be solved in parallel while the island is iterated.
+	struct ColoredIsland {
+		LocalVector<GodotConstraint3D *> constraints; // Sorted by color.
+		LocalVector<uint32_t> color_offsets; // Start of each color in `constraints`, with the total count at the end.
+		LocalVector<GodotConstraint3D *> serial_constraints; // Constraints that couldn't be colored, solved after all colors.
+	};
+
+	uint32_t parallel_island_min_constraints = 0;
+	LocalVector<ColoredIsland> colored_islands;
+	HashMap<const GodotBody3D *, uint64_t> body_color_masks;
+	LocalVector<uint32_t> constraint_colors;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
+	void _integrate_velocities(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _color_island(LocalVector<GodotConstraint3D *> &p_constraint_island, ColoredIsland &r_colored_island);
+	void _solve_constraint_batch(uint32_t p_constraint_index, GodotConstraint3D **p_constraint_batch);
+	void _solve_colored_island(ColoredIsland &p_colored_island);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
@@ -0,0 +1,283 @@
+/**************************************************************************/
+/*  test_godot_space_3d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotSpace3D {
+
+// Creates a body with the shape at the position in the space.
+static RID create_body(GodotPhysicsServer3D *p_physics_server, RID p_space, RID p_shape, PhysicsServer3D::BodyMode p_mode, const Vector3 &p_position) {
+	RID body = p_physics_server->body_create();
+	p_physics_server->body_set_mode(body, p_mode);
+	p_physics_server->body_add_shape(body, p_shape, Transform3D(), false);
+	p_physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	p_physics_server->body_set_space(body, p_space);
+	return body;
+}
+
+// Steps a pile of 16x16x4 boxes of one unit on a floor for a second. The boxes touch their neighbors, so the pile is one large island.
+static uint64_t step_box_pile(int p_parallel_island_min_constraints, real_t &r_min_height) {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	// The setting is defined by the server and read when it initializes.
+	const Variant parallel_island_min_constraints = GLOBAL_GET("physics/3d/solver/parallel_island_min_constraints");
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_min_constraints", p_parallel_island_min_constraints);
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	LocalVector<RID> bodies;
+	bodies.push_back(create_body(physics_server, space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Vector3(0, -0.5, 0)));
+	for (int y = 0; y < 4; y++) {
+		for (int z = 0; z < 16; z++) {
+			for (int x = 0; x < 16; x++) {
+				bodies.push_back(create_body(physics_server, space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Vector3(x, 0.5 + y, z)));
+			}
+		}
+	}
+
+	const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 60; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	const uint64_t step_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	r_min_height = Math::INF;
+	for (uint32_t i = 1; i < bodies.size(); i++) {
+		const Transform3D transform = physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		r_min_height = MIN(r_min_height, transform.origin.y);
+	}
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/parallel_island_min_constraints", parallel_island_min_constraints);
+	memdelete(physics_server);
+	return step_usec;
+}
+
+TEST_CASE("[Stress][GodotPhysics3D] Step a large island") {
+	real_t serial_min_height = 0;
+	const uint64_t serial_usec = step_box_pile(0, serial_min_height);
+	real_t parallel_min_height = 0;
+	const uint64_t parallel_usec = step_box_pile(1, parallel_min_height);
+
+	print_verbose(vformat("60 steps of a pile of 1024 boxes: %d usec solving islands on one thread, %d usec solving them in colored batches.", serial_usec, parallel_usec));
+	CHECK(serial_min_height > 0.25);
+	CHECK(parallel_min_height > 0.25);
+}
+
+TEST_CASE("[Stress][GodotPhysics3D] Step many resting contacts") {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// Boxes apart from each other, each one resting on the floor with four contacts. They can't sleep, so every step solves them.
+	LocalVector<RID> bodies;
+	bodies.push_back(create_body(physics_server, space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Vector3(0, -0.5, 0)));
+	for (int z = 0; z < 32; z++) {
+		for (int x = 0; x < 32; x++) {
+			RID body = create_body(physics_server, space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Vector3(x * 2 - 32, 0.5, z * 2 - 32));
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+			bodies.push_back(body);
+		}
+	}
+
+	const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 120; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	const uint64_t step_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+	print_verbose(vformat("120 steps of 1024 boxes resting on a floor: %d usec.", step_usec));
+
+	bool resting = true;
+	for (uint32_t i = 1; i < bodies.size(); i++) {
+		const Transform3D transform = physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		resting = resting && Math::abs(transform.origin.y - 0.5) < 0.05;
+	}
+	CHECK_MESSAGE(resting, "Boxes rest on the floor.");
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[Stress][GodotPhysics3D] Intersect many rays") {
+	constexpr int RAYS = 10000;
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// Boxes on every other cell of a 64x64 grid, with rays cast down at random points.
+	LocalVector<RID> bodies;
+	for (int z = 0; z < 64; z += 2) {
+		for (int x = 0; x < 64; x += 2) {
+			bodies.push_back(create_body(physics_server, space, box_shape, PhysicsServer3D::BODY_MODE_STATIC, Vector3(x + 0.5, 0.5, z + 0.5)));
+		}
+	}
+	physics_server->step(1.0 / 60.0);
+	physics_server->flush_queries();
+
+	Math::seed(0);
+	LocalVector<PhysicsDirectSpaceState3D::RayParameters> ray_parameters;
+	ray_parameters.resize(RAYS);
+	for (PhysicsDirectSpaceState3D::RayParameters &parameters : ray_parameters) {
+		parameters.from = Vector3(Math::randf() * 64, 2, Math::randf() * 64);
+		parameters.to = parameters.from - Vector3(0, 4, 0);
+	}
+
+	PhysicsDirectSpaceState3D *space_state = physics_server->space_get_direct_state(space);
+	REQUIRE(space_state);
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	LocalVector<bool> hits;
+	results.resize(RAYS);
+	hits.resize(RAYS);
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < RAYS; i++) {
+		hits[i] = space_state->intersect_ray(ray_parameters[i], results[i]);
+	}
+	const uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> batch_results;
+	LocalVector<bool> batch_hits;
+	batch_results.resize(RAYS);
+	batch_hits.resize(RAYS);
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	space_state->intersect_rays(ray_parameters.ptr(), RAYS, batch_results.ptr(), batch_hits.ptr());
+	const uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	print_verbose(vformat("%d rays against %d boxes: %d usec one by one, %d usec as a batch.", RAYS, bodies.size(), single_usec, batch_usec));
+	bool match = true;
+	for (int i = 0; i < RAYS; i++) {
+		match = match && hits[i] == batch_hits[i];
+		if (hits[i] && batch_hits[i]) {
+			match = match && results[i].rid == batch_results[i].rid && results[i].position.is_equal_approx(batch_results[i].position);
+		}
+	}
+	CHECK_MESSAGE(match, "Batch found the same hits.");
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[Stress][GodotPhysics3D] Step a few moving bodies among many sleeping ones") {
+	GodotPhysicsServer3D *physics_server = memnew(GodotPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// 4096 sleeping boxes without gravity, with 64 boxes moving right above them.
+	LocalVector<RID> sleeping_bodies;
+	for (int z = 0; z < 64; z++) {
+		for (int x = 0; x < 64; x++) {
+			RID body = create_body(physics_server, space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Vector3(x * 2, 0, z * 2));
+			physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+			physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, true);
+			sleeping_bodies.push_back(body);
+		}
+	}
+	LocalVector<RID> moving_bodies;
+	for (int i = 0; i < 64; i++) {
+		RID body = create_body(physics_server, space, box_shape, PhysicsServer3D::BODY_MODE_RIGID, Vector3(0, 1.5, i * 2));
+		physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_CAN_SLEEP, false);
+		physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(60, 0, 0));
+		moving_bodies.push_back(body);
+	}
+
+	const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 120; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+	const uint64_t step_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+	print_verbose(vformat("120 steps of 64 moving bodies among 4096 sleeping ones: %d usec.", step_usec));
+
+	bool sleeping = true;
+	for (const RID &body : sleeping_bodies) {
+		sleeping = sleeping && bool(physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_SLEEPING));
+	}
+	CHECK_MESSAGE(sleeping, "Untouched bodies kept sleeping.");
+	const Transform3D transform = physics_server->body_get_state(moving_bodies[0], PhysicsServer3D::BODY_STATE_TRANSFORM);
+	CHECK(transform.origin.x > 60);
+
+	for (const RID &body : sleeping_bodies) {
+		physics_server->free(body);
+	}
+	for (const RID &body : moving_bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(box_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+} // namespace TestGodotSpace3D
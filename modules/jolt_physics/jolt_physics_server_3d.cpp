@@ -236,6 +236,20 @@ PhysicsDirectSpaceState3D *JoltPhysicsServer3D::space_get_direct_state(RID p_spa
 	return space->get_direct_state();
 }
 
+PackedByteArray JoltPhysicsServer3D::space_save_state(RID p_space) const {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, PackedByteArray());
+
+	return space->save_state();
+}
+
+bool JoltPhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, false);
+
+	return space->restore_state(p_state);
+}
+
 void JoltPhysicsServer3D::space_set_debug_contacts(RID p_space, int p_max_contacts) {
 #ifdef DEBUG_ENABLED
 	JoltSpace3D *space = space_owner.get_or_null(p_space);
@@ -1624,6 +1638,17 @@ void JoltPhysicsServer3D::step(real_t p_step) {
 		active_space->step((float)p_step);
 
 		job_system->post_step();
+
+		if (tracing) {
+			const RID space_rid = active_space->get_rid();
+			uint64_t phase_begin = active_space->get_step_begin_usec();
+			for (int i = 0; i < JoltSpace3D::STEP_PHASE_MAX; i++) {
+				const uint64_t phase_end = phase_begin + active_space->get_step_phase_usec(JoltSpace3D::StepPhase(i));
+				_add_trace_event(JoltSpace3D::get_step_phase_name(JoltSpace3D::StepPhase(i)), space_rid, phase_begin, phase_end);
+				phase_begin = phase_end;
+			}
+			_add_trace_event("step", space_rid, active_space->get_step_begin_usec(), phase_begin);
+		}
 	}
 }
 
@@ -1658,7 +1683,30 @@ bool JoltPhysicsServer3D::is_flushing_queries() const {
 }
 
 int JoltPhysicsServer3D::get_process_info(ProcessInfo p_process_info) {
-	return 0;
+	int result = 0;
+
+	for (const JoltSpace3D *active_space : active_spaces) {
+		switch (p_process_info) {
+			case INFO_ACTIVE_OBJECTS: {
+				result += active_space->get_active_body_count();
+			} break;
+			case INFO_COLLISION_PAIRS: {
+				result += active_space->get_collision_pairs();
+			} break;
+			case INFO_ISLAND_COUNT: {
+				// Jolt doesn't keep its islands around after the step.
+			} break;
+		}
+	}
+
+	return result;
+}
+
+Dictionary JoltPhysicsServer3D::space_get_profiling_info(RID p_space) const {
+	const JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Dictionary());
+
+	return space->get_profiling_info();
 }
 
 void JoltPhysicsServer3D::free_space(JoltSpace3D *p_space) {
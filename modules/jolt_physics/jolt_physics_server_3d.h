@@ -158,6 +158,9 @@ public:
 
 	virtual PhysicsDirectSpaceState3D *space_get_direct_state(RID p_space) override;
 
+	virtual PackedByteArray space_save_state(RID p_space) const override;
+	virtual bool space_restore_state(RID p_space, const PackedByteArray &p_state) override;
+
 	virtual void space_set_debug_contacts(RID p_space, int p_max_contacts) override;
 	virtual PackedVector3Array space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
@@ -428,6 +431,8 @@ public:
 
 	virtual int get_process_info(PhysicsServer3D::ProcessInfo p_process_info) override;
 
+	virtual Dictionary space_get_profiling_info(RID p_space) const override;
+
 	bool is_on_separate_thread() const { return on_separate_thread; }
 	bool is_active() const { return active; }
 
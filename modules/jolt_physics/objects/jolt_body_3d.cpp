@@ -1105,6 +1105,12 @@ void JoltBody3D::call_queries() {
 	}
 }
 
+void JoltBody3D::restored_state() {
+	if (_should_call_queries()) {
+		_enqueue_call_queries();
+	}
+}
+
 void JoltBody3D::pre_step(float p_step, JPH::Body &p_jolt_body) {
 	JoltObject3D::pre_step(p_step, p_jolt_body);
 
@@ -243,6 +243,8 @@ public:
 	void remove_joint(JoltJoint3D *p_joint);
 
 	void call_queries();
+	// Queues the state synchronization after the space state was restored, the next step may not touch this body.
+	void restored_state();
 
 	virtual void pre_step(float p_step, JPH::Body &p_jolt_body) override;
 
@@ -37,10 +37,13 @@
 #include "../objects/jolt_soft_body_3d.h"
 #include "jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 #include "Jolt/Physics/Collision/EstimateCollisionResponse.h"
 #include "Jolt/Physics/SoftBody/SoftBodyManifold.h"
 
 void JoltContactListener3D::OnContactAdded(const JPH::Body &p_body1, const JPH::Body &p_body2, const JPH::ContactManifold &p_manifold, JPH::ContactSettings &p_settings) {
+	_count_manifold();
 	_try_override_collision_response(p_body1, p_body2, p_settings);
 	_try_apply_surface_velocities(p_body1, p_body2, p_settings);
 	_try_add_contacts(p_body1, p_body2, p_manifold, p_settings);
@@ -52,6 +55,7 @@ void JoltContactListener3D::OnContactAdded(const JPH::Body &p_body1, const JPH::
 }
 
 void JoltContactListener3D::OnContactPersisted(const JPH::Body &p_body1, const JPH::Body &p_body2, const JPH::ContactManifold &p_manifold, JPH::ContactSettings &p_settings) {
+	_count_manifold();
 	_try_override_collision_response(p_body1, p_body2, p_settings);
 	_try_apply_surface_velocities(p_body1, p_body2, p_settings);
 	_try_add_contacts(p_body1, p_body2, p_manifold, p_settings);
@@ -63,13 +67,8 @@ void JoltContactListener3D::OnContactPersisted(const JPH::Body &p_body1, const J
 }
 
 void JoltContactListener3D::OnContactRemoved(const JPH::SubShapeIDPair &p_shape_pair) {
-	if (_try_remove_contacts(p_shape_pair)) {
-		return;
-	}
-
-	if (_try_remove_area_overlap(p_shape_pair)) {
-		return;
-	}
+	// Reported contacts only live for one step, so there's nothing to remove for them.
+	_try_remove_area_overlap(p_shape_pair);
 }
 
 JPH::SoftBodyValidateResult JoltContactListener3D::OnSoftBodyContactValidate(const JPH::Body &p_soft_body, const JPH::Body &p_other_body, JPH::SoftBodyContactSettings &p_settings) {
@@ -174,6 +173,20 @@ bool JoltContactListener3D::_try_apply_surface_velocities(const JPH::Body &p_jol
 	return true;
 }
 
+JoltContactListener3D::ContactBuffer *JoltContactListener3D::_get_contact_buffer() {
+	// Jolt runs its jobs either on the worker threads or on the thread stepping the space, which gets the first buffer.
+	const int thread_index = WorkerThreadPool::get_singleton()->get_thread_index() + 1;
+	ERR_FAIL_INDEX_V(thread_index, (int)contact_buffers.size(), nullptr);
+	return &contact_buffers[thread_index];
+}
+
+void JoltContactListener3D::_count_manifold() {
+	ContactBuffer *buffer = _get_contact_buffer();
+	if (buffer != nullptr) {
+		buffer->manifold_count++;
+	}
+}
+
 bool JoltContactListener3D::_try_add_contacts(const JPH::Body &p_jolt_body1, const JPH::Body &p_jolt_body2, const JPH::ContactManifold &p_manifold, JPH::ContactSettings &p_settings) {
 	if (p_jolt_body1.IsSensor() || p_jolt_body2.IsSensor()) {
 		return false;
@@ -186,18 +199,22 @@ bool JoltContactListener3D::_try_add_contacts(const JPH::Body &p_jolt_body1, con
 		return false;
 	}
 
-	const JPH::SubShapeIDPair shape_pair(p_jolt_body1.GetID(), p_manifold.mSubShapeID1, p_jolt_body2.GetID(), p_manifold.mSubShapeID2);
-
-	Manifold &manifold = [&]() -> Manifold & {
-		const MutexLock write_lock(write_mutex);
-		return manifolds_by_shape_pair[shape_pair];
-	}();
+	ContactBuffer *buffer_ptr = _get_contact_buffer();
+	ERR_FAIL_NULL_V(buffer_ptr, false);
+	ContactBuffer &buffer = *buffer_ptr;
 
 	const JPH::uint contact_count = p_manifold.mRelativeContactPointsOn1.size();
 
-	manifold.contacts1.reserve((uint32_t)contact_count);
-	manifold.contacts2.reserve((uint32_t)contact_count);
+	Manifold manifold;
+	manifold.shape_pair = JPH::SubShapeIDPair(p_jolt_body1.GetID(), p_manifold.mSubShapeID1, p_jolt_body2.GetID(), p_manifold.mSubShapeID2);
 	manifold.depth = p_manifold.mPenetrationDepth;
+	manifold.contacts_offset = buffer.contacts.size();
+	manifold.contact_count = (uint32_t)contact_count;
+	buffer.manifolds.push_back(manifold);
+
+	buffer.contacts.resize(manifold.contacts_offset + manifold.contact_count * 2);
+	Contact *contacts1 = buffer.contacts.ptr() + manifold.contacts_offset;
+	Contact *contacts2 = contacts1 + manifold.contact_count;
 
 	JPH::CollisionEstimationResult collision;
 	JPH::EstimateCollisionResponse(p_jolt_body1, p_jolt_body2, p_manifold, collision, p_settings.mCombinedFriction, p_settings.mCombinedRestitution, JoltProjectSettings::bounce_velocity_threshold, 5);
@@ -219,23 +236,21 @@ bool JoltContactListener3D::_try_add_contacts(const JPH::Body &p_jolt_body1, con
 		const JPH::Vec3 friction_impulse2 = collision.mTangent2 * impulse.mFrictionImpulse2;
 		const JPH::Vec3 combined_impulse = contact_impulse + friction_impulse1 + friction_impulse2;
 
-		Contact contact1;
+		Contact &contact1 = contacts1[i];
 		contact1.point_self = to_godot(world_point1);
 		contact1.point_other = to_godot(world_point2);
 		contact1.normal = to_godot(-p_manifold.mWorldSpaceNormal);
 		contact1.velocity_self = to_godot(velocity1);
 		contact1.velocity_other = to_godot(velocity2);
 		contact1.impulse = to_godot(-combined_impulse);
-		manifold.contacts1.push_back(contact1);
 
-		Contact contact2;
+		Contact &contact2 = contacts2[i];
 		contact2.point_self = to_godot(world_point2);
 		contact2.point_other = to_godot(world_point1);
 		contact2.normal = to_godot(p_manifold.mWorldSpaceNormal);
 		contact2.velocity_self = to_godot(velocity2);
 		contact2.velocity_other = to_godot(velocity1);
 		contact2.impulse = to_godot(combined_impulse);
-		manifold.contacts2.push_back(contact2);
 	}
 
 	return true;
@@ -294,12 +309,6 @@ bool JoltContactListener3D::_try_evaluate_area_overlap(const JPH::Body &p_body1,
 	return true;
 }
 
-bool JoltContactListener3D::_try_remove_contacts(const JPH::SubShapeIDPair &p_shape_pair) {
-	const MutexLock write_lock(write_mutex);
-
-	return manifolds_by_shape_pair.erase(p_shape_pair);
-}
-
 bool JoltContactListener3D::_try_remove_area_overlap(const JPH::SubShapeIDPair &p_shape_pair) {
 	const JPH::SubShapeIDPair swapped_shape_pair(p_shape_pair.GetBody2ID(), p_shape_pair.GetSubShapeID2(), p_shape_pair.GetBody1ID(), p_shape_pair.GetSubShapeID1());
 
@@ -409,29 +418,39 @@ bool JoltContactListener3D::_try_add_debug_contacts(const JPH::Body &p_soft_body
 #endif
 
 void JoltContactListener3D::_flush_contacts() {
-	for (KeyValue<JPH::SubShapeIDPair, Manifold> &E : manifolds_by_shape_pair) {
-		const JPH::SubShapeIDPair &shape_pair = E.key;
-		Manifold &manifold = E.value;
+	collision_pairs = 0;
 
-		JoltBody3D *body1 = space->try_get_body(shape_pair.GetBody1ID());
-		ERR_FAIL_NULL(body1);
+	for (ContactBuffer &buffer : contact_buffers) {
+		collision_pairs += buffer.manifold_count;
+		buffer.manifold_count = 0;
 
-		JoltBody3D *body2 = space->try_get_body(shape_pair.GetBody2ID());
-		ERR_FAIL_NULL(body2);
+		for (const Manifold &manifold : buffer.manifolds) {
+			const JPH::SubShapeIDPair &shape_pair = manifold.shape_pair;
 
-		const int shape_index1 = body1->find_shape_index(shape_pair.GetSubShapeID1());
-		const int shape_index2 = body2->find_shape_index(shape_pair.GetSubShapeID2());
+			JoltBody3D *body1 = space->try_get_body(shape_pair.GetBody1ID());
+			JoltBody3D *body2 = space->try_get_body(shape_pair.GetBody2ID());
+			ERR_CONTINUE(body1 == nullptr || body2 == nullptr);
 
-		for (const Contact &contact : manifold.contacts1) {
-			body1->add_contact(body2, manifold.depth, shape_index1, shape_index2, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
-		}
+			const int shape_index1 = body1->find_shape_index(shape_pair.GetSubShapeID1());
+			const int shape_index2 = body2->find_shape_index(shape_pair.GetSubShapeID2());
+
+			const Contact *contacts1 = buffer.contacts.ptr() + manifold.contacts_offset;
+			const Contact *contacts2 = contacts1 + manifold.contact_count;
 
-		for (const Contact &contact : manifold.contacts2) {
-			body2->add_contact(body1, manifold.depth, shape_index2, shape_index1, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
+			for (uint32_t i = 0; i < manifold.contact_count; ++i) {
+				const Contact &contact = contacts1[i];
+				body1->add_contact(body2, manifold.depth, shape_index1, shape_index2, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
+			}
+
+			for (uint32_t i = 0; i < manifold.contact_count; ++i) {
+				const Contact &contact = contacts2[i];
+				body2->add_contact(body1, manifold.depth, shape_index2, shape_index1, contact.normal, contact.point_self, contact.point_other, contact.velocity_self, contact.velocity_other, contact.impulse);
+			}
 		}
 
-		manifold.contacts1.clear();
-		manifold.contacts2.clear();
+		// Keep the memory around for the next step.
+		buffer.manifolds.clear();
+		buffer.contacts.clear();
 	}
 }
 
@@ -498,6 +517,11 @@ void JoltContactListener3D::_flush_area_exits() {
 	area_exits.clear();
 }
 
+JoltContactListener3D::JoltContactListener3D(JoltSpace3D *p_space) :
+		space(p_space) {
+	contact_buffers.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+}
+
 void JoltContactListener3D::pre_step() {
 #ifdef DEBUG_ENABLED
 	debug_contact_count = 0;
@@ -31,7 +31,6 @@
 #pragma once
 
 #include "core/os/mutex.h"
-#include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/local_vector.h"
@@ -75,15 +74,23 @@ class JoltContactListener3D final
 		Vector3 impulse;
 	};
 
-	typedef LocalVector<Contact> Contacts;
-
 	struct Manifold {
-		Contacts contacts1;
-		Contacts contacts2;
+		JPH::SubShapeIDPair shape_pair;
 		float depth = 0.0f;
+		// The contacts of body 1 are at `[contacts_offset, contacts_offset + contact_count)`, followed by the ones of body 2.
+		uint32_t contacts_offset = 0;
+		uint32_t contact_count = 0;
+	};
+
+	// Contacts are gathered by each thread without locking, and merged after the step.
+	struct alignas(64) ContactBuffer {
+		LocalVector<Manifold> manifolds;
+		LocalVector<Contact> contacts;
+		uint32_t manifold_count = 0;
 	};
 
-	HashMap<JPH::SubShapeIDPair, Manifold, ShapePairHasher> manifolds_by_shape_pair;
+	LocalVector<ContactBuffer> contact_buffers;
+	int collision_pairs = 0;
 	HashSet<JPH::SubShapeIDPair, ShapePairHasher> area_overlaps;
 	HashSet<JPH::SubShapeIDPair, ShapePairHasher> area_enters;
 	HashSet<JPH::SubShapeIDPair, ShapePairHasher> area_exits;
@@ -108,9 +115,11 @@ class JoltContactListener3D final
 	bool _try_override_collision_response(const JPH::Body &p_jolt_body1, const JPH::Body &p_jolt_body2, JPH::ContactSettings &p_settings);
 	bool _try_override_collision_response(const JPH::Body &p_jolt_soft_body, const JPH::Body &p_jolt_other_body, JPH::SoftBodyContactSettings &p_settings);
 	bool _try_apply_surface_velocities(const JPH::Body &p_jolt_body1, const JPH::Body &p_jolt_body2, JPH::ContactSettings &p_settings);
+	ContactBuffer *_get_contact_buffer();
+	void _count_manifold();
+
 	bool _try_add_contacts(const JPH::Body &p_jolt_body1, const JPH::Body &p_jolt_body2, const JPH::ContactManifold &p_manifold, JPH::ContactSettings &p_settings);
 	bool _try_evaluate_area_overlap(const JPH::Body &p_body1, const JPH::Body &p_body2, const JPH::ContactManifold &p_manifold);
-	bool _try_remove_contacts(const JPH::SubShapeIDPair &p_shape_pair);
 	bool _try_remove_area_overlap(const JPH::SubShapeIDPair &p_shape_pair);
 
 #ifdef DEBUG_ENABLED
@@ -123,12 +132,13 @@ class JoltContactListener3D final
 	void _flush_area_exits();
 
 public:
-	explicit JoltContactListener3D(JoltSpace3D *p_space) :
-			space(p_space) {}
+	explicit JoltContactListener3D(JoltSpace3D *p_space);
 
 	void pre_step();
 	void post_step();
 
+	int get_collision_pairs() const { return collision_pairs; }
+
 #ifdef DEBUG_ENABLED
 	const PackedVector3Array &get_debug_contacts() const { return debug_contacts; }
 	int get_debug_contact_count() const { return debug_contact_count.load(std::memory_order_acquire); }
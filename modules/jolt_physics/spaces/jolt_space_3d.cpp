@@ -33,6 +33,7 @@
 #include "../joints/jolt_joint_3d.h"
 #include "../jolt_physics_server_3d.h"
 #include "../jolt_project_settings.h"
+#include "../misc/jolt_state_recorder.h"
 #include "../misc/jolt_stream_wrappers.h"
 #include "../objects/jolt_area_3d.h"
 #include "../objects/jolt_body_3d.h"
@@ -177,10 +178,18 @@ void JoltSpace3D::step(float p_step) {
 	stepping = true;
 	last_step = p_step;
 
+	step_begin_usec = Time::get_singleton()->get_ticks_usec();
+
 	_pre_step(p_step);
 
+	const uint64_t update_begin_usec = Time::get_singleton()->get_ticks_usec();
+	step_phase_usec[STEP_PHASE_PRE_STEP] = update_begin_usec - step_begin_usec;
+
 	const JPH::EPhysicsUpdateError update_error = physics_system->Update(p_step, 1, temp_allocator, job_system);
 
+	const uint64_t post_step_begin_usec = Time::get_singleton()->get_ticks_usec();
+	step_phase_usec[STEP_PHASE_UPDATE] = post_step_begin_usec - update_begin_usec;
+
 	if ((update_error & JPH::EPhysicsUpdateError::ManifoldCacheFull) != JPH::EPhysicsUpdateError::None) {
 		WARN_PRINT_ONCE(vformat("Jolt Physics manifold cache exceeded capacity and contacts were ignored. "
 								"Consider increasing maximum number of contact constraints in project settings. "
@@ -204,9 +213,81 @@ void JoltSpace3D::step(float p_step) {
 
 	_post_step(p_step);
 
+	step_phase_usec[STEP_PHASE_POST_STEP] = Time::get_singleton()->get_ticks_usec() - post_step_begin_usec;
+
 	stepping = false;
 }
 
+const char *JoltSpace3D::get_step_phase_name(StepPhase p_phase) {
+	static const char *names[STEP_PHASE_MAX] = {
+		"pre_step",
+		"update",
+		"post_step"
+	};
+
+	return names[p_phase];
+}
+
+int JoltSpace3D::get_active_body_count() const {
+	return (int)physics_system->GetNumActiveBodies(JPH::EBodyType::RigidBody) + (int)physics_system->GetNumActiveBodies(JPH::EBodyType::SoftBody);
+}
+
+int JoltSpace3D::get_collision_pairs() const {
+	return contact_listener->get_collision_pairs();
+}
+
+Dictionary JoltSpace3D::get_profiling_info() const {
+	const JPH::BodyManager::BodyStats stats = physics_system->GetBodyStats();
+	const JPH::PhysicsSettings &settings = physics_system->GetPhysicsSettings();
+
+	Dictionary info;
+	info["active_objects"] = get_active_body_count();
+	info["collision_pairs"] = get_collision_pairs();
+	info["solver_iterations"] = (int)(settings.mNumVelocitySteps + settings.mNumPositionSteps);
+	info["sleeping_bodies"] = (int)((stats.mNumBodiesDynamic - stats.mNumActiveBodiesDynamic) + (stats.mNumSoftBodies - stats.mNumActiveSoftBodies));
+
+	Dictionary phase_times;
+	for (int i = 0; i < STEP_PHASE_MAX; i++) {
+		phase_times[get_step_phase_name(StepPhase(i))] = step_phase_usec[i];
+	}
+	info["phase_times_usec"] = phase_times;
+
+	return info;
+}
+
+PackedByteArray JoltSpace3D::save_state() {
+	ERR_FAIL_COND_V_MSG(stepping, PackedByteArray(), "Space state can't be saved while the space is being stepped.");
+
+	flush_pending_objects();
+
+	JoltStateRecorder recorder;
+	physics_system->SaveState(recorder);
+
+	return recorder.get_data();
+}
+
+bool JoltSpace3D::restore_state(const PackedByteArray &p_state) {
+	ERR_FAIL_COND_V_MSG(stepping, false, "Space state can't be restored while the space is being stepped.");
+
+	flush_pending_objects();
+
+	JoltStateRecorder recorder(p_state);
+	ERR_FAIL_COND_V_MSG(!physics_system->RestoreState(recorder), false, "Failed to restore space state. The space must contain the same bodies and joints as when the state was saved.");
+
+	// Sleeping bodies aren't touched by the next step, so every body reports its restored state on the next query flush.
+	JPH::BodyIDVector body_ids;
+	physics_system->GetBodies(body_ids);
+	for (const JPH::BodyID &body_id : body_ids) {
+		JoltObject3D *object = try_get_object(body_id);
+		JoltBody3D *body = object != nullptr ? object->as_body() : nullptr;
+		if (body != nullptr) {
+			body->restored_state();
+		}
+	}
+
+	return true;
+}
+
 void JoltSpace3D::call_queries() {
 	while (body_call_queries_list.first()) {
 		JoltBody3D *body = body_call_queries_list.first()->self();
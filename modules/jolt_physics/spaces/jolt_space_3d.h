@@ -53,6 +53,15 @@ class JoltShapedObject3D;
 class JoltSoftBody3D;
 
 class JoltSpace3D {
+public:
+	enum StepPhase {
+		STEP_PHASE_PRE_STEP,
+		STEP_PHASE_UPDATE,
+		STEP_PHASE_POST_STEP,
+		STEP_PHASE_MAX
+	};
+
+private:
 	Mutex pending_objects_mutex;
 
 	SelfList<JoltBody3D>::List body_call_queries_list;
@@ -75,6 +84,9 @@ class JoltSpace3D {
 
 	float last_step = 0.0f;
 
+	uint64_t step_begin_usec = 0;
+	uint64_t step_phase_usec[STEP_PHASE_MAX] = {};
+
 	bool active = false;
 	bool stepping = false;
 
@@ -89,6 +101,9 @@ public:
 
 	void call_queries();
 
+	PackedByteArray save_state();
+	bool restore_state(const PackedByteArray &p_state);
+
 	RID get_rid() const { return rid; }
 	void set_rid(const RID &p_rid) { rid = p_rid; }
 
@@ -128,6 +143,14 @@ public:
 
 	float get_last_step() const { return last_step; }
 
+	static const char *get_step_phase_name(StepPhase p_phase);
+	uint64_t get_step_begin_usec() const { return step_begin_usec; }
+	uint64_t get_step_phase_usec(StepPhase p_phase) const { return step_phase_usec[p_phase]; }
+
+	int get_active_body_count() const;
+	int get_collision_pairs() const;
+	Dictionary get_profiling_info() const;
+
 	JPH::Body *add_object(const JoltObject3D &p_object, const JPH::BodyCreationSettings &p_settings, bool p_sleeping = false);
 	JPH::Body *add_object(const JoltObject3D &p_object, const JPH::SoftBodyCreationSettings &p_settings, bool p_sleeping = false);
 	void remove_object(const JPH::BodyID &p_jolt_id);
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  test_jolt_space_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "../jolt_physics_server_3d.h"
+
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestJoltSpace3D {
+
+class StateSyncMock : public Object {
+	GDCLASS(StateSyncMock, Object);
+
+public:
+	void sync(PhysicsDirectBodyState3D *p_state) {
+		sync_calls++;
+		transform = p_state->get_transform();
+	}
+
+	int sync_calls = 0;
+	Transform3D transform;
+};
+
+TEST_CASE("[JoltPhysics] Restoring the space state should sync sleeping bodies") {
+	JoltPhysicsServer3D *physics_server = memnew(JoltPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+
+	RID shape = physics_server->sphere_shape_create();
+	physics_server->shape_set_data(shape, 0.5);
+
+	StateSyncMock mock;
+	RID body = physics_server->body_create();
+	physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+	physics_server->body_set_param(body, PhysicsServer3D::BODY_PARAM_GRAVITY_SCALE, 0.0);
+	physics_server->body_add_shape(body, shape, Transform3D(), false);
+	physics_server->body_set_space(body, space);
+	physics_server->body_set_state_sync_callback(body, callable_mp(&mock, &StateSyncMock::sync));
+	physics_server->step(1.0 / 60.0);
+
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_SLEEPING, true);
+	const PackedByteArray state = physics_server->space_save_state(space);
+	REQUIRE_FALSE(state.is_empty());
+
+	physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 5, 0)));
+	physics_server->flush_queries();
+	mock.sync_calls = 0;
+
+	// No step runs in between, so only the restore can queue the state sync.
+	CHECK(physics_server->space_restore_state(space, state));
+	physics_server->flush_queries();
+	CHECK_EQ(mock.sync_calls, 1);
+	CHECK(mock.transform.origin.is_equal_approx(Vector3()));
+
+	physics_server->free(body);
+	physics_server->free(shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+TEST_CASE("[Stress][JoltPhysics] Save and restore the state of a large space") {
+	JoltPhysicsServer3D *physics_server = memnew(JoltPhysicsServer3D(false));
+	physics_server->init();
+
+	RID space = physics_server->space_create();
+	physics_server->space_set_active(space, true);
+	RID floor_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(floor_shape, Vector3(50, 0.5, 50));
+	RID box_shape = physics_server->box_shape_create();
+	physics_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// A pile of 16x16x4 boxes falling onto a floor.
+	LocalVector<RID> bodies;
+	RID floor = physics_server->body_create();
+	physics_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	physics_server->body_add_shape(floor, floor_shape, Transform3D(), false);
+	physics_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+	physics_server->body_set_space(floor, space);
+	for (int y = 0; y < 4; y++) {
+		for (int z = 0; z < 16; z++) {
+			for (int x = 0; x < 16; x++) {
+				RID body = physics_server->body_create();
+				physics_server->body_set_mode(body, PhysicsServer3D::BODY_MODE_RIGID);
+				physics_server->body_add_shape(body, box_shape, Transform3D(), false);
+				physics_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(x * 1.1, 1 + y * 1.1, z * 1.1)));
+				physics_server->body_set_space(body, space);
+				bodies.push_back(body);
+			}
+		}
+	}
+	for (int i = 0; i < 30; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	LocalVector<Vector3> saved_positions;
+	for (const RID &body : bodies) {
+		const Transform3D transform = physics_server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		saved_positions.push_back(transform.origin);
+	}
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	const PackedByteArray state = physics_server->space_save_state(space);
+	const uint64_t save_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+	REQUIRE_FALSE(state.is_empty());
+
+	for (int i = 0; i < 30; i++) {
+		physics_server->step(1.0 / 60.0);
+		physics_server->flush_queries();
+	}
+
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	CHECK(physics_server->space_restore_state(space, state));
+	const uint64_t restore_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+	physics_server->flush_queries();
+
+	print_verbose(vformat("Space state of %d bodies: %d bytes, %d usec to save, %d usec to restore.", bodies.size() + 1, state.size(), save_usec, restore_usec));
+	bool match = true;
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		const Transform3D transform = physics_server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		match = match && transform.origin.is_equal_approx(saved_positions[i]);
+	}
+	CHECK_MESSAGE(match, "Restored the saved positions.");
+
+	for (const RID &body : bodies) {
+		physics_server->free(body);
+	}
+	physics_server->free(floor);
+	physics_server->free(box_shape);
+	physics_server->free(floor_shape);
+	physics_server->free(space);
+	physics_server->finish();
+	memdelete(physics_server);
+}
+
+} // namespace TestJoltSpace3D
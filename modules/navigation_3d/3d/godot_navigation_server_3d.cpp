@@ -30,6 +30,7 @@
 
 #include "godot_navigation_server_3d.h"
 
+#include "core/config/project_settings.h"
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
 
@@ -80,7 +81,9 @@ using namespace NavigationUtilities;
 	}                                                                 \
 	void GodotNavigationServer3D::MERGE(_cmd_, F_NAME)(T_0 D_0, T_1 D_1)
 
-GodotNavigationServer3D::GodotNavigationServer3D() {}
+GodotNavigationServer3D::GodotNavigationServer3D() {
+	path_query_batch_time_budget_usec = uint64_t(double(GLOBAL_GET("navigation/3d/path_query_batch_time_budget_msec")) * 1000.0);
+}
 
 GodotNavigationServer3D::~GodotNavigationServer3D() {
 	flush_queries();
@@ -234,6 +237,34 @@ real_t GodotNavigationServer3D::map_get_link_connection_radius(RID p_map) const
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	const NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
+COMMAND_2(map_set_hierarchical_cluster_size, RID, p_map, real_t, p_cluster_size) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_hierarchical_cluster_size(p_cluster_size);
+}
+
+real_t GodotNavigationServer3D::map_get_hierarchical_cluster_size(RID p_map) const {
+	const NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, 0);
+
+	return map->get_hierarchical_cluster_size();
+}
+
 Vector<Vector3> GodotNavigationServer3D::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) {
 	const NavMap3D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector<Vector3>());
@@ -1403,6 +1434,12 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 	int _new_pm_obstacle_count = 0;
+	int _new_pm_sync_usec = 0;
+	int _new_pm_sync_edge_connection_usec = 0;
+	int _new_pm_sync_link_connection_usec = 0;
+	int _new_pm_sync_region_rebuild_count = 0;
+	int _new_pm_sync_edge_merge_count = 0;
+	int _new_pm_sync_link_rebuild_count = 0;
 
 	MutexLock lock(operations_mutex);
 	for (uint32_t i(0); i < active_maps.size(); i++) {
@@ -1419,6 +1456,12 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
 		_new_pm_obstacle_count += active_maps[i]->get_pm_obstacle_count();
+		_new_pm_sync_usec += active_maps[i]->get_pm_sync_usec();
+		_new_pm_sync_edge_connection_usec += active_maps[i]->get_pm_sync_edge_connection_usec();
+		_new_pm_sync_link_connection_usec += active_maps[i]->get_pm_sync_link_connection_usec();
+		_new_pm_sync_region_rebuild_count += active_maps[i]->get_pm_sync_region_rebuild_count();
+		_new_pm_sync_edge_merge_count += active_maps[i]->get_pm_sync_edge_merge_count();
+		_new_pm_sync_link_rebuild_count += active_maps[i]->get_pm_sync_link_rebuild_count();
 	}
 
 	pm_region_count = _new_pm_region_count;
@@ -1430,6 +1473,28 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+	pm_sync_usec = _new_pm_sync_usec;
+	pm_sync_edge_connection_usec = _new_pm_sync_edge_connection_usec;
+	pm_sync_link_connection_usec = _new_pm_sync_link_connection_usec;
+	pm_sync_region_rebuild_count = _new_pm_sync_region_rebuild_count;
+	pm_sync_edge_merge_count = _new_pm_sync_edge_merge_count;
+	pm_sync_link_rebuild_count = _new_pm_sync_link_rebuild_count;
+
+	_process_path_query_batches();
+}
+
+void GodotNavigationServer3D::_process_path_query_batches() {
+	const uint64_t deadline_usec = path_query_batch_time_budget_usec > 0 ? OS::get_singleton()->get_ticks_usec() + path_query_batch_time_budget_usec : 0;
+
+	LocalVector<NavMeshQueries3D::PathQueryBatch3D *> finished_batches;
+	for (NavMap3D *map : active_maps) {
+		map->process_path_query_batches(deadline_usec, finished_batches);
+	}
+
+	for (NavMeshQueries3D::PathQueryBatch3D *batch : finished_batches) {
+		batch->callback.call(NavMeshQueries3D::path_query_batch_get_result(*batch));
+		memdelete(batch);
+	}
 }
 
 void GodotNavigationServer3D::init() {
@@ -1457,6 +1522,28 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+Dictionary GodotNavigationServer3D::query_paths(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, const PackedVector3Array &p_start_positions, const PackedVector3Array &p_target_positions, const Callable &p_callback) {
+	ERR_FAIL_COND_V(p_query_parameters.is_null(), Dictionary());
+	ERR_FAIL_COND_V_MSG(p_start_positions.size() != p_target_positions.size(), Dictionary(), "The start and target position arrays must have the same size.");
+
+	NavMap3D *map = map_owner.get_or_null(p_query_parameters->get_map());
+	ERR_FAIL_NULL_V(map, Dictionary());
+
+	if (p_callback.is_valid()) {
+		NavMeshQueries3D::PathQueryBatch3D *batch = memnew(NavMeshQueries3D::PathQueryBatch3D);
+		NavMeshQueries3D::path_query_batch_setup(*batch, p_query_parameters, p_start_positions, p_target_positions);
+		batch->callback = p_callback;
+		map->add_path_query_batch(batch);
+		return Dictionary();
+	}
+
+	NavMeshQueries3D::PathQueryBatch3D batch;
+	NavMeshQueries3D::path_query_batch_setup(batch, p_query_parameters, p_start_positions, p_target_positions);
+	map->query_path_batch(batch, 0);
+
+	return NavMeshQueries3D::path_query_batch_get_result(batch);
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -1544,6 +1631,24 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_OBSTACLE_COUNT: {
 			return pm_obstacle_count;
 		} break;
+		case INFO_SYNC_USEC: {
+			return pm_sync_usec;
+		} break;
+		case INFO_SYNC_EDGE_CONNECTION_USEC: {
+			return pm_sync_edge_connection_usec;
+		} break;
+		case INFO_SYNC_LINK_CONNECTION_USEC: {
+			return pm_sync_link_connection_usec;
+		} break;
+		case INFO_SYNC_REGION_REBUILD_COUNT: {
+			return pm_sync_region_rebuild_count;
+		} break;
+		case INFO_SYNC_EDGE_MERGE_COUNT: {
+			return pm_sync_edge_merge_count;
+		} break;
+		case INFO_SYNC_LINK_REBUILD_COUNT: {
+			return pm_sync_link_rebuild_count;
+		} break;
 	}
 
 	return 0;
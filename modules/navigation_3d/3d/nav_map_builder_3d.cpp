@@ -36,6 +36,8 @@
 #include "nav_map_iteration_3d.h"
 #include "nav_region_iteration_3d.h"
 
+#include "core/os/os.h"
+
 using namespace Nav3D;
 
 PointKey NavMapBuilder3D::get_point_key(const Vector3 &p_pos, const Vector3 &p_cell_size) {
@@ -59,6 +61,11 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 	performance_data.pm_edge_merge_count = 0;
 	performance_data.pm_edge_connection_count = 0;
 	performance_data.pm_edge_free_count = 0;
+	performance_data.pm_sync_region_rebuild_count = 0;
+	performance_data.pm_sync_edge_merge_count = 0;
+	performance_data.pm_sync_link_rebuild_count = 0;
+
+	const uint64_t build_start_usec = OS::get_singleton()->get_ticks_usec();
 
 	_build_step_gather_region_polygons(r_build);
 
@@ -68,9 +75,24 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_edge_connection_margin_connections(r_build);
 
+	const uint64_t edge_connections_end_usec = OS::get_singleton()->get_ticks_usec();
+
 	_build_step_navlink_connections(r_build);
 
+	const uint64_t link_connections_end_usec = OS::get_singleton()->get_ticks_usec();
+
+	_build_step_cluster_graph(r_build);
+
 	_build_update_map_iteration(r_build);
+
+	// Release the removed regions now that nothing refers to their polygons anymore.
+	r_build.iter_added_regions.clear();
+	r_build.iter_removed_regions.clear();
+	r_build.iter_rebuilt_regions.clear();
+
+	performance_data.pm_sync_edge_connection_usec = edge_connections_end_usec - build_start_usec;
+	performance_data.pm_sync_link_connection_usec = link_connections_end_usec - edge_connections_end_usec;
+	performance_data.pm_sync_usec = OS::get_singleton()->get_ticks_usec() - build_start_usec;
 }
 
 void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D &r_build) {
@@ -85,42 +107,94 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 	// Remove regions connections.
 	region_external_connections.clear();
 
-	// Copy all region polygons in the map.
+	// Count all region polygons in the map.
 	int polygon_count = 0;
 	for (const Ref<NavRegionIteration3D> &region : regions) {
-		const uint32_t polygons_size = region->navmesh_polygons.size();
-		polygon_count += polygons_size;
+		polygon_count += region->navmesh_polygons.size();
 
 		region_external_connections[region.ptr()] = LocalVector<Connection>();
-		map_iteration->navbases_polygons_external_connections[region.ptr()] = LocalVector<LocalVector<Connection>>();
-		map_iteration->navbases_polygons_external_connections[region.ptr()].resize(polygons_size);
 	}
 
 	performance_data.pm_polygon_count = polygon_count;
 	r_build.polygon_count = polygon_count;
+
+	// The kept connections are only valid for the settings they were built with.
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &region_connections = r_build.region_connections;
+	if (r_build.connections_merge_rasterizer_cell_size != r_build.merge_rasterizer_cell_size || r_build.connections_use_edge_connections != r_build.use_edge_connections || r_build.connections_edge_connection_margin != r_build.edge_connection_margin) {
+		r_build.connection_pairs_map.clear();
+		region_connections.clear();
+		// The links keep pointers to the polygons of the regions.
+		r_build.link_connections.clear();
+
+		r_build.connections_merge_rasterizer_cell_size = r_build.merge_rasterizer_cell_size;
+		r_build.connections_use_edge_connections = r_build.use_edge_connections;
+		r_build.connections_edge_connection_margin = r_build.edge_connection_margin;
+	}
+
+	// Find the regions that changed since the last build. A modified region has a new iteration, so it is removed and added.
+	HashSet<const NavBaseIteration3D *> map_regions;
+	map_regions.reserve(regions.size());
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		map_regions.insert(region.ptr());
+
+		if (!region_connections.has(region.ptr())) {
+			region_connections[region.ptr()].region = region;
+			r_build.iter_added_regions.push_back(region);
+		}
+	}
+
+	for (const KeyValue<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &E : region_connections) {
+		if (!map_regions.has(E.key)) {
+			r_build.iter_removed_regions.push_back(E.value.region);
+		}
+	}
+	for (const Ref<NavRegionIteration3D> &region : r_build.iter_removed_regions) {
+		region_connections.erase(region.ptr());
+	}
 }
 
 void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
-	NavMapIteration3D *map_iteration = r_build.map_iteration;
-	int polygon_count = r_build.polygon_count;
 
-	HashMap<EdgeKey, EdgeConnectionPair, EdgeKey> &connection_pairs_map = r_build.iter_connection_pairs_map;
+	HashMap<EdgeKey, EdgeConnectionPair, EdgeKey> &connection_pairs_map = r_build.connection_pairs_map;
+	HashSet<const NavBaseIteration3D *> &rebuilt_regions = r_build.iter_rebuilt_regions;
 
-	// Group all edges per key.
-	connection_pairs_map.clear();
-	connection_pairs_map.reserve(polygon_count);
-	int free_edges_count = 0; // How many ConnectionPairs have only one Connection.
+	// Take the edges of the removed regions out of their pairs, the regions left alone on these edges get new free edges.
+	for (const Ref<NavRegionIteration3D> &region : r_build.iter_removed_regions) {
+		for (const ConnectableEdge &connectable_edge : region->get_external_edges()) {
+			HashMap<EdgeKey, EdgeConnectionPair, EdgeKey>::Iterator pair_it = connection_pairs_map.find(connectable_edge.ek);
+			if (!pair_it) {
+				continue;
+			}
+
+			EdgeConnectionPair &pair = pair_it->value;
+			const Polygon *polygon = &region->navmesh_polygons[connectable_edge.polygon_index];
+			for (int i = 0; i < pair.size; i++) {
+				if (pair.connections[i].polygon == polygon) {
+					--pair.size;
+					pair.connections[i] = pair.connections[pair.size];
+					break;
+				}
+			}
+
+			if (pair.size == 0) {
+				connection_pairs_map.remove(pair_it);
+			} else {
+				rebuilt_regions.insert(pair.connections[0].polygon->owner);
+			}
+		}
+	}
+
+	// Group the edges of the added regions per key, the regions they get merged with lose free edges.
+	for (const Ref<NavRegionIteration3D> &region : r_build.iter_added_regions) {
+		rebuilt_regions.insert(region.ptr());
 
-	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
 		for (const ConnectableEdge &connectable_edge : region->get_external_edges()) {
 			const EdgeKey &ek = connectable_edge.ek;
 
 			HashMap<EdgeKey, EdgeConnectionPair, EdgeKey>::Iterator pair_it = connection_pairs_map.find(ek);
 			if (!pair_it) {
 				pair_it = connection_pairs_map.insert(ek, EdgeConnectionPair());
-				performance_data.pm_edge_count += 1;
-				++free_edges_count;
 			}
 			EdgeConnectionPair &pair = pair_it->value;
 			if (pair.size < 2) {
@@ -133,7 +207,8 @@ void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuil
 				pair.connections[pair.size] = new_connection;
 				++pair.size;
 				if (pair.size == 2) {
-					--free_edges_count;
+					rebuilt_regions.insert(pair.connections[0].polygon->owner);
+					performance_data.pm_sync_edge_merge_count += 1;
 				}
 
 			} else {
@@ -143,42 +218,81 @@ void NavMapBuilder3D::_build_step_find_edge_connection_pairs(NavMapIterationBuil
 		}
 	}
 
-	r_build.free_edge_count = free_edges_count;
+	performance_data.pm_edge_count = connection_pairs_map.size();
 }
 
 void NavMapBuilder3D::_build_step_merge_edge_connection_pairs(NavMapIterationBuild3D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
-	HashMap<EdgeKey, EdgeConnectionPair, EdgeKey> &connection_pairs_map = r_build.iter_connection_pairs_map;
+	const HashMap<EdgeKey, EdgeConnectionPair, EdgeKey> &connection_pairs_map = r_build.connection_pairs_map;
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &region_connections = r_build.region_connections;
 	LocalVector<Connection> &free_edges = r_build.iter_free_edges;
-	int free_edges_count = r_build.free_edge_count;
 	bool use_edge_connections = r_build.use_edge_connections;
 
-	free_edges.clear();
-	free_edges.reserve(free_edges_count);
+	// Rebuild the connections and free edges of the regions whose edge pairs changed.
+	for (const NavBaseIteration3D *navbase : r_build.iter_rebuilt_regions) {
+		HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections>::Iterator connections_it = region_connections.find(navbase);
+		if (!connections_it) {
+			// Removed from the map.
+			continue;
+		}
 
-	NavMapIteration3D *map_iteration = r_build.map_iteration;
+		NavMapIterationBuild3D::RegionConnections &connections = connections_it->value;
+		const NavRegionIteration3D *region = connections.region.ptr();
 
-	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+		connections.edge_connections.clear();
+		connections.edge_connections.resize(region->navmesh_polygons.size());
+		connections.edge_connection_count = 0;
+		connections.free_edges.clear();
 
-	for (const KeyValue<EdgeKey, EdgeConnectionPair> &pair_it : connection_pairs_map) {
-		const EdgeConnectionPair &pair = pair_it.value;
-		if (pair.size == 2) {
-			// Connect edge that are shared in different polygons.
-			const Connection &c1 = pair.connections[0];
-			const Connection &c2 = pair.connections[1];
+		for (const ConnectableEdge &connectable_edge : region->get_external_edges()) {
+			HashMap<EdgeKey, EdgeConnectionPair, EdgeKey>::ConstIterator pair_it = connection_pairs_map.find(connectable_edge.ek);
+			if (!pair_it) {
+				continue;
+			}
 
-			navbases_polygons_external_connections[c1.polygon->owner][c1.polygon->id].push_back(c2);
-			navbases_polygons_external_connections[c2.polygon->owner][c2.polygon->id].push_back(c1);
-			performance_data.pm_edge_connection_count += 1;
+			const EdgeConnectionPair &pair = pair_it->value;
+			const Polygon *polygon = &region->navmesh_polygons[connectable_edge.polygon_index];
+			if (pair.size == 2) {
+				// Connect edge that are shared in different polygons.
+				if (pair.connections[0].polygon == polygon) {
+					connections.edge_connections[connectable_edge.polygon_index].push_back(pair.connections[1]);
+				} else if (pair.connections[1].polygon == polygon) {
+					connections.edge_connections[connectable_edge.polygon_index].push_back(pair.connections[0]);
+				} else {
+					// The edge was skipped as a third edge on this key.
+					continue;
+				}
+				connections.edge_connection_count += 1;
 
-		} else {
-			CRASH_COND_MSG(pair.size != 1, vformat("Number of connection != 1. Found: %d", pair.size));
-			if (use_edge_connections && pair.connections[0].polygon->owner->get_use_edge_connections()) {
-				free_edges.push_back(pair.connections[0]);
+			} else if (use_edge_connections && region->get_use_edge_connections() && pair.connections[0].polygon == polygon) {
+				connections.free_edges.push_back(pair.connections[0]);
 			}
 		}
+
+		performance_data.pm_sync_region_rebuild_count += 1;
 	}
+
+	// Copy the connections of all regions in the map.
+	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+
+	free_edges.clear();
+	uint32_t edge_connection_count = 0;
+
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		const NavMapIterationBuild3D::RegionConnections &connections = region_connections[region.ptr()];
+
+		navbases_polygons_external_connections[region.ptr()] = connections.edge_connections;
+		edge_connection_count += connections.edge_connection_count;
+
+		for (const Connection &free_edge : connections.free_edges) {
+			free_edges.push_back(free_edge);
+		}
+	}
+
+	// Both polygons of a shared edge count the connection.
+	performance_data.pm_edge_connection_count += edge_connection_count / 2;
 }
 
 void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapIterationBuild3D &r_build) {
@@ -187,7 +301,9 @@ void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapItera
 
 	real_t edge_connection_margin = r_build.edge_connection_margin;
 
-	LocalVector<Connection> &free_edges = r_build.iter_free_edges;
+	const LocalVector<Connection> &free_edges = r_build.iter_free_edges;
+	const HashSet<const NavBaseIteration3D *> &rebuilt_regions = r_build.iter_rebuilt_regions;
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &region_connections = r_build.region_connections;
 	HashMap<const NavBaseIteration3D *, LocalVector<Connection>> &region_external_connections = map_iteration->external_region_connections;
 
 	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
@@ -203,66 +319,101 @@ void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapItera
 
 	const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
 
-	for (uint32_t i = 0; i < free_edges.size(); i++) {
-		const Connection &free_edge = free_edges[i];
-		const Vector3 &edge_p1 = free_edge.pathway_start;
-		const Vector3 &edge_p2 = free_edge.pathway_end;
+	const auto connect_free_edges = [&](const LocalVector<Connection> &p_free_edges, const LocalVector<Connection> &p_other_edges, LocalVector<NavMapIterationBuild3D::MarginConnection> &r_margin_connections) {
+		for (const Connection &free_edge : p_free_edges) {
+			const Vector3 &edge_p1 = free_edge.pathway_start;
+			const Vector3 &edge_p2 = free_edge.pathway_end;
 
-		for (uint32_t j = 0; j < free_edges.size(); j++) {
-			const Connection &other_edge = free_edges[j];
-			if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-				continue;
-			}
+			for (const Connection &other_edge : p_other_edges) {
+				if (free_edge.polygon->owner == other_edge.polygon->owner) {
+					continue;
+				}
 
-			const Vector3 &other_edge_p1 = other_edge.pathway_start;
-			const Vector3 &other_edge_p2 = other_edge.pathway_end;
+				const Vector3 &other_edge_p1 = other_edge.pathway_start;
+				const Vector3 &other_edge_p2 = other_edge.pathway_end;
 
-			// Compute the projection of the opposite edge on the current one
-			Vector3 edge_vector = edge_p2 - edge_p1;
-			real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-			real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-			if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-				continue;
-			}
+				// Compute the projection of the opposite edge on the current one
+				Vector3 edge_vector = edge_p2 - edge_p1;
+				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+					continue;
+				}
 
-			// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-			Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-			Vector3 other1;
-			if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-				other1 = other_edge_p1;
-			} else {
-				other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-			}
-			if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
-				continue;
-			}
+				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+				Vector3 other1;
+				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+					other1 = other_edge_p1;
+				} else {
+					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+				}
+				if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
+					continue;
+				}
 
-			Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-			Vector3 other2;
-			if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-				other2 = other_edge_p2;
-			} else {
-				other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-			}
-			if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
-				continue;
+				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+				Vector3 other2;
+				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+					other2 = other_edge_p2;
+				} else {
+					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+				}
+				if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
+					continue;
+				}
+
+				// The edges can now be connected.
+				NavMapIterationBuild3D::MarginConnection margin_connection;
+				margin_connection.polygon_id = free_edge.polygon->id;
+				margin_connection.connection = other_edge;
+				margin_connection.connection.pathway_start = (self1 + other1) / 2.0;
+				margin_connection.connection.pathway_end = (self2 + other2) / 2.0;
+				r_margin_connections.push_back(margin_connection);
 			}
+		}
+	};
+
+	// Only the free edges of the rebuilt regions can have new connections.
+	LocalVector<Connection> rebuilt_free_edges;
+	for (const Connection &free_edge : free_edges) {
+		if (rebuilt_regions.has(free_edge.polygon->owner)) {
+			rebuilt_free_edges.push_back(free_edge);
+		}
+	}
 
-			// The edges can now be connected.
-			Connection new_connection = other_edge;
-			new_connection.pathway_start = (self1 + other1) / 2.0;
-			new_connection.pathway_end = (self2 + other2) / 2.0;
-			//free_edge.polygon->connections.push_back(new_connection);
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		NavMapIterationBuild3D::RegionConnections &connections = region_connections[region.ptr()];
 
-			// Add the connection to the region_connection map.
-			region_external_connections[free_edge.polygon->owner].push_back(new_connection);
-			navbases_polygons_external_connections[free_edge.polygon->owner][free_edge.polygon->id].push_back(new_connection);
-			performance_data.pm_edge_connection_count += 1;
+		if (rebuilt_regions.has(region.ptr())) {
+			connections.margin_connections.clear();
+			connect_free_edges(connections.free_edges, free_edges, connections.margin_connections);
+		} else {
+			// Keep the connections to the unchanged regions.
+			for (uint32_t i = 0; i < connections.margin_connections.size();) {
+				const NavBaseIteration3D *other_owner = connections.margin_connections[i].connection.polygon->owner;
+				if (rebuilt_regions.has(other_owner) || !region_connections.has(other_owner)) {
+					connections.margin_connections.remove_at_unordered(i);
+				} else {
+					i++;
+				}
+			}
+			connect_free_edges(connections.free_edges, rebuilt_free_edges, connections.margin_connections);
+		}
+
+		// Add the connections to the region_connection map.
+		LocalVector<Connection> &external_connections = region_external_connections[region.ptr()];
+		LocalVector<LocalVector<Connection>> &polygons_external_connections = navbases_polygons_external_connections[region.ptr()];
+		for (const NavMapIterationBuild3D::MarginConnection &margin_connection : connections.margin_connections) {
+			external_connections.push_back(margin_connection.connection);
+			polygons_external_connections[margin_connection.polygon_id].push_back(margin_connection.connection);
 		}
+		performance_data.pm_edge_connection_count += connections.margin_connections.size();
 	}
 }
 
 void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_build) {
+	PerformanceData &performance_data = r_build.performance_data;
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
 	real_t link_connection_radius = r_build.link_connection_radius;
@@ -279,6 +430,32 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	navlink_polygons.resize(links.size());
 	uint32_t navlink_index = 0;
 
+	const HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::RegionConnections> &region_connections = r_build.region_connections;
+	HashMap<const NavBaseIteration3D *, NavMapIterationBuild3D::LinkConnections> &link_connections = r_build.link_connections;
+	if (r_build.links_connection_radius != link_connection_radius) {
+		link_connections.clear();
+		r_build.links_connection_radius = link_connection_radius;
+	}
+
+	// Forget the links that are no longer in the map. A modified link has a new iteration.
+	if (!link_connections.is_empty()) {
+		HashSet<const NavBaseIteration3D *> map_links;
+		map_links.reserve(links.size());
+		for (const Ref<NavLinkIteration3D> &link : links) {
+			map_links.insert(link.ptr());
+		}
+
+		LocalVector<const NavBaseIteration3D *> removed_links;
+		for (const KeyValue<const NavBaseIteration3D *, NavMapIterationBuild3D::LinkConnections> &E : link_connections) {
+			if (!map_links.has(E.key)) {
+				removed_links.push_back(E.key);
+			}
+		}
+		for (const NavBaseIteration3D *removed_link : removed_links) {
+			link_connections.erase(removed_link);
+		}
+	}
+
 	// Search for polygons within range of a nav link.
 	for (const Ref<NavLinkIteration3D> &link : links) {
 		polygon_count++;
@@ -290,51 +467,78 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 		const Vector3 link_start_pos = link->get_start_position();
 		const Vector3 link_end_pos = link->get_end_position();
 
-		Polygon *closest_start_polygon = nullptr;
-		real_t closest_start_sqr_dist = link_connection_radius_sqr;
-		Vector3 closest_start_point;
+		// The closest polygons of a link only change when a region holding one of them is removed or a region is added in range of the link.
+		NavMapIterationBuild3D::LinkConnections *connections = link_connections.getptr(link.ptr());
+		bool search_polygons = connections == nullptr;
+		if (search_polygons) {
+			connections = &link_connections.insert(link.ptr(), NavMapIterationBuild3D::LinkConnections())->value;
+			connections->link = link;
+		} else {
+			search_polygons = (connections->start_polygon && !region_connections.has(connections->start_polygon->owner)) || (connections->end_polygon && !region_connections.has(connections->end_polygon->owner));
+			for (uint32_t i = 0; i < r_build.iter_added_regions.size() && !search_polygons; i++) {
+				AABB region_bounds = r_build.iter_added_regions[i]->get_bounds().grow(link_connection_radius);
+				search_polygons = region_bounds.has_point(link_start_pos) || region_bounds.has_point(link_end_pos);
+			}
+		}
 
-		Polygon *closest_end_polygon = nullptr;
-		real_t closest_end_sqr_dist = link_connection_radius_sqr;
-		Vector3 closest_end_point;
+		if (search_polygons) {
+			Polygon *closest_start_polygon = nullptr;
+			real_t closest_start_sqr_dist = link_connection_radius_sqr;
+			Vector3 closest_start_point;
 
-		for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
-			AABB region_bounds = region->get_bounds().grow(link_connection_radius);
-			if (!region_bounds.has_point(link_start_pos) && !region_bounds.has_point(link_end_pos)) {
-				continue;
-			}
+			Polygon *closest_end_polygon = nullptr;
+			real_t closest_end_sqr_dist = link_connection_radius_sqr;
+			Vector3 closest_end_point;
 
-			for (Polygon &polyon : region->navmesh_polygons) {
-				for (uint32_t point_id = 2; point_id < polyon.vertices.size(); point_id += 1) {
-					const Face3 face(polyon.vertices[0], polyon.vertices[point_id - 1], polyon.vertices[point_id]);
+			for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+				AABB region_bounds = region->get_bounds().grow(link_connection_radius);
+				if (!region_bounds.has_point(link_start_pos) && !region_bounds.has_point(link_end_pos)) {
+					continue;
+				}
+
+				for (Polygon &polyon : region->navmesh_polygons) {
+					for (uint32_t point_id = 2; point_id < polyon.vertices.size(); point_id += 1) {
+						const Face3 face(polyon.vertices[0], polyon.vertices[point_id - 1], polyon.vertices[point_id]);
 
-					{
-						const Vector3 start_point = face.get_closest_point_to(link_start_pos);
-						const real_t sqr_dist = start_point.distance_squared_to(link_start_pos);
+						{
+							const Vector3 start_point = face.get_closest_point_to(link_start_pos);
+							const real_t sqr_dist = start_point.distance_squared_to(link_start_pos);
 
-						// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-						if (sqr_dist < closest_start_sqr_dist) {
-							closest_start_sqr_dist = sqr_dist;
-							closest_start_point = start_point;
-							closest_start_polygon = &polyon;
+							// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+							if (sqr_dist < closest_start_sqr_dist) {
+								closest_start_sqr_dist = sqr_dist;
+								closest_start_point = start_point;
+								closest_start_polygon = &polyon;
+							}
 						}
-					}
 
-					{
-						const Vector3 end_point = face.get_closest_point_to(link_end_pos);
-						const real_t sqr_dist = end_point.distance_squared_to(link_end_pos);
+						{
+							const Vector3 end_point = face.get_closest_point_to(link_end_pos);
+							const real_t sqr_dist = end_point.distance_squared_to(link_end_pos);
 
-						// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-						if (sqr_dist < closest_end_sqr_dist) {
-							closest_end_sqr_dist = sqr_dist;
-							closest_end_point = end_point;
-							closest_end_polygon = &polyon;
+							// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+							if (sqr_dist < closest_end_sqr_dist) {
+								closest_end_sqr_dist = sqr_dist;
+								closest_end_point = end_point;
+								closest_end_polygon = &polyon;
+							}
 						}
 					}
 				}
 			}
+
+			connections->start_polygon = closest_start_polygon;
+			connections->start_point = closest_start_point;
+			connections->end_polygon = closest_end_polygon;
+			connections->end_point = closest_end_point;
+			performance_data.pm_sync_link_rebuild_count += 1;
 		}
 
+		Polygon *closest_start_polygon = connections->start_polygon;
+		const Vector3 &closest_start_point = connections->start_point;
+		Polygon *closest_end_polygon = connections->end_polygon;
+		const Vector3 &closest_end_point = connections->end_point;
+
 		// If we have both a start and end point, then create a synthetic polygon to route through.
 		if (closest_start_polygon && closest_end_polygon) {
 			new_polygon.vertices.resize(4);
@@ -386,6 +590,146 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_step_cluster_graph(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	ClusterGraph &cluster_graph = map_iteration->cluster_graph;
+	cluster_graph.clear();
+
+	if (!r_build.use_hierarchical_pathfinding) {
+		return;
+	}
+
+	const HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
+
+	// Polygons are numbered like the path query slots number them, regions first and links last.
+	HashMap<const NavBaseIteration3D *, uint32_t> navbase_first_polygon_id;
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(r_build.polygon_count);
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		navbase_first_polygon_id[region.ptr()] = polygons.size();
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			polygons.push_back(&polygon);
+		}
+	}
+	for (const Polygon &polygon : map_iteration->navlink_polygons) {
+		navbase_first_polygon_id[polygon.owner] = polygons.size();
+		polygons.push_back(&polygon);
+	}
+
+	// Group the polygons by the cell of their center.
+	const Vector3 cluster_cell_size = Vector3(r_build.hierarchical_cluster_size, r_build.hierarchical_cluster_size, r_build.hierarchical_cluster_size);
+	HashMap<uint64_t, uint32_t> cell_to_cluster;
+	LocalVector<uint32_t> cluster_polygon_counts;
+
+	cluster_graph.polygon_clusters.resize(polygons.size());
+	for (uint32_t polygon_id = 0; polygon_id < polygons.size(); polygon_id++) {
+		const Polygon &polygon = *polygons[polygon_id];
+		if (polygon.vertices.is_empty()) {
+			// Links without polygons to connect to.
+			cluster_graph.polygon_clusters[polygon_id] = UINT32_MAX;
+			continue;
+		}
+
+		Vector3 center;
+		for (const Vector3 &vertex : polygon.vertices) {
+			center += vertex;
+		}
+		center /= polygon.vertices.size();
+
+		const PointKey cell = get_point_key(center, cluster_cell_size);
+		HashMap<uint64_t, uint32_t>::Iterator cluster_it = cell_to_cluster.find(cell.key);
+		if (!cluster_it) {
+			cluster_it = cell_to_cluster.insert(cell.key, cluster_graph.clusters.size());
+			cluster_graph.clusters.push_back(ClusterGraph::Cluster());
+			cluster_polygon_counts.push_back(0);
+		}
+
+		const uint32_t cluster = cluster_it->value;
+		cluster_graph.polygon_clusters[polygon_id] = cluster;
+		cluster_graph.clusters[cluster].position += center;
+		cluster_polygon_counts[cluster] += 1;
+	}
+
+	for (uint32_t cluster = 0; cluster < cluster_graph.clusters.size(); cluster++) {
+		cluster_graph.clusters[cluster].position /= cluster_polygon_counts[cluster];
+	}
+
+	// The portal between two clusters is the average of the pathways of the connections crossing from one to the other.
+	struct Portal {
+		uint64_t key = 0;
+		Vector3 position_sum;
+		uint32_t connection_count = 0;
+
+		bool operator<(const Portal &p_other) const { return key < p_other.key; }
+	};
+	HashMap<uint64_t, uint32_t> key_to_portal;
+	LocalVector<Portal> portals;
+
+	const auto add_portal_connection = [&](uint32_t p_from_cluster, const Connection &p_connection) {
+		const uint32_t to_polygon_id = navbase_first_polygon_id[p_connection.polygon->owner] + p_connection.polygon->id;
+		const uint32_t to_cluster = cluster_graph.polygon_clusters[to_polygon_id];
+		if (to_cluster == UINT32_MAX || to_cluster == p_from_cluster) {
+			return;
+		}
+
+		const uint64_t key = (uint64_t(p_from_cluster) << 32) | to_cluster;
+		HashMap<uint64_t, uint32_t>::Iterator portal_it = key_to_portal.find(key);
+		if (!portal_it) {
+			portal_it = key_to_portal.insert(key, portals.size());
+			portals.push_back(Portal());
+			portals[portal_it->value].key = key;
+		}
+
+		Portal &portal = portals[portal_it->value];
+		portal.position_sum += (p_connection.pathway_start + p_connection.pathway_end) * 0.5;
+		portal.connection_count += 1;
+	};
+
+	for (uint32_t polygon_id = 0; polygon_id < polygons.size(); polygon_id++) {
+		const uint32_t from_cluster = cluster_graph.polygon_clusters[polygon_id];
+		if (from_cluster == UINT32_MAX) {
+			continue;
+		}
+
+		const Polygon &polygon = *polygons[polygon_id];
+		const LocalVector<LocalVector<Connection>> &internal_connections = polygon.owner->get_internal_connections();
+		if (polygon.id < internal_connections.size()) {
+			for (const Connection &connection : internal_connections[polygon.id]) {
+				add_portal_connection(from_cluster, connection);
+			}
+		}
+
+		HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Connection>>>::ConstIterator external_it = navbases_polygons_external_connections.find(polygon.owner);
+		if (external_it && polygon.id < external_it->value.size()) {
+			for (const Connection &connection : external_it->value[polygon.id]) {
+				add_portal_connection(from_cluster, connection);
+			}
+		}
+	}
+
+	// Sorting by key groups the edges by their source cluster.
+	portals.sort();
+
+	cluster_graph.edges.resize(portals.size());
+	for (uint32_t portal_index = 0; portal_index < portals.size(); portal_index++) {
+		const Portal &portal = portals[portal_index];
+		const uint32_t from_cluster = portal.key >> 32;
+		const uint32_t to_cluster = portal.key & UINT32_MAX;
+		const Vector3 portal_position = portal.position_sum / portal.connection_count;
+
+		ClusterGraph::Cluster &cluster = cluster_graph.clusters[from_cluster];
+		if (cluster.edge_count == 0) {
+			cluster.first_edge = portal_index;
+		}
+		cluster.edge_count += 1;
+
+		ClusterGraph::Edge &edge = cluster_graph.edges[portal_index];
+		edge.cluster = to_cluster;
+		edge.cost = cluster.position.distance_to(portal_position) + portal_position.distance_to(cluster_graph.clusters[to_cluster].position);
+	}
+}
+
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
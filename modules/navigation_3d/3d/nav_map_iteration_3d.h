@@ -36,6 +36,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/os/semaphore.h"
+#include "core/templates/hash_set.h"
 
 class NavLinkIteration3D;
 class NavRegion3D;
@@ -47,24 +48,64 @@ struct NavMapIterationBuild3D {
 	bool use_edge_connections = true;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_cluster_size;
 	Nav3D::PerformanceData performance_data;
 	int polygon_count = 0;
-	int free_edge_count = 0;
 
-	HashMap<Nav3D::EdgeKey, Nav3D::EdgeConnectionPair, Nav3D::EdgeKey> iter_connection_pairs_map;
 	LocalVector<Nav3D::Connection> iter_free_edges;
 
+	// Regions added to and removed from the map since the last build, kept referenced until the build is done.
+	LocalVector<Ref<NavRegionIteration3D>> iter_added_regions;
+	LocalVector<Ref<NavRegionIteration3D>> iter_removed_regions;
+	// The added regions and the regions that share an edge with an added or removed region.
+	HashSet<const NavBaseIteration3D *> iter_rebuilt_regions;
+
 	NavMapIteration3D *map_iteration = nullptr;
 
 	int navmesh_polygon_count = 0;
 
+	// Everything below is kept from one build to the next so that the connections are only rebuilt
+	// for the regions and links that changed and for their neighbors.
+
+	struct MarginConnection {
+		uint32_t polygon_id = 0;
+		Nav3D::Connection connection;
+	};
+
+	struct RegionConnections {
+		Ref<NavRegionIteration3D> region;
+		// Connections of each polygon through the edges it shares with polygons of other regions.
+		LocalVector<LocalVector<Nav3D::Connection>> edge_connections;
+		uint32_t edge_connection_count = 0;
+		// The external edges that are not shared and may be connected by the edge connection margin.
+		LocalVector<Nav3D::Connection> free_edges;
+		LocalVector<MarginConnection> margin_connections;
+	};
+
+	struct LinkConnections {
+		Ref<NavLinkIteration3D> link;
+		Nav3D::Polygon *start_polygon = nullptr;
+		Nav3D::Polygon *end_polygon = nullptr;
+		Vector3 start_point;
+		Vector3 end_point;
+	};
+
+	HashMap<Nav3D::EdgeKey, Nav3D::EdgeConnectionPair, Nav3D::EdgeKey> connection_pairs_map;
+	HashMap<const NavBaseIteration3D *, RegionConnections> region_connections;
+	HashMap<const NavBaseIteration3D *, LinkConnections> link_connections;
+
+	// The settings the kept connections were built with, a change rebuilds them all.
+	Vector3 connections_merge_rasterizer_cell_size;
+	bool connections_use_edge_connections = true;
+	real_t connections_edge_connection_margin = 0.0;
+	real_t links_connection_radius = 0.0;
+
 	void reset() {
 		performance_data.reset();
 
-		iter_connection_pairs_map.clear();
 		iter_free_edges.clear();
 		polygon_count = 0;
-		free_edge_count = 0;
 
 		navmesh_polygon_count = 0;
 	}
@@ -89,6 +130,9 @@ struct NavMapIteration3D {
 
 	HashMap<NavRegion3D *, Ref<NavRegionIteration3D>> region_ptr_to_region_iteration;
 
+	// Only built when the map uses hierarchical pathfinding.
+	Nav3D::ClusterGraph cluster_graph;
+
 	LocalVector<NavMeshQueries3D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
@@ -103,6 +147,7 @@ struct NavMapIteration3D {
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
 		region_ptr_to_region_iteration.clear();
+		cluster_graph.clear();
 	}
 };
 
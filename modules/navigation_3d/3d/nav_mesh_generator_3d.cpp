@@ -31,7 +31,9 @@
 #include "nav_mesh_generator_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/os/os.h"
 #include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/3d/node_3d.h"
 #include "scene/resources/3d/navigation_mesh_source_geometry_data_3d.h"
 #include "scene/resources/navigation_mesh.h"
@@ -49,6 +51,16 @@ HashMap<Ref<NavigationMesh>, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMe
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
 LocalVector<NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
 
+// Tiles of the navigation meshes baked with a tile size, kept to only rebake the tiles that changed.
+struct NavMeshBakedTile3D {
+	uint32_t hash = 0;
+	Vector<Vector3> vertices;
+	Vector<Vector<int>> polygons;
+};
+
+static Mutex baked_tiles_mutex;
+static HashMap<ObjectID, HashMap<Vector2i, NavMeshBakedTile3D>> baked_tiles;
+
 static const char *_navmesh_bake_state_msgs[(size_t)NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_MAX] = {
 	"",
 	"Setting up configuration...",
@@ -137,6 +149,9 @@ void NavMeshGenerator3D::cleanup() {
 		generator_parsers.clear();
 		generator_parsers_rwlock.write_unlock();
 	}
+
+	MutexLock baked_tiles_lock(baked_tiles_mutex);
+	baked_tiles.clear();
 }
 
 void NavMeshGenerator3D::finish() {
@@ -296,11 +311,24 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
+	// Parsing has to stay on the main thread, but the transform and copy of the parsed surfaces can run in parallel afterwards.
+	const uint64_t parse_start_usec = OS::get_singleton()->get_ticks_usec();
+	p_source_geometry_data->begin_deferred_surfaces();
+
 	for (Node *parse_node : parse_nodes) {
 		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children);
 	}
+
+	const uint64_t write_start_usec = OS::get_singleton()->get_ticks_usec();
+	const int surface_count = p_source_geometry_data->end_deferred_surfaces(use_threads);
+	const uint64_t write_end_usec = OS::get_singleton()->get_ticks_usec();
+
+	print_verbose(vformat("NavMeshGenerator3D: Parsed %d source geometry surfaces, gathering took %d usec and writing took %d usec.", surface_count, write_start_usec - parse_start_usec, write_end_usec - write_start_usec));
 }
 
+static bool _generator_bake_recast_polygons(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, NavMeshGenerator3D::NavMeshBakeState &r_bake_state, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+static bool _generator_bake_tiles(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const Vector<float> &p_vertices, const Vector<int> &p_indices, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, bool p_use_threads, bool p_use_high_priority_threads, NavMeshGenerator3D::NavMeshBakeState &r_bake_state, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+
 void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task) {
 	Ref<NavigationMesh> p_navigation_mesh = p_generator_task->navigation_mesh;
 	const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data = p_generator_task->source_geometry_data;
@@ -322,13 +350,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONFIGURATION; // step #1
 
 	const float *verts = source_geometry_vertices.ptr();
@@ -406,6 +427,20 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 	}
 
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CALC_GRID_SIZE; // step #2
+
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		Vector<Vector3> nav_vertices;
+		Vector<Vector<int>> nav_polygons;
+		if (!_generator_bake_tiles(p_navigation_mesh, cfg, source_geometry_vertices, source_geometry_indices, projected_obstructions, use_threads, baking_use_high_priority_threads, p_generator_task->bake_state, nav_vertices, nav_polygons)) {
+			return;
+		}
+
+		p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+		p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_FINISHED;
+		return;
+	}
+
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
@@ -419,48 +454,68 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		return;
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD; // step #3
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!_generator_bake_recast_polygons(p_navigation_mesh, cfg, verts, nverts, tris, ntris, projected_obstructions, p_generator_task->bake_state, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_FINISHED; // step #12
+}
+
+// Runs the Recast pipeline from rasterization to the detail mesh within the bounds of the configuration.
+static bool _generator_bake_recast_polygons(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, NavMeshGenerator3D::NavMeshBakeState &r_bake_state, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_MARK_WALKABLE_TRIANGLES; // step #4
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_MARK_WALKABLE_TRIANGLES; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONSTRUCT_COMPACT_HEIGHTFIELD; // step #5
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CONSTRUCT_COMPACT_HEIGHTFIELD; // step #5
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (projected_obstruction.carve) {
 				continue;
 			}
@@ -475,13 +530,13 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		}
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_ERODE_WALKABLE_AREA; // step #6
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_ERODE_WALKABLE_AREA; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (!projected_obstruction.carve) {
 				continue;
 			}
@@ -496,43 +551,43 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		}
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_SAMPLE_PARTITIONING; // step #7
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_SAMPLE_PARTITIONING; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATING_CONTOURS; // step #8
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATING_CONTOURS; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATING_POLYMESH; // step #9
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATING_POLYMESH; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
 	rcFreeContourSet(cset);
 	cset = nullptr;
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH; // step #10
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH; // step #10
 
-	Vector<Vector3> nav_vertices;
-	Vector<Vector<int>> nav_polygons;
+	r_vertices.clear();
+	r_polygons.clear();
 
 	HashMap<Vector3, int> recast_vertex_to_native_index;
 	LocalVector<int> recast_index_to_native_index;
@@ -546,7 +601,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 			int new_index = recast_vertex_to_native_index.size();
 			recast_index_to_native_index[i] = new_index;
 			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
+			r_vertices.push_back(vertex);
 		} else {
 			recast_index_to_native_index[i] = *existing_index_ptr;
 		}
@@ -570,20 +625,398 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 			nav_indices.write[1] = recast_index_to_native_index[index2];
 			nav_indices.write[2] = recast_index_to_native_index[index3];
 
-			nav_polygons.push_back(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
-	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
-
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_CLEANUP; // step #11
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_BAKE_CLEANUP; // step #11
 
 	rcFreePolyMesh(poly_mesh);
 	poly_mesh = nullptr;
 	rcFreePolyMeshDetail(detail_mesh);
 	detail_mesh = nullptr;
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_FINISHED; // step #12
+	return true;
+}
+
+struct NavMeshBakeTile3D {
+	Vector2i coords;
+	rcConfig cfg;
+	/// Indices of the source geometry triangles that overlap the tile and its border.
+	LocalVector<int> triangles;
+	uint32_t hash = 0;
+	bool baked = false;
+	Vector<Vector3> vertices;
+	Vector<Vector<int>> polygons;
+};
+
+struct NavMeshBakeTilesUserdata3D {
+	Ref<NavigationMesh> navigation_mesh;
+	const float *verts = nullptr;
+	int nverts = 0;
+	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> *projected_obstructions = nullptr;
+	LocalVector<NavMeshBakeTile3D> *tiles = nullptr;
+	LocalVector<uint32_t> dirty_tiles;
+	SafeNumeric<uint32_t> next_dirty_tile;
+};
+
+// Bakes dirty tiles until none are left. The baking thread runs this too, so it never only waits on busy worker threads.
+static void _generator_bake_tiles_worker(void *p_userdata) {
+	NavMeshBakeTilesUserdata3D *userdata = static_cast<NavMeshBakeTilesUserdata3D *>(p_userdata);
+
+	while (true) {
+		const uint32_t dirty_tile_index = userdata->next_dirty_tile.postincrement();
+		if (dirty_tile_index >= userdata->dirty_tiles.size()) {
+			break;
+		}
+		NavMeshBakeTile3D &tile = (*userdata->tiles)[userdata->dirty_tiles[dirty_tile_index]];
+
+		// Tiles bake concurrently, so they track their own bake state.
+		NavMeshGenerator3D::NavMeshBakeState tile_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_NONE;
+		tile.baked = _generator_bake_recast_polygons(userdata->navigation_mesh, tile.cfg, userdata->verts, userdata->nverts, tile.triangles.ptr(), tile.triangles.size() / 3, *userdata->projected_obstructions, tile_bake_state, tile.vertices, tile.polygons);
+	}
+}
+
+static bool _generator_bake_tiles(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const Vector<float> &p_vertices, const Vector<int> &p_indices, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, bool p_use_threads, bool p_use_high_priority_threads, NavMeshGenerator3D::NavMeshBakeState &r_bake_state, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	const float *verts = p_vertices.ptr();
+	const int nverts = p_vertices.size() / 3;
+	const int *tris = p_indices.ptr();
+	const int ntris = p_indices.size() / 3;
+
+	// The tile grid is anchored at the world origin and aligned to the cells so tiles keep their bounds when the geometry changes elsewhere.
+	// Tiles bake with a border wide enough for the erosion and the region partitioning to see the geometry of their neighbors.
+	const int tile_cells = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / p_cfg.cs));
+	const float tile_world_size = tile_cells * p_cfg.cs;
+	const int border_cells = MAX(p_cfg.borderSize, p_cfg.walkableRadius + 3);
+	const float border_world_size = border_cells * p_cfg.cs;
+
+	const float bake_min_x = Math::floor(p_cfg.bmin[0] / p_cfg.cs) * p_cfg.cs;
+	const float bake_min_z = Math::floor(p_cfg.bmin[2] / p_cfg.cs) * p_cfg.cs;
+	const float bake_max_x = Math::ceil(p_cfg.bmax[0] / p_cfg.cs) * p_cfg.cs;
+	const float bake_max_z = Math::ceil(p_cfg.bmax[2] / p_cfg.cs) * p_cfg.cs;
+
+	const Vector2i tile_min = Vector2i((int)Math::floor(bake_min_x / tile_world_size), (int)Math::floor(bake_min_z / tile_world_size));
+	const Vector2i tile_max = Vector2i(MAX(tile_min.x, (int)Math::ceil(bake_max_x / tile_world_size) - 1), MAX(tile_min.y, (int)Math::ceil(bake_max_z / tile_world_size) - 1));
+	const int64_t tiles_x = tile_max.x - tile_min.x + 1;
+	const int64_t tiles_z = tile_max.y - tile_min.y + 1;
+
+	const int tile_grid_size = tile_cells + border_cells * 2;
+	if ((int64_t)tile_grid_size * tile_grid_size > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
+		ERR_FAIL_V_MSG(false, "Baking interrupted."
+							  "\nNavigationMesh tile baking process would likely crash the engine."
+							  "\nThe tile size is suspiciously big for the current Cell Size in the NavMesh Resource bake settings."
+							  "\nIt is advised to decrease the Tile Size or increase the Cell Size in the NavMesh Resource bake settings."
+							  "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
+	}
+	ERR_FAIL_COND_V_MSG(tiles_x * tiles_z > 1048576, false, "NavigationMesh tile baking would create more than 1048576 tiles, increase the tile size.");
+
+	LocalVector<NavMeshBakeTile3D> tiles;
+	tiles.resize(tiles_x * tiles_z);
+	for (int z = 0; z < tiles_z; z++) {
+		for (int x = 0; x < tiles_x; x++) {
+			NavMeshBakeTile3D &tile = tiles[z * tiles_x + x];
+			tile.coords = tile_min + Vector2i(x, z);
+			tile.cfg = p_cfg;
+			tile.cfg.borderSize = border_cells;
+			tile.cfg.bmin[0] = MAX(tile.coords.x * tile_world_size, bake_min_x) - border_world_size;
+			tile.cfg.bmin[2] = MAX(tile.coords.y * tile_world_size, bake_min_z) - border_world_size;
+			tile.cfg.bmax[0] = MIN((tile.coords.x + 1) * tile_world_size, bake_max_x) + border_world_size;
+			tile.cfg.bmax[2] = MIN((tile.coords.y + 1) * tile_world_size, bake_max_z) + border_world_size;
+			rcCalcGridSize(tile.cfg.bmin, tile.cfg.bmax, tile.cfg.cs, &tile.cfg.width, &tile.cfg.height);
+		}
+	}
+
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
+		const float min_x = MIN(v0[0], MIN(v1[0], v2[0])) - border_world_size;
+		const float min_z = MIN(v0[2], MIN(v1[2], v2[2])) - border_world_size;
+		const float max_x = MAX(v0[0], MAX(v1[0], v2[0])) + border_world_size;
+		const float max_z = MAX(v0[2], MAX(v1[2], v2[2])) + border_world_size;
+
+		const int from_x = MAX((int)Math::floor(min_x / tile_world_size), tile_min.x) - tile_min.x;
+		const int from_z = MAX((int)Math::floor(min_z / tile_world_size), tile_min.y) - tile_min.y;
+		const int to_x = MIN((int)Math::floor(max_x / tile_world_size), tile_max.x) - tile_min.x;
+		const int to_z = MIN((int)Math::floor(max_z / tile_world_size), tile_max.y) - tile_min.y;
+
+		for (int z = from_z; z <= to_z; z++) {
+			for (int x = from_x; x <= to_x; x++) {
+				LocalVector<int> &triangles = tiles[z * tiles_x + x].triangles;
+				triangles.push_back(tris[i * 3 + 0]);
+				triangles.push_back(tris[i * 3 + 1]);
+				triangles.push_back(tris[i * 3 + 2]);
+			}
+		}
+	}
+
+	// The tile hash covers everything its bake reads, so an unchanged hash means the cached tile can be reused.
+	uint32_t settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type());
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), settings_hash);
+
+	for (NavMeshBakeTile3D &tile : tiles) {
+		uint32_t hash = hash_murmur3_buffer(&tile.cfg, sizeof(rcConfig), settings_hash);
+		for (int index : tile.triangles) {
+			hash = hash_murmur3_buffer(&verts[index * 3], sizeof(float) * 3, hash);
+		}
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+				continue;
+			}
+			float min_x = projected_obstruction.vertices[0];
+			float min_z = projected_obstruction.vertices[2];
+			float max_x = min_x;
+			float max_z = min_z;
+			for (int i = 3; i < projected_obstruction.vertices.size(); i += 3) {
+				min_x = MIN(min_x, projected_obstruction.vertices[i]);
+				min_z = MIN(min_z, projected_obstruction.vertices[i + 2]);
+				max_x = MAX(max_x, projected_obstruction.vertices[i]);
+				max_z = MAX(max_z, projected_obstruction.vertices[i + 2]);
+			}
+			if (max_x < tile.cfg.bmin[0] || min_x > tile.cfg.bmax[0] || max_z < tile.cfg.bmin[2] || min_z > tile.cfg.bmax[2]) {
+				continue;
+			}
+			hash = hash_murmur3_buffer(projected_obstruction.vertices.ptr(), sizeof(float) * projected_obstruction.vertices.size(), hash);
+			hash = hash_murmur3_one_float(projected_obstruction.elevation, hash);
+			hash = hash_murmur3_one_float(projected_obstruction.height, hash);
+			hash = hash_murmur3_one_32(projected_obstruction.carve, hash);
+		}
+		tile.hash = hash_fmix32(hash);
+	}
+
+	HashMap<Vector2i, NavMeshBakedTile3D> *cached_tiles = nullptr;
+	{
+		MutexLock baked_tiles_lock(baked_tiles_mutex);
+
+		// Drops the tiles of navigation meshes that no longer exist.
+		LocalVector<ObjectID> freed_navigation_meshes;
+		for (const KeyValue<ObjectID, HashMap<Vector2i, NavMeshBakedTile3D>> &E : baked_tiles) {
+			if (!ObjectDB::get_instance(E.key)) {
+				freed_navigation_meshes.push_back(E.key);
+			}
+		}
+		for (const ObjectID &navigation_mesh_id : freed_navigation_meshes) {
+			baked_tiles.erase(navigation_mesh_id);
+		}
+
+		// A navigation mesh never bakes twice at the same time, so its tiles are only used by this bake after the lock.
+		cached_tiles = &baked_tiles[p_navigation_mesh->get_instance_id()];
+	}
+
+	NavMeshBakeTilesUserdata3D userdata;
+	userdata.navigation_mesh = p_navigation_mesh;
+	userdata.verts = verts;
+	userdata.nverts = nverts;
+	userdata.projected_obstructions = &p_projected_obstructions;
+	userdata.tiles = &tiles;
+
+	uint32_t tile_count = 0;
+	for (uint32_t i = 0; i < tiles.size(); i++) {
+		const NavMeshBakeTile3D &tile = tiles[i];
+		if (tile.triangles.is_empty()) {
+			continue;
+		}
+		tile_count++;
+		const NavMeshBakedTile3D *cached_tile = cached_tiles->getptr(tile.coords);
+		if (!cached_tile || cached_tile->hash != tile.hash) {
+			userdata.dirty_tiles.push_back(i);
+		}
+	}
+	print_verbose(vformat("NavMeshGenerator3D: Baking %d of %d navigation mesh tiles, the others are unchanged.", userdata.dirty_tiles.size(), tile_count));
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD;
+
+	LocalVector<WorkerThreadPool::TaskID> helper_task_ids;
+	if (p_use_threads && userdata.dirty_tiles.size() > 1) {
+		const uint32_t helper_count = MIN(userdata.dirty_tiles.size() - 1, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count());
+		for (uint32_t i = 0; i < helper_count; i++) {
+			helper_task_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(&_generator_bake_tiles_worker, &userdata, p_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D")));
+		}
+	}
+	_generator_bake_tiles_worker(&userdata);
+	for (WorkerThreadPool::TaskID helper_task_id : helper_task_ids) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(helper_task_id);
+	}
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH;
+
+	HashMap<Vector2i, NavMeshBakedTile3D> new_cached_tiles;
+	for (NavMeshBakeTile3D &tile : tiles) {
+		if (tile.triangles.is_empty()) {
+			continue;
+		}
+		if (tile.baked) {
+			NavMeshBakedTile3D &baked_tile = new_cached_tiles[tile.coords];
+			baked_tile.hash = tile.hash;
+			baked_tile.vertices = tile.vertices;
+			baked_tile.polygons = tile.polygons;
+		} else {
+			const NavMeshBakedTile3D *cached_tile = cached_tiles->getptr(tile.coords);
+			if (cached_tile && cached_tile->hash == tile.hash) {
+				new_cached_tiles.insert(tile.coords, *cached_tile);
+			}
+		}
+	}
+	*cached_tiles = new_cached_tiles;
+
+	// Stitches the tiles together. Vertices on tile edges are snapped to the edge so both tiles weld them to the same vertex.
+	r_vertices.clear();
+	r_polygons.clear();
+
+	HashMap<Vector3, int> welded_vertex_indices;
+	LocalVector<int> tile_vertex_indices;
+	const float snap_distance = p_cfg.cs * 0.01f;
+
+	for (const NavMeshBakeTile3D &tile : tiles) {
+		const NavMeshBakedTile3D *baked_tile = cached_tiles->getptr(tile.coords);
+		if (!baked_tile) {
+			continue;
+		}
+
+		tile_vertex_indices.resize(baked_tile->vertices.size());
+		for (int i = 0; i < baked_tile->vertices.size(); i++) {
+			Vector3 vertex = baked_tile->vertices[i];
+			const float edge_x = Math::round(vertex.x / tile_world_size) * tile_world_size;
+			const float edge_z = Math::round(vertex.z / tile_world_size) * tile_world_size;
+			if (Math::abs(vertex.x - edge_x) < snap_distance) {
+				vertex.x = edge_x;
+			}
+			if (Math::abs(vertex.z - edge_z) < snap_distance) {
+				vertex.z = edge_z;
+			}
+
+			// Heights sampled by two tiles may differ slightly, vertices of different floors are always more than a cell apart.
+			const Vector3 weld_key = Vector3(vertex.x, Math::round(vertex.y / p_cfg.ch), vertex.z);
+			const int *welded_index = welded_vertex_indices.getptr(weld_key);
+			if (welded_index) {
+				tile_vertex_indices[i] = *welded_index;
+			} else {
+				tile_vertex_indices[i] = r_vertices.size();
+				welded_vertex_indices.insert(weld_key, r_vertices.size());
+				r_vertices.push_back(vertex);
+			}
+		}
+
+		for (const Vector<int> &tile_polygon : baked_tile->polygons) {
+			Vector<int> polygon;
+			polygon.resize(tile_polygon.size());
+			bool degenerate = false;
+			for (int i = 0; i < tile_polygon.size(); i++) {
+				polygon.write[i] = tile_vertex_indices[tile_polygon[i]];
+				for (int j = 0; j < i; j++) {
+					degenerate = degenerate || polygon[j] == polygon[i];
+				}
+			}
+			if (!degenerate) {
+				r_polygons.push_back(polygon);
+			}
+		}
+	}
+
+	// Each tile partitions its regions on its own, so the two sides of a seam usually split their shared edge at different vertices.
+	// The polygon edges on a seam are split at the seam vertices of the other side so both sides end up with the same edges.
+	struct SeamVertex {
+		float position = 0.0;
+		int index = -1;
+
+		bool operator<(const SeamVertex &p_other) const { return position < p_other.position; }
+	};
+
+	// Seams are numbered by their tile edge, the vertices along the seams at a constant x are sorted by their z and the other way around.
+	HashMap<int, LocalVector<SeamVertex>> x_seams;
+	HashMap<int, LocalVector<SeamVertex>> z_seams;
+	LocalVector<int> vertex_x_seams;
+	LocalVector<int> vertex_z_seams;
+	vertex_x_seams.resize(r_vertices.size());
+	vertex_z_seams.resize(r_vertices.size());
+
+	for (int i = 0; i < r_vertices.size(); i++) {
+		const Vector3 &vertex = r_vertices[i];
+		const float edge_x = Math::round(vertex.x / tile_world_size) * tile_world_size;
+		const float edge_z = Math::round(vertex.z / tile_world_size) * tile_world_size;
+
+		vertex_x_seams[i] = INT_MIN;
+		if (vertex.x == edge_x) {
+			vertex_x_seams[i] = (int)Math::round(vertex.x / tile_world_size);
+			x_seams[vertex_x_seams[i]].push_back({ vertex.z, i });
+		}
+		vertex_z_seams[i] = INT_MIN;
+		if (vertex.z == edge_z) {
+			vertex_z_seams[i] = (int)Math::round(vertex.z / tile_world_size);
+			z_seams[vertex_z_seams[i]].push_back({ vertex.x, i });
+		}
+	}
+	for (KeyValue<int, LocalVector<SeamVertex>> &E : x_seams) {
+		E.value.sort();
+	}
+	for (KeyValue<int, LocalVector<SeamVertex>> &E : z_seams) {
+		E.value.sort();
+	}
+
+	const float seam_height_tolerance = MAX(p_cfg.ch, p_cfg.walkableClimb * p_cfg.ch);
+	LocalVector<SeamVertex> edge_seam_vertices;
+
+	for (int polygon_index = 0; polygon_index < r_polygons.size(); polygon_index++) {
+		const Vector<int> &polygon = r_polygons[polygon_index];
+		Vector<int> split_polygon;
+
+		for (int i = 0; i < polygon.size(); i++) {
+			const int from = polygon[i];
+			const int to = polygon[(i + 1) % polygon.size()];
+			split_polygon.push_back(from);
+
+			const LocalVector<SeamVertex> *seam = nullptr;
+			Vector3::Axis axis = Vector3::AXIS_X;
+			if (vertex_x_seams[from] != INT_MIN && vertex_x_seams[from] == vertex_x_seams[to]) {
+				seam = x_seams.getptr(vertex_x_seams[from]);
+				axis = Vector3::AXIS_Z;
+			} else if (vertex_z_seams[from] != INT_MIN && vertex_z_seams[from] == vertex_z_seams[to]) {
+				seam = z_seams.getptr(vertex_z_seams[from]);
+				axis = Vector3::AXIS_X;
+			}
+			if (!seam) {
+				continue;
+			}
+
+			const Vector3 &from_vertex = r_vertices[from];
+			const Vector3 &to_vertex = r_vertices[to];
+			const float from_position = from_vertex[axis];
+			const float to_position = to_vertex[axis];
+			const float min_position = MIN(from_position, to_position);
+			const float max_position = MAX(from_position, to_position);
+
+			// The seam vertices strictly inside the edge that are at the height of the edge.
+			edge_seam_vertices.clear();
+			for (uint32_t j = seam->span().bisect({ min_position, -1 }, false); j < seam->size() && (*seam)[j].position < max_position; j++) {
+				const SeamVertex &seam_vertex = (*seam)[j];
+				const float weight = (seam_vertex.position - from_position) / (to_position - from_position);
+				const float edge_height = Math::lerp(from_vertex.y, to_vertex.y, weight);
+				if (Math::abs(r_vertices[seam_vertex.index].y - edge_height) <= seam_height_tolerance && !polygon.has(seam_vertex.index)) {
+					edge_seam_vertices.push_back(seam_vertex);
+				}
+			}
+
+			if (from_position < to_position) {
+				for (uint32_t j = 0; j < edge_seam_vertices.size(); j++) {
+					split_polygon.push_back(edge_seam_vertices[j].index);
+				}
+			} else {
+				for (int64_t j = edge_seam_vertices.size() - 1; j >= 0; j--) {
+					split_polygon.push_back(edge_seam_vertices[j].index);
+				}
+			}
+		}
+
+		if (split_polygon.size() != polygon.size()) {
+			r_polygons.write[polygon_index] = split_polygon;
+		}
+	}
+
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_BAKE_CLEANUP;
+
+	return true;
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
@@ -42,6 +42,101 @@ using namespace Nav3D;
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+static _FORCE_INLINE_ Vector3 _polygon_get_normal(const Polygon &p_polygon) {
+	return (p_polygon.vertices[1] - p_polygon.vertices[0]).cross(p_polygon.vertices[2] - p_polygon.vertices[0]);
+}
+
+static real_t _aabb_get_distance_squared_to_point(const AABB &p_aabb, const Vector3 &p_point) {
+	return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+}
+
+static real_t _aabb_get_distance_to_aabb(const AABB &p_aabb, const AABB &p_other) {
+	const Vector3 gap = (p_aabb.position - (p_other.position + p_other.size)).max(p_other.position - (p_aabb.position + p_aabb.size));
+	return gap.maxf(0.0).length();
+}
+
+// Calls `p_polygon_callback` with the index of each polygon whose bounds are nearer than `p_closest_distance`,
+// visiting the nearest nodes first. `p_node_distance` must never return more than the distance of a polygon inside
+// the bounds, and `p_polygon_callback` is expected to lower `p_closest_distance` as it finds closer polygons.
+template <typename NodeDistance, typename PolygonCallback>
+static void _polygon_bvh_query_nearest(const PolygonBVH &p_bvh, const real_t &p_closest_distance, NodeDistance p_node_distance, PolygonCallback p_polygon_callback) {
+	if (p_bvh.is_empty()) {
+		return;
+	}
+
+	struct StackEntry {
+		uint32_t node_index;
+		real_t distance;
+	};
+
+	// The tree is balanced, so its depth stays far below this even for millions of polygons.
+	StackEntry stack[64];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = { 0, p_node_distance(p_bvh.nodes[0].bounds) };
+
+	while (stack_size > 0) {
+		const StackEntry entry = stack[--stack_size];
+		// The closest distance may have shrunk since the node was pushed.
+		if (entry.distance >= p_closest_distance) {
+			continue;
+		}
+
+		const PolygonBVH::Node &node = p_bvh.nodes[entry.node_index];
+
+		if (node.polygon_count > 0) {
+			for (uint32_t i = 0; i < node.polygon_count; i++) {
+				p_polygon_callback(p_bvh.polygon_indices[node.first + i]);
+			}
+			continue;
+		}
+
+		StackEntry near_child = { entry.node_index + 1, p_node_distance(p_bvh.nodes[entry.node_index + 1].bounds) };
+		StackEntry far_child = { node.first, p_node_distance(p_bvh.nodes[node.first].bounds) };
+		if (far_child.distance < near_child.distance) {
+			SWAP(near_child, far_child);
+		}
+
+		// Push the far child first, so the near one is visited first and prunes more.
+		if (far_child.distance < p_closest_distance) {
+			stack[stack_size++] = far_child;
+		}
+		if (near_child.distance < p_closest_distance) {
+			stack[stack_size++] = near_child;
+		}
+	}
+}
+
+static Vector3 _polygon_get_random_point_uniformly(const Polygon &p_polygon) {
+	real_t accumulated_polygon_area = 0;
+	RBMap<real_t, uint32_t> polygon_area_map;
+
+	for (uint32_t rpp_index = 2; rpp_index < p_polygon.vertices.size(); rpp_index++) {
+		real_t face_area = Face3(p_polygon.vertices[0], p_polygon.vertices[rpp_index - 1], p_polygon.vertices[rpp_index]).get_area();
+
+		if (face_area == 0.0) {
+			continue;
+		}
+		polygon_area_map[accumulated_polygon_area] = rpp_index;
+		accumulated_polygon_area += face_area;
+	}
+	if (polygon_area_map.is_empty() || accumulated_polygon_area == 0) {
+		// All faces have no real surface / no area.
+		return Vector3();
+	}
+
+	real_t polygon_area_map_pos = Math::random(real_t(0), accumulated_polygon_area);
+
+	RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
+	ERR_FAIL_COND_V(!polygon_E, Vector3());
+	uint32_t rrp_face_index = polygon_E->value;
+	ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, p_polygon.vertices.size(), Vector3());
+
+	const Face3 face(p_polygon.vertices[0], p_polygon.vertices[rrp_face_index - 1], p_polygon.vertices[rrp_face_index]);
+
+	Vector3 face_random_position = face.get_random_point_inside();
+	return face_random_position;
+}
+
 bool NavMeshQueries3D::emit_callback(const Callable &p_callback) {
 	ERR_FAIL_COND_V(!p_callback.is_valid(), false);
 
@@ -85,36 +180,7 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<Polygon> &
 		uint32_t rrp_polygon_index = region_E->value;
 		ERR_FAIL_UNSIGNED_INDEX_V(rrp_polygon_index, region_polygons.size(), Vector3());
 
-		const Polygon &rr_polygon = region_polygons[rrp_polygon_index];
-
-		real_t accumulated_polygon_area = 0;
-		RBMap<real_t, uint32_t> polygon_area_map;
-
-		for (uint32_t rpp_index = 2; rpp_index < rr_polygon.vertices.size(); rpp_index++) {
-			real_t face_area = Face3(rr_polygon.vertices[0], rr_polygon.vertices[rpp_index - 1], rr_polygon.vertices[rpp_index]).get_area();
-
-			if (face_area == 0.0) {
-				continue;
-			}
-			polygon_area_map[accumulated_polygon_area] = rpp_index;
-			accumulated_polygon_area += face_area;
-		}
-		if (polygon_area_map.is_empty() || accumulated_polygon_area == 0) {
-			// All faces have no real surface / no area.
-			return Vector3();
-		}
-
-		real_t polygon_area_map_pos = Math::random(real_t(0), accumulated_polygon_area);
-
-		RBMap<real_t, uint32_t>::Iterator polygon_E = polygon_area_map.find_closest(polygon_area_map_pos);
-		ERR_FAIL_COND_V(!polygon_E, Vector3());
-		uint32_t rrp_face_index = polygon_E->value;
-		ERR_FAIL_UNSIGNED_INDEX_V(rrp_face_index, rr_polygon.vertices.size(), Vector3());
-
-		const Face3 face(rr_polygon.vertices[0], rr_polygon.vertices[rrp_face_index - 1], rr_polygon.vertices[rrp_face_index]);
-
-		Vector3 face_random_position = face.get_random_point_inside();
-		return face_random_position;
+		return _polygon_get_random_point_uniformly(region_polygons[rrp_polygon_index]);
 
 	} else {
 		uint32_t rrp_polygon_index = Math::random(int(0), region_polygons.size() - 1);
@@ -146,18 +212,12 @@ void NavMeshQueries3D::_query_task_push_back_point_with_metadata(NavMeshPathQuer
 	p_query_task.path_points.push_back(p_point);
 }
 
-void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
-	ERR_FAIL_NULL(map);
-	ERR_FAIL_COND(p_query_parameters.is_null());
-	ERR_FAIL_COND(p_query_result.is_null());
-
+void NavMeshQueries3D::_query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
 	using namespace NavigationUtilities;
 
-	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
-	query_task.callback = p_callback;
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
 
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
@@ -165,57 +225,67 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	r_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	r_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	r_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	r_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
+
+void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback) {
+	ERR_FAIL_NULL(map);
+	ERR_FAIL_COND(p_query_parameters.is_null());
+	ERR_FAIL_COND(p_query_result.is_null());
+
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
+	_query_task_set_parameters(query_task, p_query_parameters);
+	query_task.callback = p_callback;
 
 	map->query_path(query_task);
 
@@ -235,6 +305,87 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	}
 }
 
+void NavMeshQueries3D::path_query_batch_setup(PathQueryBatch3D &r_batch, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, const Vector<Vector3> &p_start_positions, const Vector<Vector3> &p_target_positions) {
+	_query_task_set_parameters(r_batch.query_template, p_query_parameters);
+	// Batches only return points, skip collecting metadata nobody reads.
+	r_batch.query_template.metadata_flags = 0;
+
+	const uint32_t query_count = MIN(p_start_positions.size(), p_target_positions.size());
+	r_batch.start_positions.resize(query_count);
+	r_batch.target_positions.resize(query_count);
+	for (uint32_t i = 0; i < query_count; i++) {
+		r_batch.start_positions[i] = p_start_positions[i];
+		r_batch.target_positions[i] = p_target_positions[i];
+	}
+
+	r_batch.paths.resize(query_count);
+	r_batch.path_lengths.resize(query_count);
+	r_batch.processed_count = 0;
+}
+
+Dictionary NavMeshQueries3D::path_query_batch_get_result(const PathQueryBatch3D &p_batch) {
+	const uint32_t query_count = p_batch.paths.size();
+
+	PackedInt32Array path_offsets;
+	path_offsets.resize(query_count + 1);
+	int32_t *path_offsets_ptrw = path_offsets.ptrw();
+
+	int32_t point_count = 0;
+	for (uint32_t i = 0; i < query_count; i++) {
+		path_offsets_ptrw[i] = point_count;
+		point_count += p_batch.paths[i].size();
+	}
+	path_offsets_ptrw[query_count] = point_count;
+
+	PackedVector3Array path_points;
+	path_points.resize(point_count);
+	Vector3 *path_points_ptrw = path_points.ptrw();
+
+	PackedFloat32Array path_lengths;
+	path_lengths.resize(query_count);
+	float *path_lengths_ptrw = path_lengths.ptrw();
+
+	for (uint32_t i = 0; i < query_count; i++) {
+		const LocalVector<Vector3> &path = p_batch.paths[i];
+		if (!path.is_empty()) {
+			memcpy(path_points_ptrw + path_offsets_ptrw[i], path.ptr(), path.size() * sizeof(Vector3));
+		}
+		path_lengths_ptrw[i] = p_batch.path_lengths[i];
+	}
+
+	Dictionary result;
+	result["path_points"] = path_points;
+	result["path_offsets"] = path_offsets;
+	result["path_lengths"] = path_lengths;
+	return result;
+}
+
+static void _region_iteration_find_closest_face_point(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_point, real_t &r_closest_distance_squared, const Polygon *&r_polygon, Vector3 &r_position) {
+	const LocalVector<Polygon> &polygons = p_region_iteration.get_navmesh_polygons();
+
+	_polygon_bvh_query_nearest(
+			p_region_iteration.get_polygon_bvh(), r_closest_distance_squared,
+			[&p_point](const AABB &p_bounds) {
+				return _aabb_get_distance_squared_to_point(p_bounds, p_point);
+			},
+			[&](uint32_t p_polygon_index) {
+				const Polygon &polygon = polygons[p_polygon_index];
+
+				// For each face check the distance to the point.
+				for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id++) {
+					const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
+
+					const Vector3 point = face.get_closest_point_to(p_point);
+					const real_t distance_squared = point.distance_squared_to(p_point);
+					if (distance_squared < r_closest_distance_squared) {
+						r_closest_distance_squared = distance_squared;
+						r_polygon = &polygon;
+						r_position = point;
+					}
+				}
+			});
+}
+
 void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
@@ -246,34 +397,14 @@ void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask
 			continue;
 		}
 
-		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region->get_navmesh_polygons()) {
-			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
-				continue;
-			}
-
-			// For each face check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
-				const Face3 face(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
-
-				Vector3 point = face.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
-
-				point = face.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
-				}
-			}
+		// Only consider the polygons of regions with compatible layers.
+		if ((p_query_task.navigation_layers & region->get_navigation_layers()) == 0) {
+			continue;
 		}
+
+		// Find the initial poly and the end poly on this map.
+		_region_iteration_find_closest_face_point(*region.ptr(), p_query_task.start_position, begin_d, p_query_task.begin_polygon, p_query_task.begin_position);
+		_region_iteration_find_closest_face_point(*region.ptr(), p_query_task.target_position, end_d, p_query_task.end_polygon, p_query_task.end_position);
 	}
 }
 
@@ -294,8 +425,16 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	Vector3 new_entry = Geometry3D::get_closest_point_to_segment(p_least_cost_poly.entry, p_connection.pathway_start, p_connection.pathway_end);
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
+	const uint32_t neighbor_poly_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+	if (p_query_task.cluster_graph) {
+		const uint32_t neighbor_cluster = p_query_task.cluster_graph->polygon_clusters[neighbor_poly_id];
+		if (neighbor_cluster == UINT32_MAX || !p_query_task.path_query_slot->cluster_corridor[neighbor_cluster]) {
+			return;
+		}
+	}
+
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_poly_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
@@ -317,6 +456,87 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	}
 }
 
+bool NavMeshQueries3D::_query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	const ClusterGraph &cluster_graph = p_map_iteration.cluster_graph;
+	PathQuerySlot &path_query_slot = *p_query_task.path_query_slot;
+
+	const uint32_t begin_cluster = cluster_graph.polygon_clusters[path_query_slot.poly_to_id[p_query_task.begin_polygon]];
+	const uint32_t end_cluster = cluster_graph.polygon_clusters[path_query_slot.poly_to_id[p_query_task.end_polygon]];
+	if (begin_cluster == UINT32_MAX || end_cluster == UINT32_MAX) {
+		return false;
+	}
+
+	const uint32_t cluster_count = cluster_graph.clusters.size();
+	LocalVector<real_t> &traveled_costs = path_query_slot.cluster_traveled_costs;
+	LocalVector<uint32_t> &back_ids = path_query_slot.cluster_back_ids;
+	traveled_costs.resize(cluster_count);
+	back_ids.resize(cluster_count);
+	for (uint32_t cluster = 0; cluster < cluster_count; cluster++) {
+		traveled_costs[cluster] = FLT_MAX;
+		back_ids[cluster] = UINT32_MAX;
+	}
+
+	// A* over the clusters. The cluster graph is small, so stale heap entries are skipped instead of updated.
+	struct ClusterEntry {
+		uint32_t cluster = 0;
+		real_t total_cost = 0.0;
+	};
+	struct ClusterEntryGreaterThan {
+		bool operator()(const ClusterEntry &p_a, const ClusterEntry &p_b) const {
+			return p_a.total_cost > p_b.total_cost;
+		}
+	};
+	Heap<ClusterEntry, ClusterEntryGreaterThan> open_clusters;
+
+	const Vector3 &end_position = cluster_graph.clusters[end_cluster].position;
+	traveled_costs[begin_cluster] = 0.0;
+	open_clusters.push({ begin_cluster, cluster_graph.clusters[begin_cluster].position.distance_to(end_position) });
+
+	bool found_route = false;
+	while (!open_clusters.is_empty()) {
+		const ClusterEntry entry = open_clusters.pop();
+		if (entry.cluster == end_cluster) {
+			found_route = true;
+			break;
+		}
+
+		const ClusterGraph::Cluster &cluster = cluster_graph.clusters[entry.cluster];
+		if (entry.total_cost > traveled_costs[entry.cluster] + cluster.position.distance_to(end_position)) {
+			continue;
+		}
+
+		for (uint32_t edge_index = cluster.first_edge; edge_index < cluster.first_edge + cluster.edge_count; edge_index++) {
+			const ClusterGraph::Edge &edge = cluster_graph.edges[edge_index];
+			const real_t traveled_cost = traveled_costs[entry.cluster] + edge.cost;
+			if (traveled_cost < traveled_costs[edge.cluster]) {
+				traveled_costs[edge.cluster] = traveled_cost;
+				back_ids[edge.cluster] = entry.cluster;
+				open_clusters.push({ edge.cluster, traveled_cost + cluster_graph.clusters[edge.cluster].position.distance_to(end_position) });
+			}
+		}
+	}
+
+	if (!found_route) {
+		// Unreachable, the full search falls back to the closest reachable polygon.
+		return false;
+	}
+
+	// The corridor also contains the neighbors of the clusters on the route, so the polygon search has room to cut corners.
+	LocalVector<uint8_t> &cluster_corridor = path_query_slot.cluster_corridor;
+	cluster_corridor.resize(cluster_count);
+	memset(cluster_corridor.ptr(), 0, cluster_count);
+
+	for (uint32_t cluster_id = end_cluster; cluster_id != UINT32_MAX; cluster_id = back_ids[cluster_id]) {
+		cluster_corridor[cluster_id] = 1;
+		const ClusterGraph::Cluster &cluster = cluster_graph.clusters[cluster_id];
+		for (uint32_t edge_index = cluster.first_edge; edge_index < cluster.first_edge + cluster.edge_count; edge_index++) {
+			cluster_corridor[cluster_graph.edges[edge_index].cluster] = 1;
+		}
+	}
+
+	return true;
+}
+
 void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	const Vector3 p_target_position = p_query_task.target_position;
 	const Polygon *begin_poly = p_query_task.begin_polygon;
@@ -401,6 +621,13 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		// When the heap of traversable polygons is empty at this point it means the end polygon is
 		// unreachable.
 		if (traversable_polys.is_empty()) {
+			if (p_query_task.cluster_graph && !path_search_max_reached) {
+				// The whole corridor was searched without reaching the end, the route leaves the corridor and
+				// the caller searches again on the whole map. A search stopped by its limits keeps its result.
+				p_query_task.cluster_corridor_exhausted = true;
+				return;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -531,7 +758,18 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 		return;
 	}
 
-	_query_task_build_path_corridor(p_query_task, p_map_iteration);
+	bool path_corridor_built = false;
+	if (!p_map_iteration.cluster_graph.is_empty() && _query_task_build_cluster_corridor(p_query_task, p_map_iteration)) {
+		// Refine the coarse cluster path by only searching the polygons of its clusters.
+		p_query_task.cluster_graph = &p_map_iteration.cluster_graph;
+		p_query_task.cluster_corridor_exhausted = false;
+		_query_task_build_path_corridor(p_query_task, p_map_iteration);
+		p_query_task.cluster_graph = nullptr;
+		path_corridor_built = !p_query_task.cluster_corridor_exhausted;
+	}
+	if (!path_corridor_built) {
+		_query_task_build_path_corridor(p_query_task, p_map_iteration);
+	}
 
 	if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED) {
 		_query_task_process_path_result_limits(p_query_task);
@@ -879,66 +1117,96 @@ void NavMeshQueries3D::_query_task_post_process_nopostprocessing(NavMeshPathQuer
 }
 
 Vector3 NavMeshQueries3D::map_iteration_get_closest_point_to_segment(const NavMapIteration3D &p_map_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
-	bool use_collision = p_use_collision;
-	Vector3 closest_point;
-	real_t closest_point_distance = FLT_MAX;
-
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
+
+	// If the segment goes through the navigation mesh, the intersection closest to its start wins.
+	Vector3 closest_intersection;
+	real_t closest_intersection_distance_squared = FLT_MAX;
+
+	const auto intersection_distance = [&p_from, &p_to](const AABB &p_bounds) -> real_t {
+		const AABB bounds = p_bounds.grow(CMP_EPSILON);
+		if (!bounds.intersects_segment(p_from, p_to)) {
+			return FLT_MAX;
+		}
+		return _aabb_get_distance_squared_to_point(bounds, p_from);
+	};
+
 	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			// For each face check the distance to the segment.
+		const LocalVector<Polygon> &polygons = region->get_navmesh_polygons();
+
+		_polygon_bvh_query_nearest(region->get_polygon_bvh(), closest_intersection_distance_squared, intersection_distance, [&](uint32_t p_polygon_index) {
+			const Polygon &polygon = polygons[p_polygon_index];
 			for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id += 1) {
 				const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
 				Vector3 intersection_point;
 				if (face.intersects_segment(p_from, p_to, &intersection_point)) {
-					const real_t d = p_from.distance_to(intersection_point);
-					if (!use_collision) {
-						closest_point = intersection_point;
-						use_collision = true;
-						closest_point_distance = d;
-					} else if (closest_point_distance > d) {
-						closest_point = intersection_point;
-						closest_point_distance = d;
+					const real_t d = p_from.distance_squared_to(intersection_point);
+					if (d < closest_intersection_distance_squared) {
+						closest_intersection = intersection_point;
+						closest_intersection_distance_squared = d;
 					}
 				}
-				// If segment does not itersect face, check the distance from segment's endpoints.
-				else if (!use_collision) {
-					const Vector3 p_from_closest = face.get_closest_point_to(p_from);
-					const real_t d_p_from = p_from.distance_to(p_from_closest);
-					if (closest_point_distance > d_p_from) {
-						closest_point = p_from_closest;
-						closest_point_distance = d_p_from;
-					}
+			}
+		});
+	}
 
-					const Vector3 p_to_closest = face.get_closest_point_to(p_to);
-					const real_t d_p_to = p_to.distance_to(p_to_closest);
-					if (closest_point_distance > d_p_to) {
-						closest_point = p_to_closest;
-						closest_point_distance = d_p_to;
-					}
+	if (closest_intersection_distance_squared < FLT_MAX || p_use_collision) {
+		return closest_intersection;
+	}
+
+	// Otherwise, find the point of the navigation mesh closest to the segment.
+	Vector3 closest_point;
+	real_t closest_point_distance = FLT_MAX;
+
+	const AABB segment_bounds = AABB(p_from, Vector3()).expand(p_to);
+	const auto segment_distance = [&segment_bounds](const AABB &p_bounds) {
+		return _aabb_get_distance_to_aabb(p_bounds, segment_bounds);
+	};
+
+	for (const Ref<NavRegionIteration3D> &region : regions) {
+		const LocalVector<Polygon> &polygons = region->get_navmesh_polygons();
+
+		_polygon_bvh_query_nearest(region->get_polygon_bvh(), closest_point_distance, segment_distance, [&](uint32_t p_polygon_index) {
+			const Polygon &polygon = polygons[p_polygon_index];
+
+			// For each face check the distance from the segment's endpoints.
+			for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id += 1) {
+				const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
+
+				const Vector3 p_from_closest = face.get_closest_point_to(p_from);
+				const real_t d_p_from = p_from.distance_to(p_from_closest);
+				if (closest_point_distance > d_p_from) {
+					closest_point = p_from_closest;
+					closest_point_distance = d_p_from;
+				}
+
+				const Vector3 p_to_closest = face.get_closest_point_to(p_to);
+				const real_t d_p_to = p_to.distance_to(p_to_closest);
+				if (closest_point_distance > d_p_to) {
+					closest_point = p_to_closest;
+					closest_point_distance = d_p_to;
 				}
 			}
+
 			// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-			if (!use_collision) {
-				for (uint32_t point_id = 0; point_id < polygon.vertices.size(); point_id += 1) {
-					Vector3 a, b;
-
-					Geometry3D::get_closest_points_between_segments(
-							p_from,
-							p_to,
-							polygon.vertices[point_id],
-							polygon.vertices[(point_id + 1) % polygon.vertices.size()],
-							a,
-							b);
-
-					const real_t d = a.distance_to(b);
-					if (d < closest_point_distance) {
-						closest_point_distance = d;
-						closest_point = b;
-					}
+			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); point_id += 1) {
+				Vector3 a, b;
+
+				Geometry3D::get_closest_points_between_segments(
+						p_from,
+						p_to,
+						polygon.vertices[point_id],
+						polygon.vertices[(point_id + 1) % polygon.vertices.size()],
+						a,
+						b);
+
+				const real_t d = a.distance_to(b);
+				if (d < closest_point_distance) {
+					closest_point_distance = d;
+					closest_point = b;
 				}
 			}
-		}
+		});
 	}
 
 	return closest_point;
@@ -959,80 +1227,48 @@ RID NavMeshQueries3D::map_iteration_get_closest_point_owner(const NavMapIteratio
 	return cp.owner;
 }
 
+static void _region_iteration_find_closest_point(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_point, ClosestPointQueryResult &r_result, real_t &r_closest_distance_squared) {
+	const LocalVector<Polygon> &polygons = p_region_iteration.get_navmesh_polygons();
+
+	_polygon_bvh_query_nearest(
+			p_region_iteration.get_polygon_bvh(), r_closest_distance_squared,
+			[&p_point](const AABB &p_bounds) {
+				return _aabb_get_distance_squared_to_point(p_bounds, p_point);
+			},
+			[&](uint32_t p_polygon_index) {
+				const Polygon &polygon = polygons[p_polygon_index];
+				Vector3 closest_point;
+				real_t distance_squared = NavMeshQueries3D::_polygon_get_closest_point(polygon, p_point, closest_point);
+				if (distance_squared < r_closest_distance_squared) {
+					r_closest_distance_squared = distance_squared;
+					r_result.point = closest_point;
+					r_result.normal = _polygon_get_normal(polygon);
+					r_result.owner = polygon.owner->get_self();
+				}
+			});
+}
+
 ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point) {
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
 	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-			Vector3 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector3 previous = polygon.vertices[polygon.vertices.size() - 1];
-			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-				Vector3 edge = polygon.vertices[point_id] - previous;
-				Vector3 to_point = p_point - previous;
-				Vector3 edge_to_point_pormal = edge.cross(to_point);
-				bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.vertices[point_id];
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.f) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.vertices[point_id];
-			}
-
-			if (inside) {
-				Vector3 plane_normalized = plane_normal.normalized();
-				real_t distance = plane_normalized.dot(p_point - polygon.vertices[0]);
-				real_t distance_squared = distance * distance;
-				if (distance_squared < closest_point_distance_squared) {
-					closest_point_distance_squared = distance_squared;
-					result.point = p_point - plane_normalized * distance;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-
-					if (Math::is_zero_approx(distance)) {
-						break;
-					}
-				}
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-				}
-			}
-		}
+		_region_iteration_find_closest_point(*region.ptr(), p_point, result, closest_point_distance_squared);
 	}
 
 	return result;
 }
 
+ClosestPointQueryResult NavMeshQueries3D::region_iteration_get_closest_point_info(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_point) {
+	ClosestPointQueryResult result;
+	real_t closest_point_distance_squared = FLT_MAX;
+
+	_region_iteration_find_closest_point(p_region_iteration, p_point, result, closest_point_distance_squared);
+
+	return result;
+}
+
 Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly) {
 	if (p_map_iteration.region_iterations.is_empty()) {
 		return Vector3();
@@ -1084,17 +1320,52 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 
 		const Ref<NavRegionIteration3D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
 
-		return NavMeshQueries3D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return NavMeshQueries3D::region_iteration_get_random_point(*random_region.ptr(), p_navigation_layers, p_uniformly);
 
 	} else {
 		uint32_t random_region_index = Math::random(int(0), accessible_regions.size() - 1);
 
 		const Ref<NavRegionIteration3D> &random_region = p_map_iteration.region_iterations[accessible_regions[random_region_index]];
 
-		return NavMeshQueries3D::polygons_get_random_point(random_region->navmesh_polygons, p_navigation_layers, p_uniformly);
+		return NavMeshQueries3D::region_iteration_get_random_point(*random_region.ptr(), p_navigation_layers, p_uniformly);
 	}
 }
 
+Vector3 NavMeshQueries3D::region_iteration_get_random_point(const NavRegionIteration3D &p_region_iteration, uint32_t p_navigation_layers, bool p_uniformly) {
+	const LocalVector<Polygon> &region_polygons = p_region_iteration.navmesh_polygons;
+	const LocalVector<real_t> &accumulated_areas = p_region_iteration.accumulated_surface_areas;
+
+	if (!p_uniformly || accumulated_areas.size() != region_polygons.size()) {
+		return polygons_get_random_point(region_polygons, p_navigation_layers, p_uniformly);
+	}
+
+	if (region_polygons.is_empty() || accumulated_areas[accumulated_areas.size() - 1] == 0) {
+		// All polygons have no real surface / no area.
+		return Vector3();
+	}
+
+	// Binary search the prefix sums built with the region iteration instead of rebuilding an area map per call.
+	const real_t area_pos = Math::random(real_t(0), accumulated_areas[accumulated_areas.size() - 1]);
+
+	uint32_t low = 0;
+	uint32_t high = accumulated_areas.size() - 1;
+	while (low < high) {
+		const uint32_t middle = low + (high - low) / 2;
+		if (accumulated_areas[middle] > area_pos) {
+			high = middle;
+		} else {
+			low = middle + 1;
+		}
+	}
+
+	// Rounding can land the position exactly on the total, skip back over polygons without area.
+	while (low > 0 && accumulated_areas[low] == accumulated_areas[low - 1]) {
+		low--;
+	}
+
+	return _polygon_get_random_point_uniformly(region_polygons[low]);
+}
+
 Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVector<Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
 	bool use_collision = p_use_collision;
 	Vector3 closest_point;
@@ -1168,70 +1439,71 @@ Vector3 NavMeshQueries3D::polygons_get_closest_point_normal(const LocalVector<Po
 	return cp.normal;
 }
 
+real_t NavMeshQueries3D::_polygon_get_closest_point(const Polygon &p_polygon, const Vector3 &p_point, Vector3 &r_closest_point) {
+	Vector3 plane_normal = (p_polygon.vertices[1] - p_polygon.vertices[0]).cross(p_polygon.vertices[2] - p_polygon.vertices[0]);
+	Vector3 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector3 previous = p_polygon.vertices[p_polygon.vertices.size() - 1];
+	for (uint32_t point_id = 0; point_id < p_polygon.vertices.size(); ++point_id) {
+		Vector3 edge = p_polygon.vertices[point_id] - previous;
+		Vector3 to_point = p_point - previous;
+		Vector3 edge_to_point_pormal = edge.cross(to_point);
+		bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = p_polygon.vertices[point_id].distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = p_polygon.vertices[point_id];
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.f) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
+			}
+		}
+		previous = p_polygon.vertices[point_id];
+	}
+
+	if (inside) {
+		Vector3 plane_normalized = plane_normal.normalized();
+		real_t distance = plane_normalized.dot(p_point - p_polygon.vertices[0]);
+		r_closest_point = p_point - plane_normalized * distance;
+		return distance * distance;
+	}
+
+	r_closest_point = closest_on_polygon;
+	return closest_on_polygon.distance_squared_to(p_point);
+}
+
 ClosestPointQueryResult NavMeshQueries3D::polygons_get_closest_point_info(const LocalVector<Polygon> &p_polygons, const Vector3 &p_point) {
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
 
 	for (const Polygon &polygon : p_polygons) {
-		Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-		Vector3 closest_on_polygon;
-		real_t closest = FLT_MAX;
-		bool inside = true;
-		Vector3 previous = polygon.vertices[polygon.vertices.size() - 1];
-		for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-			Vector3 edge = polygon.vertices[point_id] - previous;
-			Vector3 to_point = p_point - previous;
-			Vector3 edge_to_point_pormal = edge.cross(to_point);
-			bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-			// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-			if (!clockwise) {
-				inside = false;
-				real_t point_projected_on_edge = edge.dot(to_point);
-				real_t edge_square = edge.length_squared();
-
-				if (point_projected_on_edge > edge_square) {
-					real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = polygon.vertices[point_id];
-						closest = distance;
-					}
-				} else if (point_projected_on_edge < 0.f) {
-					real_t distance = previous.distance_squared_to(p_point);
-					if (distance < closest) {
-						closest_on_polygon = previous;
-						closest = distance;
-					}
-				} else {
-					// If we project on this edge, this will be the closest point.
-					real_t percent = point_projected_on_edge / edge_square;
-					closest_on_polygon = previous + percent * edge;
-					break;
-				}
-			}
-			previous = polygon.vertices[point_id];
-		}
-
-		if (inside) {
-			Vector3 plane_normalized = plane_normal.normalized();
-			real_t distance = plane_normalized.dot(p_point - polygon.vertices[0]);
-			real_t distance_squared = distance * distance;
-			if (distance_squared < closest_point_distance_squared) {
-				closest_point_distance_squared = distance_squared;
-				result.point = p_point - plane_normalized * distance;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
-
-				if (Math::is_zero_approx(distance)) {
-					break;
-				}
-			}
-		} else {
-			real_t distance = closest_on_polygon.distance_squared_to(p_point);
-			if (distance < closest_point_distance_squared) {
-				closest_point_distance_squared = distance;
-				result.point = closest_on_polygon;
-				result.normal = plane_normal;
-				result.owner = polygon.owner->get_self();
+		Vector3 closest_point;
+		real_t distance_squared = _polygon_get_closest_point(polygon, p_point, closest_point);
+		if (distance_squared < closest_point_distance_squared) {
+			closest_point_distance_squared = distance_squared;
+			result.point = closest_point;
+			result.normal = _polygon_get_normal(polygon);
+			result.owner = polygon.owner->get_self();
+
+			if (closest_point_distance_squared < CMP_EPSILON2) {
+				break;
 			}
 		}
 	}
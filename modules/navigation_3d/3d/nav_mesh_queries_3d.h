@@ -43,6 +43,7 @@ using namespace NavigationUtilities;
 
 class NavMap3D;
 struct NavMapIteration3D;
+class NavRegionIteration3D;
 
 class NavMeshQueries3D {
 public:
@@ -52,6 +53,11 @@ public:
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+
+		// Hierarchical pathfinding.
+		LocalVector<real_t> cluster_traveled_costs;
+		LocalVector<uint32_t> cluster_back_ids;
+		LocalVector<uint8_t> cluster_corridor;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -90,6 +96,11 @@ public:
 		const Nav3D::Polygon *end_polygon = nullptr;
 		uint32_t least_cost_id = 0;
 
+		// Set while the polygon search is restricted to the clusters in `PathQuerySlot::cluster_corridor`.
+		const Nav3D::ClusterGraph *cluster_graph = nullptr;
+		// Set when the corridor search ran out of polygons before reaching the end, not when it hit a search limit.
+		bool cluster_corridor_exhausted = false;
+
 		// Map.
 		Vector3 map_up;
 		NavMap3D *map = nullptr;
@@ -122,8 +133,32 @@ public:
 		}
 	};
 
+	struct PathQueryBatch3D {
+		// Settings shared by all queries, the start and target positions come from the arrays below.
+		NavMeshPathQueryTask3D query_template;
+		LocalVector<Vector3> start_positions;
+		LocalVector<Vector3> target_positions;
+		Callable callback;
+
+		// Results, one path per query.
+		LocalVector<LocalVector<Vector3>> paths;
+		LocalVector<real_t> path_lengths;
+		// Queries before this index are done, the batch can be resumed from here.
+		uint32_t processed_count = 0;
+
+		// Set while the batch is running.
+		NavMapIteration3D *map_iteration = nullptr;
+		SafeNumeric<uint32_t> next_query_index;
+		uint64_t deadline_usec = 0;
+
+		bool is_finished() const { return processed_count >= start_positions.size(); }
+	};
+
 	static bool emit_callback(const Callable &p_callback);
 
+	// Returns the squared distance from the point to the polygon, and the closest point on it.
+	static real_t _polygon_get_closest_point(const Nav3D::Polygon &p_polygon, const Vector3 &p_point, Vector3 &r_closest_point);
+
 	static Vector3 polygons_get_random_point(const LocalVector<Nav3D::Polygon> &p_polygons, uint32_t p_navigation_layers, bool p_uniformly);
 
 	static Vector3 polygons_get_closest_point_to_segment(const LocalVector<Nav3D::Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision);
@@ -139,11 +174,19 @@ public:
 	static Nav3D::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
 
+	static Nav3D::ClosestPointQueryResult region_iteration_get_closest_point_info(const NavRegionIteration3D &p_region_iteration, const Vector3 &p_point);
+	static Vector3 region_iteration_get_random_point(const NavRegionIteration3D &p_region_iteration, uint32_t p_navigation_layers, bool p_uniformly);
+
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
 
+	static void path_query_batch_setup(PathQueryBatch3D &r_batch, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, const Vector<Vector3> &p_start_positions, const Vector<Vector3> &p_target_positions);
+	static Dictionary path_query_batch_get_result(const PathQueryBatch3D &p_batch);
+
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_build_cluster_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
@@ -34,6 +34,8 @@
 #include "../nav_region_3d.h"
 #include "nav_region_iteration_3d.h"
 
+#include "core/templates/sort_array.h"
+
 using namespace Nav3D;
 
 void NavRegionBuilder3D::build_iteration(NavRegionIterationBuild3D &r_build) {
@@ -51,6 +53,8 @@ void NavRegionBuilder3D::build_iteration(NavRegionIterationBuild3D &r_build) {
 
 	_build_step_merge_edge_connection_pairs(r_build);
 
+	_build_step_polygon_bvh(r_build);
+
 	_build_update_iteration(r_build);
 }
 
@@ -250,6 +254,97 @@ void NavRegionBuilder3D::_build_step_merge_edge_connection_pairs(NavRegionIterat
 	}
 }
 
+void NavRegionBuilder3D::_build_step_polygon_bvh(NavRegionIterationBuild3D &r_build) {
+	Ref<NavRegionIteration3D> region_iteration = r_build.region_iteration;
+	const LocalVector<Nav3D::Polygon> &navmesh_polygons = region_iteration->navmesh_polygons;
+
+	PolygonBVH &bvh = region_iteration->polygon_bvh;
+	bvh.clear();
+
+	LocalVector<real_t> &accumulated_surface_areas = region_iteration->accumulated_surface_areas;
+	accumulated_surface_areas.resize(navmesh_polygons.size());
+
+	LocalVector<AABB> polygon_bounds;
+	LocalVector<Vector3> polygon_centers;
+	polygon_bounds.resize(navmesh_polygons.size());
+	polygon_centers.resize(navmesh_polygons.size());
+
+	real_t accumulated_surface_area = 0.0;
+
+	for (uint32_t i = 0; i < navmesh_polygons.size(); i++) {
+		const Polygon &polygon = navmesh_polygons[i];
+
+		accumulated_surface_area += polygon.surface_area;
+		accumulated_surface_areas[i] = accumulated_surface_area;
+
+		// Polygons that failed to build have no vertices and can't be the closest to anything.
+		if (polygon.vertices.is_empty()) {
+			continue;
+		}
+
+		AABB bounds(polygon.vertices[0], Vector3());
+		for (uint32_t j = 1; j < polygon.vertices.size(); j++) {
+			bounds.expand_to(polygon.vertices[j]);
+		}
+		polygon_bounds[i] = bounds;
+		polygon_centers[i] = bounds.get_center();
+		bvh.polygon_indices.push_back(i);
+	}
+
+	if (bvh.polygon_indices.is_empty()) {
+		return;
+	}
+
+	bvh.nodes.reserve(bvh.polygon_indices.size() * 2 / PolygonBVH::MAX_LEAF_POLYGONS + 1);
+	_build_polygon_bvh_node(bvh, polygon_bounds, polygon_centers, 0, bvh.polygon_indices.size());
+}
+
+uint32_t NavRegionBuilder3D::_build_polygon_bvh_node(PolygonBVH &r_bvh, const LocalVector<AABB> &p_polygon_bounds, const LocalVector<Vector3> &p_polygon_centers, uint32_t p_begin, uint32_t p_end) {
+	const uint32_t node_index = r_bvh.nodes.size();
+	r_bvh.nodes.push_back(PolygonBVH::Node());
+
+	uint32_t *indices = r_bvh.polygon_indices.ptr();
+
+	AABB bounds = p_polygon_bounds[indices[p_begin]];
+	AABB center_bounds(p_polygon_centers[indices[p_begin]], Vector3());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		bounds.merge_with(p_polygon_bounds[indices[i]]);
+		center_bounds.expand_to(p_polygon_centers[indices[i]]);
+	}
+	r_bvh.nodes[node_index].bounds = bounds;
+
+	if (p_end - p_begin <= PolygonBVH::MAX_LEAF_POLYGONS) {
+		r_bvh.nodes[node_index].first = p_begin;
+		r_bvh.nodes[node_index].polygon_count = p_end - p_begin;
+		return node_index;
+	}
+
+	// Split at the median along the longest axis of the polygon centers.
+	const Vector3::Axis axis = Vector3::Axis(center_bounds.get_longest_axis_index());
+	const uint32_t middle = p_begin + (p_end - p_begin) / 2;
+
+	struct CenterComparator {
+		const Vector3 *centers = nullptr;
+		Vector3::Axis axis = Vector3::AXIS_X;
+
+		bool operator()(uint32_t p_a, uint32_t p_b) const {
+			return centers[p_a][axis] < centers[p_b][axis];
+		}
+	};
+
+	SortArray<uint32_t, CenterComparator> sorter;
+	sorter.compare.centers = p_polygon_centers.ptr();
+	sorter.compare.axis = axis;
+	sorter.nth_element(p_begin, p_end, middle, indices);
+
+	_build_polygon_bvh_node(r_bvh, p_polygon_bounds, p_polygon_centers, p_begin, middle);
+	const uint32_t second_child = _build_polygon_bvh_node(r_bvh, p_polygon_bounds, p_polygon_centers, middle, p_end);
+
+	r_bvh.nodes[node_index].first = second_child;
+	r_bvh.nodes[node_index].polygon_count = 0;
+	return node_index;
+}
+
 void NavRegionBuilder3D::_build_update_iteration(NavRegionIterationBuild3D &r_build) {
 	ERR_FAIL_NULL(r_build.region);
 	// Stub. End of the build.
@@ -78,14 +78,20 @@ public:
 	real_t surface_area = 0.0;
 	AABB bounds;
 	LocalVector<Nav3D::ConnectableEdge> external_edges;
+	Nav3D::PolygonBVH polygon_bvh;
+	// The surface area of the polygons up to and including each polygon, to pick random points uniformly.
+	LocalVector<real_t> accumulated_surface_areas;
 
 	const Transform3D &get_transform() const { return transform; }
 	real_t get_surface_area() const { return surface_area; }
 	AABB get_bounds() const { return bounds; }
 	const LocalVector<Nav3D::ConnectableEdge> &get_external_edges() const { return external_edges; }
+	const Nav3D::PolygonBVH &get_polygon_bvh() const { return polygon_bvh; }
 
 	virtual ~NavRegionIteration3D() override {
 		external_edges.clear();
+		polygon_bvh.clear();
+		accumulated_surface_areas.clear();
 		navmesh_polygons.clear();
 		internal_connections.clear();
 	}
@@ -126,6 +126,23 @@ void NavMap3D::set_link_connection_radius(real_t p_link_connection_radius) {
 	iteration_dirty = true;
 }
 
+void NavMap3D::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	iteration_dirty = true;
+}
+
+void NavMap3D::set_hierarchical_cluster_size(real_t p_cluster_size) {
+	ERR_FAIL_COND_MSG(p_cluster_size <= 0.0, "Hierarchical cluster size must be greater than zero.");
+	if (hierarchical_cluster_size == p_cluster_size) {
+		return;
+	}
+	hierarchical_cluster_size = p_cluster_size;
+	iteration_dirty = true;
+}
+
 const Vector3 &NavMap3D::get_merge_rasterizer_cell_size() const {
 	return merge_rasterizer_cell_size;
 }
@@ -143,41 +160,153 @@ PointKey NavMap3D::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
-	if (iteration_id == 0) {
-		return;
-	}
+NavMeshQueries3D::PathQuerySlot *NavMap3D::_acquire_path_query_slot(NavMapIteration3D &p_map_iteration) {
+	p_map_iteration.path_query_slots_semaphore.wait();
 
-	GET_MAP_ITERATION();
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = nullptr;
 
-	map_iteration.path_query_slots_semaphore.wait();
-
-	map_iteration.path_query_slots_mutex.lock();
-	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : p_map_iteration.path_query_slots) {
 		if (!p_path_query_slot.in_use) {
 			p_path_query_slot.in_use = true;
-			p_query_task.path_query_slot = &p_path_query_slot;
+			path_query_slot = &p_path_query_slot;
 			break;
 		}
 	}
-	map_iteration.path_query_slots_mutex.unlock();
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	if (path_query_slot == nullptr) {
+		p_map_iteration.path_query_slots_semaphore.post();
+		ERR_FAIL_NULL_V_MSG(path_query_slot, nullptr, "No unused NavMap3D path query slot found! This should never happen :(.");
+	}
+
+	return path_query_slot;
+}
+
+void NavMap3D::_release_path_query_slot(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot) {
+	p_map_iteration.path_query_slots_mutex.lock();
+	uint32_t used_slot_index = p_path_query_slot->slot_index;
+	p_map_iteration.path_query_slots[used_slot_index].in_use = false;
+	p_map_iteration.path_query_slots_mutex.unlock();
+
+	p_map_iteration.path_query_slots_semaphore.post();
+}
+
+void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
+	if (iteration_id == 0) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
 
+	p_query_task.path_query_slot = _acquire_path_query_slot(map_iteration);
 	if (p_query_task.path_query_slot == nullptr) {
-		map_iteration.path_query_slots_semaphore.post();
-		ERR_FAIL_NULL_MSG(p_query_task.path_query_slot, "No unused NavMap3D path query slot found! This should never happen :(.");
+		return;
 	}
 
 	p_query_task.map_up = map_iteration.map_up;
 
 	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
 
-	map_iteration.path_query_slots_mutex.lock();
-	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
-	map_iteration.path_query_slots[used_slot_index].in_use = false;
+	_release_path_query_slot(map_iteration, p_query_task.path_query_slot);
 	p_query_task.path_query_slot = nullptr;
-	map_iteration.path_query_slots_mutex.unlock();
+}
+
+void NavMap3D::_query_path_batch_worker(uint32_t p_worker_index, NavMeshQueries3D::PathQueryBatch3D *p_batch) {
+	NavMapIteration3D &map_iteration = *p_batch->map_iteration;
+
+	// Each worker keeps one slot and one task for all its queries, so their buffers are only allocated once.
+	NavMeshQueries3D::NavMeshPathQueryTask3D query_task = p_batch->query_template;
+	query_task.path_query_slot = _acquire_path_query_slot(map_iteration);
+	if (query_task.path_query_slot == nullptr) {
+		return;
+	}
+	query_task.map_up = map_iteration.map_up;
+
+	const uint32_t query_count = p_batch->start_positions.size();
+	while (true) {
+		// Check the deadline before taking an index, so every taken index gets processed.
+		if (p_batch->deadline_usec != 0 && OS::get_singleton()->get_ticks_usec() >= p_batch->deadline_usec) {
+			break;
+		}
+
+		const uint32_t query_index = p_batch->next_query_index.postincrement();
+		if (query_index >= query_count) {
+			break;
+		}
+
+		query_task.start_position = p_batch->start_positions[query_index];
+		query_task.target_position = p_batch->target_positions[query_index];
+		query_task.begin_polygon = nullptr;
+		query_task.end_polygon = nullptr;
+		query_task.path_length = 0.0;
+		query_task.status = NavMeshQueries3D::NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+
+		NavMeshQueries3D::query_task_map_iteration_get_path(query_task, map_iteration);
+
+		p_batch->paths[query_index] = query_task.path_points;
+		p_batch->path_lengths[query_index] = query_task.path_length;
+	}
+
+	_release_path_query_slot(map_iteration, query_task.path_query_slot);
+}
+
+void NavMap3D::query_path_batch(NavMeshQueries3D::PathQueryBatch3D &p_batch, uint64_t p_deadline_usec) {
+	if (iteration_id == 0 || p_batch.is_finished()) {
+		return;
+	}
+
+	GET_MAP_ITERATION();
+
+	p_batch.map_iteration = &map_iteration;
+	p_batch.next_query_index.set(p_batch.processed_count);
+	p_batch.deadline_usec = p_deadline_usec;
+
+	// More workers than path query slots would only wait on each other.
+	const uint32_t query_count = p_batch.start_positions.size();
+	const uint32_t worker_count = MIN(query_count - p_batch.processed_count, (uint32_t)path_query_slots_max);
+
+	if (use_threads && worker_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_query_path_batch_worker, &p_batch, worker_count, worker_count, true, SNAME("NavMapPathQueryBatch3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_query_path_batch_worker(0, &p_batch);
+	}
 
-	map_iteration.path_query_slots_semaphore.post();
+	p_batch.processed_count = MIN(p_batch.next_query_index.get(), query_count);
+	p_batch.map_iteration = nullptr;
+}
+
+void NavMap3D::add_path_query_batch(NavMeshQueries3D::PathQueryBatch3D *p_batch) {
+	MutexLock lock(path_query_batches_mutex);
+	path_query_batches.push_back(p_batch);
+}
+
+void NavMap3D::process_path_query_batches(uint64_t p_deadline_usec, LocalVector<NavMeshQueries3D::PathQueryBatch3D *> &r_finished_batches) {
+	MutexLock lock(path_query_batches_mutex);
+
+	// Batches are processed in submission order, a batch that runs out of time is resumed on the next step.
+	uint32_t finished_count = 0;
+	for (NavMeshQueries3D::PathQueryBatch3D *batch : path_query_batches) {
+		if (p_deadline_usec != 0 && OS::get_singleton()->get_ticks_usec() >= p_deadline_usec) {
+			break;
+		}
+
+		query_path_batch(*batch, p_deadline_usec);
+		if (!batch->is_finished()) {
+			break;
+		}
+
+		r_finished_batches.push_back(batch);
+		finished_count++;
+	}
+
+	if (finished_count > 0) {
+		for (uint32_t i = finished_count; i < path_query_batches.size(); i++) {
+			path_query_batches[i - finished_count] = path_query_batches[i];
+		}
+		path_query_batches.resize(path_query_batches.size() - finished_count);
+	}
 }
 
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -368,6 +497,8 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.use_hierarchical_pathfinding = get_use_hierarchical_pathfinding();
+	iteration_build.hierarchical_cluster_size = get_hierarchical_cluster_size();
 
 	next_map_iteration.clear();
 
@@ -414,6 +545,12 @@ void NavMap3D::_sync_iteration() {
 
 	performance_data.pm_edge_connection_count = iteration_build.performance_data.pm_edge_connection_count;
 	performance_data.pm_edge_free_count = iteration_build.performance_data.pm_edge_free_count;
+	performance_data.pm_sync_usec = iteration_build.performance_data.pm_sync_usec;
+	performance_data.pm_sync_edge_connection_usec = iteration_build.performance_data.pm_sync_edge_connection_usec;
+	performance_data.pm_sync_link_connection_usec = iteration_build.performance_data.pm_sync_link_connection_usec;
+	performance_data.pm_sync_region_rebuild_count = iteration_build.performance_data.pm_sync_region_rebuild_count;
+	performance_data.pm_sync_edge_merge_count = iteration_build.performance_data.pm_sync_edge_merge_count;
+	performance_data.pm_sync_link_rebuild_count = iteration_build.performance_data.pm_sync_link_rebuild_count;
 
 	iteration_id = iteration_id % UINT32_MAX + 1;
 
@@ -559,80 +696,260 @@ void NavMap3D::_update_rvo_obstacles_tree_2d() {
 	rvo_simulation_2d.kdTree_->buildObstacleTree(raw_obstacles);
 }
 
-void NavMap3D::_update_rvo_agents_tree_2d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_2d_avoidance_agents.size());
+static _FORCE_INLINE_ Vector3i _avoidance_grid_get_cell(const Nav3D::AvoidanceAgentGrid &p_grid, float p_x, float p_y, float p_z) {
+	return Vector3i(int32_t(Math::floor(p_x / p_grid.cell_size)), int32_t(Math::floor(p_y / p_grid.cell_size)), int32_t(Math::floor(p_z / p_grid.cell_size)));
+}
+
+static _FORCE_INLINE_ uint32_t _avoidance_grid_get_bucket(const Nav3D::AvoidanceAgentGrid &p_grid, const Vector3i &p_cell) {
+	uint32_t hash = hash_murmur3_one_32(uint32_t(p_cell.x));
+	hash = hash_murmur3_one_32(uint32_t(p_cell.y), hash);
+	hash = hash_murmur3_one_32(uint32_t(p_cell.z), hash);
+	return hash_fmix32(hash) & p_grid.bucket_mask;
+}
+
+// Sorts the agents by bucket. `p_get_position` returns the position of the agent at an index of the active agents.
+template <typename F>
+static void _avoidance_grid_build(Nav3D::AvoidanceAgentGrid &r_grid, uint32_t p_agent_count, bool p_use_y, float p_max_radius, float p_max_neighbor_distance, F p_get_position) {
+	r_grid.clear();
+	if (p_agent_count == 0) {
+		return;
+	}
+
+	AABB bounds(p_get_position(0), Vector3());
+	for (uint32_t i = 1; i < p_agent_count; i++) {
+		bounds.expand_to(p_get_position(i));
+	}
+
+	// Aim for a few agents per cell on average. The cells should not be smaller than the agents,
+	// nor larger than the neighbor distance as the search already ends there.
+	const float extent_x = MAX(float(bounds.size.x), p_max_radius);
+	const float extent_z = MAX(float(bounds.size.z), p_max_radius);
+	float agent_spacing;
+	if (p_use_y) {
+		const float extent_y = MAX(float(bounds.size.y), p_max_radius);
+		agent_spacing = Math::pow(extent_x * extent_y * extent_z / p_agent_count, 1.0f / 3.0f);
+	} else {
+		agent_spacing = Math::sqrt(extent_x * extent_z / p_agent_count);
+	}
+	float cell_size = MIN(agent_spacing * 2.0f, p_max_neighbor_distance);
+	cell_size = MAX(cell_size, p_max_radius * 2.0f);
+	cell_size = MAX(cell_size, 0.01f);
+
+	// Clustered agents with a few far away ones would spread over many empty cells, which a search may need to visit.
+	// Keeps the number of cells in the bounds proportional to the number of agents.
+	const float max_cell_count = 8.0f * p_agent_count;
+	float cell_count = (float(bounds.size.x) / cell_size + 1.0f) * (float(bounds.size.z) / cell_size + 1.0f);
+	if (p_use_y) {
+		cell_count *= float(bounds.size.y) / cell_size + 1.0f;
+	}
+	if (cell_count > max_cell_count) {
+		cell_size *= Math::pow(cell_count / max_cell_count, p_use_y ? 1.0f / 3.0f : 0.5f);
+	}
+	r_grid.cell_size = cell_size;
+
+	r_grid.bucket_mask = next_power_of_2(p_agent_count) - 1;
+	r_grid.bucket_offsets.resize(r_grid.bucket_mask + 2);
+	memset(r_grid.bucket_offsets.ptr(), 0, r_grid.bucket_offsets.size() * sizeof(uint32_t));
+
+	const Vector3 bounds_end = bounds.get_end();
+	r_grid.cell_min = _avoidance_grid_get_cell(r_grid, bounds.position.x, p_use_y ? bounds.position.y : 0.0f, bounds.position.z);
+	r_grid.cell_max = _avoidance_grid_get_cell(r_grid, bounds_end.x, p_use_y ? bounds_end.y : 0.0f, bounds_end.z);
+
+	for (uint32_t i = 0; i < p_agent_count; i++) {
+		const Vector3 position = p_get_position(i);
+		const Vector3i cell = _avoidance_grid_get_cell(r_grid, position.x, p_use_y ? position.y : 0.0f, position.z);
+		r_grid.bucket_offsets[_avoidance_grid_get_bucket(r_grid, cell) + 1]++;
+	}
+	for (uint32_t bucket = 1; bucket < r_grid.bucket_offsets.size(); bucket++) {
+		r_grid.bucket_offsets[bucket] += r_grid.bucket_offsets[bucket - 1];
+	}
+
+	r_grid.agent_cells.resize(p_agent_count);
+	r_grid.agent_positions_x.resize(p_agent_count);
+	r_grid.agent_positions_y.resize(p_agent_count);
+	r_grid.agent_positions_z.resize(p_agent_count);
+	r_grid.agent_indices.resize(p_agent_count);
+
+	// Scatters the agents using the bucket offsets as write cursors, which leaves each offset at the start of the next bucket.
+	for (uint32_t i = 0; i < p_agent_count; i++) {
+		const Vector3 position = p_get_position(i);
+		const Vector3i cell = _avoidance_grid_get_cell(r_grid, position.x, p_use_y ? position.y : 0.0f, position.z);
+		const uint32_t sorted_index = r_grid.bucket_offsets[_avoidance_grid_get_bucket(r_grid, cell)]++;
+		r_grid.agent_cells[sorted_index] = cell;
+		r_grid.agent_positions_x[sorted_index] = position.x;
+		r_grid.agent_positions_y[sorted_index] = p_use_y ? float(position.y) : 0.0f;
+		r_grid.agent_positions_z[sorted_index] = position.z;
+		r_grid.agent_indices[sorted_index] = i;
+	}
+	for (uint32_t bucket = r_grid.bucket_offsets.size() - 1; bucket > 0; bucket--) {
+		r_grid.bucket_offsets[bucket] = r_grid.bucket_offsets[bucket - 1];
+	}
+	r_grid.bucket_offsets[0] = 0;
+}
+
+// Calls `p_callback` with the index of every agent closer than the range, visiting the cells ring by ring
+// so the callback can shrink the range once the closest agents are found.
+template <typename F>
+static void _avoidance_grid_query(const Nav3D::AvoidanceAgentGrid &p_grid, float p_x, float p_y, float p_z, float &r_range_sq, F p_callback) {
+	const Vector3i center = _avoidance_grid_get_cell(p_grid, p_x, p_y, p_z);
+
+	int32_t max_ring = 0;
+	for (int axis = 0; axis < 3; axis++) {
+		max_ring = MAX(max_ring, MAX(center[axis] - p_grid.cell_min[axis], p_grid.cell_max[axis] - center[axis]));
+	}
+
+	for (int32_t ring = 0; ring <= max_ring; ring++) {
+		// The position is inside the center cell, so no cell of the ring is closer than this.
+		const float ring_distance = (ring - 1) * p_grid.cell_size;
+		if (ring > 1 && ring_distance * ring_distance >= r_range_sq) {
+			break;
+		}
+
+		const Vector3i from = (center - Vector3i(ring, ring, ring)).max(p_grid.cell_min);
+		const Vector3i to = (center + Vector3i(ring, ring, ring)).min(p_grid.cell_max);
+
+		for (int32_t x = from.x; x <= to.x; x++) {
+			for (int32_t y = from.y; y <= to.y; y++) {
+				// Inside the ring only the cells on its two z faces are visited.
+				const bool on_ring = Math::abs(x - center.x) == ring || Math::abs(y - center.y) == ring;
+				const int32_t z_step = on_ring ? 1 : ring * 2;
+
+				for (int32_t z = on_ring ? from.z : center.z - ring; z <= to.z; z += z_step) {
+					if (z < from.z) {
+						continue;
+					}
+
+					const Vector3i cell(x, y, z);
+					const uint32_t bucket = _avoidance_grid_get_bucket(p_grid, cell);
+					const uint32_t bucket_end = p_grid.bucket_offsets[bucket + 1];
+
+					for (uint32_t i = p_grid.bucket_offsets[bucket]; i < bucket_end; i++) {
+						if (p_grid.agent_cells[i] != cell) {
+							continue;
+						}
+						const float dx = p_grid.agent_positions_x[i] - p_x;
+						const float dy = p_grid.agent_positions_y[i] - p_y;
+						const float dz = p_grid.agent_positions_z[i] - p_z;
+						if (dx * dx + dy * dy + dz * dz < r_range_sq) {
+							p_callback(p_grid.agent_indices[i]);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void NavMap3D::_update_avoidance_grid_2d() {
+	float max_radius = 0.0f;
+	float max_neighbor_distance = 0.0f;
 	for (NavAgent3D *agent : active_2d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_2d());
+		max_radius = MAX(max_radius, agent->get_rvo_agent_2d()->radius_);
+		max_neighbor_distance = MAX(max_neighbor_distance, agent->get_rvo_agent_2d()->neighborDist_);
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+
+	NavAgent3D **agents = active_2d_avoidance_agents.ptr();
+	_avoidance_grid_build(avoidance_grid_2d, active_2d_avoidance_agents.size(), false, max_radius, max_neighbor_distance, [agents](uint32_t p_index) {
+		const RVO2D::Vector2 &position = agents[p_index]->get_rvo_agent_2d()->position_;
+		return Vector3(position.x(), 0.0, position.y());
+	});
 }
 
-void NavMap3D::_update_rvo_agents_tree_3d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO3D::Agent3D *> raw_agents;
-	raw_agents.reserve(active_3d_avoidance_agents.size());
+void NavMap3D::_update_avoidance_grid_3d() {
+	float max_radius = 0.0f;
+	float max_neighbor_distance = 0.0f;
 	for (NavAgent3D *agent : active_3d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_3d());
+		max_radius = MAX(max_radius, agent->get_rvo_agent_3d()->radius_);
+		max_neighbor_distance = MAX(max_neighbor_distance, agent->get_rvo_agent_3d()->neighborDist_);
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+
+	NavAgent3D **agents = active_3d_avoidance_agents.ptr();
+	_avoidance_grid_build(avoidance_grid_3d, active_3d_avoidance_agents.size(), true, max_radius, max_neighbor_distance, [agents](uint32_t p_index) {
+		const RVO3D::Vector3 &position = agents[p_index]->get_rvo_agent_3d()->position_;
+		return Vector3(position.x(), position.y(), position.z());
+	});
 }
 
 void NavMap3D::_update_rvo_simulation() {
 	if (obstacles_dirty) {
 		_update_rvo_obstacles_tree_2d();
 	}
-	if (agents_dirty) {
-		_update_rvo_agents_tree_2d();
-		_update_rvo_agents_tree_3d();
-	}
 }
 
 void NavMap3D::compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-	(*(agent + index))->update();
+	RVO2D::Agent2D *rvo_agent = (*(agent + index))->get_rvo_agent_2d();
+
+	// Same as RVO2D::Agent2D::computeNeighbors() but with the agent neighbors from the avoidance grid.
+	rvo_agent->obstacleNeighbors_.clear();
+	float range_sq = RVO2D::sqr(rvo_agent->timeHorizonObst_ * rvo_agent->maxSpeed_ + rvo_agent->radius_);
+	rvo_simulation_2d.kdTree_->computeObstacleNeighbors(rvo_agent, range_sq);
+
+	rvo_agent->agentNeighbors_.clear();
+	if (rvo_agent->maxNeighbors_ > 0) {
+		range_sq = RVO2D::sqr(rvo_agent->neighborDist_);
+		_avoidance_grid_query(avoidance_grid_2d, rvo_agent->position_.x(), 0.0f, rvo_agent->position_.y(), range_sq, [&](uint32_t p_index) {
+			rvo_agent->insertAgentNeighbor((*(agent + p_index))->get_rvo_agent_2d(), range_sq);
+		});
+	}
+
+	rvo_agent->computeNewVelocity(&rvo_simulation_2d);
 }
 
 void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-	(*(agent + index))->update();
+	RVO3D::Agent3D *rvo_agent = (*(agent + index))->get_rvo_agent_3d();
+
+	// Same as RVO3D::Agent3D::computeNeighbors() but with the agent neighbors from the avoidance grid.
+	rvo_agent->agentNeighbors_.clear();
+	if (rvo_agent->maxNeighbors_ > 0) {
+		float range_sq = rvo_agent->neighborDist_ * rvo_agent->neighborDist_;
+		_avoidance_grid_query(avoidance_grid_3d, rvo_agent->position_.x(), rvo_agent->position_.y(), rvo_agent->position_.z(), range_sq, [&](uint32_t p_index) {
+			rvo_agent->insertAgentNeighbor((*(agent + p_index))->get_rvo_agent_3d(), range_sq);
+		});
+	}
+
+	rvo_agent->computeNewVelocity(&rvo_simulation_3d);
 }
 
 void NavMap3D::step(double p_delta_time) {
 	rvo_simulation_2d.setTimeStep(float(p_delta_time));
 	rvo_simulation_3d.setTimeStep(float(p_delta_time));
 
+	// The new velocities are only applied once all agents computed theirs, so agents never see neighbors that already moved this step.
+
 	if (active_2d_avoidance_agents.size() > 0) {
+		_update_avoidance_grid_2d();
+
 		if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent3D *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
+			for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+				compute_single_avoidance_step_2d(i, active_2d_avoidance_agents.ptr());
 			}
 		}
+
+		for (NavAgent3D *agent : active_2d_avoidance_agents) {
+			agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+			agent->update();
+		}
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
+		_update_avoidance_grid_3d();
+
 		if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
-			for (NavAgent3D *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
+			for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+				compute_single_avoidance_step_3d(i, active_3d_avoidance_agents.ptr());
 			}
 		}
+
+		for (NavAgent3D *agent : active_3d_avoidance_agents) {
+			agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+			agent->update();
+		}
 	}
 }
 
@@ -889,6 +1206,14 @@ NavMap3D::~NavMap3D() {
 		iteration_build_thread_task_id = WorkerThreadPool::INVALID_TASK_ID;
 	}
 
+	{
+		MutexLock lock(path_query_batches_mutex);
+		for (NavMeshQueries3D::PathQueryBatch3D *batch : path_query_batches) {
+			memdelete(batch);
+		}
+		path_query_batches.clear();
+	}
+
 	RWLockWrite write_lock(iteration_slot_rwlock);
 	for (NavMapIteration3D &iteration_slot : iteration_slots) {
 		iteration_slot.clear();
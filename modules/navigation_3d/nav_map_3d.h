@@ -71,6 +71,10 @@ class NavMap3D : public NavRid3D {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = NavigationDefaults3D::LINK_CONNECTION_RADIUS;
 
+	/// Path queries search a coarse graph of polygon clusters first when enabled.
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_cluster_size = NavigationDefaults3D::HIERARCHICAL_CLUSTER_SIZE;
+
 	bool map_settings_dirty = true;
 
 	/// Map regions
@@ -87,6 +91,10 @@ class NavMap3D : public NavRid3D {
 	LocalVector<NavAgent3D *> active_2d_avoidance_agents;
 	LocalVector<NavAgent3D *> active_3d_avoidance_agents;
 
+	/// Spatial hashes of the avoidance controlled agents, rebuilt each step to gather the agent neighbors.
+	Nav3D::AvoidanceAgentGrid avoidance_grid_2d;
+	Nav3D::AvoidanceAgentGrid avoidance_grid_3d;
+
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
@@ -137,6 +145,10 @@ class NavMap3D : public NavRid3D {
 
 	int path_query_slots_max = 4;
 
+	/// Path query batches with a callback, processed within the server time budget each physics step.
+	LocalVector<NavMeshQueries3D::PathQueryBatch3D *> path_query_batches;
+	Mutex path_query_batches_mutex;
+
 	bool use_async_iterations = true;
 
 	uint32_t iteration_slot_index = 0;
@@ -154,6 +166,10 @@ class NavMap3D : public NavRid3D {
 	void _build_iteration();
 	void _sync_iteration();
 
+	NavMeshQueries3D::PathQuerySlot *_acquire_path_query_slot(NavMapIteration3D &p_map_iteration);
+	void _release_path_query_slot(NavMapIteration3D &p_map_iteration, NavMeshQueries3D::PathQuerySlot *p_path_query_slot);
+	void _query_path_batch_worker(uint32_t p_worker_index, NavMeshQueries3D::PathQueryBatch3D *p_batch);
+
 public:
 	NavMap3D();
 	~NavMap3D();
@@ -193,11 +209,26 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_hierarchical_cluster_size(real_t p_cluster_size);
+	real_t get_hierarchical_cluster_size() const {
+		return hierarchical_cluster_size;
+	}
+
 	Nav3D::PointKey get_point_key(const Vector3 &p_pos) const;
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
 
+	// Runs the remaining queries of the batch until done or until `p_deadline_usec` (if not zero) has passed.
+	void query_path_batch(NavMeshQueries3D::PathQueryBatch3D &p_batch, uint64_t p_deadline_usec);
+	void add_path_query_batch(NavMeshQueries3D::PathQueryBatch3D *p_batch);
+	void process_path_query_batches(uint64_t p_deadline_usec, LocalVector<NavMeshQueries3D::PathQueryBatch3D *> &r_finished_batches);
+
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -249,6 +280,12 @@ public:
 	int get_pm_edge_connection_count() const { return performance_data.pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return performance_data.pm_edge_free_count; }
 	int get_pm_obstacle_count() const { return performance_data.pm_obstacle_count; }
+	int get_pm_sync_usec() const { return performance_data.pm_sync_usec; }
+	int get_pm_sync_edge_connection_usec() const { return performance_data.pm_sync_edge_connection_usec; }
+	int get_pm_sync_link_connection_usec() const { return performance_data.pm_sync_link_connection_usec; }
+	int get_pm_sync_region_rebuild_count() const { return performance_data.pm_sync_region_rebuild_count; }
+	int get_pm_sync_edge_merge_count() const { return performance_data.pm_sync_edge_merge_count; }
+	int get_pm_sync_link_rebuild_count() const { return performance_data.pm_sync_link_rebuild_count; }
 
 	int get_region_connections_count(NavRegion3D *p_region) const;
 	Vector3 get_region_connection_pathway_start(NavRegion3D *p_region, int p_connection_id) const;
@@ -279,12 +316,12 @@ private:
 
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent);
+	void _update_avoidance_grid_2d();
+	void _update_avoidance_grid_3d();
 
 	void _sync_avoidance();
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
-	void _update_rvo_agents_tree_2d();
-	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
 };
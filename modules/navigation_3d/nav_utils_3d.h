@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/math/aabb.h"
 #include "core/math/vector3.h"
+#include "core/math/vector3i.h"
 #include "core/object/ref_counted.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
@@ -105,6 +107,91 @@ struct Polygon {
 	real_t surface_area = 0.0;
 };
 
+/// Bounding volume hierarchy over the polygons of a region, to only test the polygons near a query.
+struct PolygonBVH {
+	static constexpr uint32_t MAX_LEAF_POLYGONS = 4;
+
+	struct Node {
+		AABB bounds;
+		/// Leaves reference `polygon_count` polygons starting at `first` in `polygon_indices`.
+		/// Inner nodes have no polygons, their first child follows them and their second child is at `first`.
+		uint32_t first = 0;
+		uint32_t polygon_count = 0;
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<uint32_t> polygon_indices;
+
+	bool is_empty() const { return nodes.is_empty(); }
+
+	void clear() {
+		nodes.clear();
+		polygon_indices.clear();
+	}
+};
+
+/// Coarse graph over spatial clusters of polygons, searched before the polygon graph by hierarchical path queries.
+struct ClusterGraph {
+	struct Cluster {
+		/// Average of the centers of the cluster polygons.
+		Vector3 position;
+		/// The outgoing edges of the cluster are `edge_count` edges starting at `first_edge` in `edges`.
+		uint32_t first_edge = 0;
+		uint32_t edge_count = 0;
+	};
+
+	struct Edge {
+		uint32_t cluster = 0;
+		/// Distance from the cluster position to the target cluster position through their shared portal.
+		real_t cost = 0.0;
+	};
+
+	LocalVector<Cluster> clusters;
+	LocalVector<Edge> edges;
+	/// Cluster of each polygon, indexed like the path query slot polygons. UINT32_MAX for polygons without vertices.
+	LocalVector<uint32_t> polygon_clusters;
+
+	bool is_empty() const { return clusters.is_empty(); }
+
+	void clear() {
+		clusters.clear();
+		edges.clear();
+		polygon_clusters.clear();
+	}
+};
+
+/// Spatial hash of the avoidance agents, searched ring by ring around an agent to gather its agent neighbors.
+/// Agents are sorted by hash bucket and their cells and positions are kept in separate arrays for the distance tests.
+struct AvoidanceAgentGrid {
+	float cell_size = 1.0f;
+	/// Inclusive range of the cells that contain agents.
+	Vector3i cell_min;
+	Vector3i cell_max;
+
+	/// The agents of bucket `b` range from `bucket_offsets[b]` to `bucket_offsets[b + 1]`, there are `bucket_mask + 1` buckets.
+	uint32_t bucket_mask = 0;
+	LocalVector<uint32_t> bucket_offsets;
+
+	LocalVector<Vector3i> agent_cells;
+	LocalVector<float> agent_positions_x;
+	LocalVector<float> agent_positions_y;
+	LocalVector<float> agent_positions_z;
+	/// Index of each agent in the active avoidance agents of the map.
+	LocalVector<uint32_t> agent_indices;
+
+	bool is_empty() const { return agent_indices.is_empty(); }
+
+	void clear() {
+		bucket_mask = 0;
+		bucket_offsets.clear();
+		agent_cells.clear();
+		agent_positions_x.clear();
+		agent_positions_y.clear();
+		agent_positions_z.clear();
+		agent_indices.clear();
+	}
+};
+
 struct NavigationPoly {
 	/// This poly.
 	const Polygon *poly = nullptr;
@@ -191,6 +278,13 @@ struct PerformanceData {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	// Timings and counts of the last map iteration build.
+	int pm_sync_usec = 0;
+	int pm_sync_edge_connection_usec = 0;
+	int pm_sync_link_connection_usec = 0;
+	int pm_sync_region_rebuild_count = 0;
+	int pm_sync_edge_merge_count = 0;
+	int pm_sync_link_rebuild_count = 0;
 
 	void reset() {
 		pm_region_count = 0;
@@ -202,6 +296,12 @@ struct PerformanceData {
 		pm_edge_connection_count = 0;
 		pm_edge_free_count = 0;
 		pm_obstacle_count = 0;
+		pm_sync_usec = 0;
+		pm_sync_edge_connection_usec = 0;
+		pm_sync_link_connection_usec = 0;
+		pm_sync_region_rebuild_count = 0;
+		pm_sync_edge_merge_count = 0;
+		pm_sync_link_rebuild_count = 0;
 	}
 };
 
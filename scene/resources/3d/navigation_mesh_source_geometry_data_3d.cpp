@@ -30,13 +30,17 @@
 
 #include "navigation_mesh_source_geometry_data_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
 void NavigationMeshSourceGeometryData3D::set_vertices(const Vector<float> &p_vertices) {
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_surfaces();
 	vertices = p_vertices;
 	bounds_dirty = true;
 }
 
 const Vector<float> &NavigationMeshSourceGeometryData3D::get_vertices() const {
+	_flush_deferred_surfaces_for_read();
 	RWLockRead read_lock(geometry_rwlock);
 	return vertices;
 }
@@ -44,17 +48,20 @@ const Vector<float> &NavigationMeshSourceGeometryData3D::get_vertices() const {
 void NavigationMeshSourceGeometryData3D::set_indices(const Vector<int> &p_indices) {
 	ERR_FAIL_COND(vertices.size() < p_indices.size());
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_surfaces();
 	indices = p_indices;
 	bounds_dirty = true;
 }
 
 const Vector<int> &NavigationMeshSourceGeometryData3D::get_indices() const {
+	_flush_deferred_surfaces_for_read();
 	RWLockRead read_lock(geometry_rwlock);
 	return indices;
 }
 
 void NavigationMeshSourceGeometryData3D::append_arrays(const Vector<float> &p_vertices, const Vector<int> &p_indices) {
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_surfaces();
 
 	const int64_t number_of_vertices_before_merge = vertices.size();
 	const int64_t number_of_indices_before_merge = indices.size();
@@ -69,12 +76,14 @@ void NavigationMeshSourceGeometryData3D::append_arrays(const Vector<float> &p_ve
 }
 
 bool NavigationMeshSourceGeometryData3D::has_data() {
+	_flush_deferred_surfaces_for_read();
 	RWLockRead read_lock(geometry_rwlock);
 	return vertices.size() && indices.size();
 }
 
 void NavigationMeshSourceGeometryData3D::clear() {
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_surfaces();
 	vertices.clear();
 	indices.clear();
 	_projected_obstructions.clear();
@@ -87,17 +96,113 @@ void NavigationMeshSourceGeometryData3D::clear_projected_obstructions() {
 	bounds_dirty = true;
 }
 
-void NavigationMeshSourceGeometryData3D::_add_vertex(const Vector3 &p_vec3) {
-	vertices.push_back(p_vec3.x);
-	vertices.push_back(p_vec3.y);
-	vertices.push_back(p_vec3.z);
+void NavigationMeshSourceGeometryData3D::_add_surface(const Vector<Vector3> &p_vertices, const Vector<int> &p_indices, const Transform3D &p_xform, bool p_swap_vertex_winding) {
+	Surface surface;
+	surface.vertices = p_vertices;
+	surface.indices = p_indices;
+	surface.xform = p_xform;
+	surface.swap_vertex_winding = p_swap_vertex_winding;
+	surface.vertex_offset = vertices.size();
+	surface.index_offset = indices.size();
+
+	const int64_t vertex_count = p_indices.is_empty() ? (p_vertices.size() / 3) * 3 : p_vertices.size();
+	const int64_t index_count = p_indices.is_empty() ? vertex_count : (p_indices.size() / 3) * 3;
+	vertices.resize(vertices.size() + vertex_count * 3);
+	indices.resize(indices.size() + index_count);
+
+	if (defer_surfaces) {
+		deferred_surfaces.push_back(surface);
+	} else {
+		_write_surface(surface, vertices.ptrw(), indices.ptrw());
+	}
+}
+
+void NavigationMeshSourceGeometryData3D::_write_surface(const Surface &p_surface, float *r_vertices, int *r_indices) {
+	const Vector3 *vr = p_surface.vertices.ptr();
+	float *vw = r_vertices + p_surface.vertex_offset;
+	int *iw = r_indices + p_surface.index_offset;
+	const int first_vertex = p_surface.vertex_offset / 3;
+
+	if (!p_surface.indices.is_empty()) {
+		for (int j = 0; j < p_surface.vertices.size(); j++) {
+			const Vector3 vertex = p_surface.xform.xform(vr[j]);
+			vw[j * 3 + 0] = vertex.x;
+			vw[j * 3 + 1] = vertex.y;
+			vw[j * 3 + 2] = vertex.z;
+		}
+
+		const int *ir = p_surface.indices.ptr();
+		const int face_count = p_surface.indices.size() / 3;
+		for (int j = 0; j < face_count; j++) {
+			// CCW
+			iw[j * 3 + 0] = first_vertex + ir[j * 3 + 0];
+			iw[j * 3 + 1] = first_vertex + ir[j * 3 + 2];
+			iw[j * 3 + 2] = first_vertex + ir[j * 3 + 1];
+		}
+		return;
+	}
+
+	// Without indices either the vertices or the indices of each face are swapped to flip the winding.
+	const int face_count = p_surface.vertices.size() / 3;
+	const int second = p_surface.swap_vertex_winding ? 2 : 1;
+	const int third = p_surface.swap_vertex_winding ? 1 : 2;
+	for (int j = 0; j < face_count; j++) {
+		const Vector3 vertex_0 = p_surface.xform.xform(vr[j * 3 + 0]);
+		const Vector3 vertex_1 = p_surface.xform.xform(vr[j * 3 + second]);
+		const Vector3 vertex_2 = p_surface.xform.xform(vr[j * 3 + third]);
+		vw[j * 9 + 0] = vertex_0.x;
+		vw[j * 9 + 1] = vertex_0.y;
+		vw[j * 9 + 2] = vertex_0.z;
+		vw[j * 9 + 3] = vertex_1.x;
+		vw[j * 9 + 4] = vertex_1.y;
+		vw[j * 9 + 5] = vertex_1.z;
+		vw[j * 9 + 6] = vertex_2.x;
+		vw[j * 9 + 7] = vertex_2.y;
+		vw[j * 9 + 8] = vertex_2.z;
+
+		iw[j * 3 + 0] = first_vertex + j * 3 + 0;
+		iw[j * 3 + 1] = first_vertex + j * 3 + third;
+		iw[j * 3 + 2] = first_vertex + j * 3 + second;
+	}
+}
+
+void NavigationMeshSourceGeometryData3D::_write_deferred_surface(uint32_t p_index, Surface *p_surfaces) {
+	_write_surface(p_surfaces[p_index], deferred_vertices_ptrw, deferred_indices_ptrw);
+}
+
+void NavigationMeshSourceGeometryData3D::_flush_deferred_surfaces() {
+	// Pending surfaces are written before the arrays are replaced, as they reserved their space by offset.
+	for (const Surface &surface : deferred_surfaces) {
+		_write_surface(surface, vertices.ptrw(), indices.ptrw());
+	}
+	deferred_surfaces.clear();
+}
+
+void NavigationMeshSourceGeometryData3D::_flush_deferred_surfaces_for_read() const {
+	// Parser callbacks can read the geometry while surfaces are deferred, their reserved space has to be written first.
+	geometry_rwlock.read_lock();
+	const bool has_deferred_surfaces = !deferred_surfaces.is_empty();
+	geometry_rwlock.read_unlock();
+
+	if (has_deferred_surfaces) {
+		NavigationMeshSourceGeometryData3D *self = const_cast<NavigationMeshSourceGeometryData3D *>(this);
+		RWLockWrite write_lock(self->geometry_rwlock);
+		self->_flush_deferred_surfaces();
+	}
 }
 
 void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
-	int current_vertex_count;
-	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
-		current_vertex_count = vertices.size() / 3;
+	// Instances of the same mesh, e.g. from a MultiMesh, only fetch its surfaces once while deferred.
+	LocalVector<Array> *cached_surface_arrays = nullptr;
+	if (defer_surfaces) {
+		cached_surface_arrays = deferred_mesh_surface_arrays.getptr(p_mesh->get_instance_id());
+		if (!cached_surface_arrays) {
+			cached_surface_arrays = &deferred_mesh_surface_arrays.insert(p_mesh->get_instance_id(), LocalVector<Array>())->value;
+			cached_surface_arrays->resize(p_mesh->get_surface_count());
+		}
+	}
 
+	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
 		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
 			continue;
 		}
@@ -111,42 +216,27 @@ void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, cons
 
 		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
 
-		int face_count = index_count / 3;
-
-		Array a = p_mesh->surface_get_arrays(i);
+		Array a;
+		if (cached_surface_arrays && i < (int)cached_surface_arrays->size() && !(*cached_surface_arrays)[i].is_empty()) {
+			a = (*cached_surface_arrays)[i];
+		} else {
+			a = p_mesh->surface_get_arrays(i);
+			if (cached_surface_arrays && i < (int)cached_surface_arrays->size()) {
+				(*cached_surface_arrays)[i] = a;
+			}
+		}
 		ERR_CONTINUE(a.is_empty() || (a.size() != Mesh::ARRAY_MAX));
 
 		Vector<Vector3> mesh_vertices = a[Mesh::ARRAY_VERTEX];
 		ERR_CONTINUE(mesh_vertices.is_empty());
-		const Vector3 *vr = mesh_vertices.ptr();
 
 		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
 			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
 			ERR_CONTINUE(mesh_indices.is_empty() || (mesh_indices.size() != index_count));
-			const int *ir = mesh_indices.ptr();
-
-			for (int j = 0; j < mesh_vertices.size(); j++) {
-				_add_vertex(p_xform.xform(vr[j]));
-			}
-
-			for (int j = 0; j < face_count; j++) {
-				// CCW
-				indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
-			}
+			_add_surface(mesh_vertices, mesh_indices, p_xform, false);
 		} else {
 			ERR_CONTINUE(mesh_vertices.size() != index_count);
-			face_count = mesh_vertices.size() / 3;
-			for (int j = 0; j < face_count; j++) {
-				_add_vertex(p_xform.xform(vr[j * 3 + 0]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 2]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 1]));
-
-				indices.push_back(current_vertex_count + (j * 3 + 0));
-				indices.push_back(current_vertex_count + (j * 3 + 1));
-				indices.push_back(current_vertex_count + (j * 3 + 2));
-			}
+			_add_surface(mesh_vertices, Vector<int>(), p_xform, true);
 		}
 	}
 }
@@ -156,42 +246,18 @@ void NavigationMeshSourceGeometryData3D::_add_mesh_array(const Array &p_mesh_arr
 
 	Vector<Vector3> mesh_vertices = p_mesh_array[Mesh::ARRAY_VERTEX];
 	ERR_FAIL_COND(mesh_vertices.is_empty());
-	const Vector3 *vr = mesh_vertices.ptr();
 
 	Vector<int> mesh_indices = p_mesh_array[Mesh::ARRAY_INDEX];
 	ERR_FAIL_COND(mesh_indices.is_empty());
-	const int *ir = mesh_indices.ptr();
 
-	const int face_count = mesh_indices.size() / 3;
-	const int current_vertex_count = vertices.size() / 3;
-
-	for (int j = 0; j < mesh_vertices.size(); j++) {
-		_add_vertex(p_xform.xform(vr[j]));
-	}
-
-	for (int j = 0; j < face_count; j++) {
-		// CCW
-		indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
-		indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
-		indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
-	}
+	_add_surface(mesh_vertices, mesh_indices, p_xform, false);
 }
 
 void NavigationMeshSourceGeometryData3D::_add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform) {
 	ERR_FAIL_COND(p_faces.is_empty());
 	ERR_FAIL_COND(p_faces.size() % 3 != 0);
-	int face_count = p_faces.size() / 3;
-	int current_vertex_count = vertices.size() / 3;
-
-	for (int j = 0; j < face_count; j++) {
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 0]));
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 1]));
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 2]));
 
-		indices.push_back(current_vertex_count + (j * 3 + 0));
-		indices.push_back(current_vertex_count + (j * 3 + 2));
-		indices.push_back(current_vertex_count + (j * 3 + 1));
-	}
+	_add_surface(p_faces, Vector<int>(), p_xform, false);
 }
 
 void NavigationMeshSourceGeometryData3D::add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
@@ -205,7 +271,9 @@ void NavigationMeshSourceGeometryData3D::add_mesh(const Ref<Mesh> &p_mesh, const
 	}
 #endif
 
+	RWLockWrite write_lock(geometry_rwlock);
 	_add_mesh(p_mesh, root_node_transform * p_xform);
+	bounds_dirty = true;
 }
 
 void NavigationMeshSourceGeometryData3D::add_mesh_array(const Array &p_mesh_array, const Transform3D &p_xform) {
@@ -232,6 +300,7 @@ void NavigationMeshSourceGeometryData3D::merge(const Ref<NavigationMeshSourceGeo
 	p_other_geometry->get_data(other_vertices, other_indices, other_projected_obstructions);
 
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_surfaces();
 	const int64_t number_of_vertices_before_merge = vertices.size();
 	const int64_t number_of_indices_before_merge = indices.size();
 
@@ -246,6 +315,43 @@ void NavigationMeshSourceGeometryData3D::merge(const Ref<NavigationMeshSourceGeo
 	bounds_dirty = true;
 }
 
+void NavigationMeshSourceGeometryData3D::begin_deferred_surfaces() {
+	RWLockWrite write_lock(geometry_rwlock);
+	defer_surfaces = true;
+}
+
+int NavigationMeshSourceGeometryData3D::end_deferred_surfaces(bool p_use_threads) {
+	RWLockWrite write_lock(geometry_rwlock);
+
+	defer_surfaces = false;
+	deferred_mesh_surface_arrays.clear();
+
+	const int surface_count = deferred_surfaces.size();
+	if (surface_count == 0) {
+		return 0;
+	}
+
+	// Surfaces write to disjoint ranges of the arrays, so they only need the arrays to not be reallocated meanwhile.
+	deferred_vertices_ptrw = vertices.ptrw();
+	deferred_indices_ptrw = indices.ptrw();
+
+	if (p_use_threads && surface_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshSourceGeometryData3D::_write_deferred_surface, deferred_surfaces.ptr(), surface_count, -1, true, SNAME("NavMeshSourceGeometrySurfaces3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (const Surface &surface : deferred_surfaces) {
+			_write_surface(surface, deferred_vertices_ptrw, deferred_indices_ptrw);
+		}
+	}
+
+	deferred_vertices_ptrw = nullptr;
+	deferred_indices_ptrw = nullptr;
+	deferred_surfaces.clear();
+	bounds_dirty = true;
+
+	return surface_count;
+}
+
 void NavigationMeshSourceGeometryData3D::add_projected_obstruction(const Vector<Vector3> &p_vertices, float p_elevation, float p_height, bool p_carve) {
 	ERR_FAIL_COND(p_vertices.size() < 3);
 	ERR_FAIL_COND(p_height < 0.0);
@@ -343,6 +449,7 @@ bool NavigationMeshSourceGeometryData3D::_get(const StringName &p_name, Variant
 
 void NavigationMeshSourceGeometryData3D::set_data(const Vector<float> &p_vertices, const Vector<int> &p_indices, Vector<ProjectedObstruction> &p_projected_obstructions) {
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_surfaces();
 	vertices = p_vertices;
 	indices = p_indices;
 	_projected_obstructions = p_projected_obstructions;
@@ -350,6 +457,7 @@ void NavigationMeshSourceGeometryData3D::set_data(const Vector<float> &p_vertice
 }
 
 void NavigationMeshSourceGeometryData3D::get_data(Vector<float> &r_vertices, Vector<int> &r_indices, Vector<ProjectedObstruction> &r_projected_obstructions) {
+	_flush_deferred_surfaces_for_read();
 	RWLockRead read_lock(geometry_rwlock);
 	r_vertices = vertices;
 	r_indices = indices;
@@ -357,6 +465,7 @@ void NavigationMeshSourceGeometryData3D::get_data(Vector<float> &r_vertices, Vec
 }
 
 AABB NavigationMeshSourceGeometryData3D::get_bounds() {
+	_flush_deferred_surfaces_for_read();
 	geometry_rwlock.read_lock();
 
 	if (bounds_dirty) {
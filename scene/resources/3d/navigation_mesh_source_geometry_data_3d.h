@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/os/rw_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "scene/resources/mesh.h"
 
 class NavigationMeshSourceGeometryData3D : public Resource {
@@ -55,7 +57,30 @@ protected:
 	static void _bind_methods();
 
 private:
-	void _add_vertex(const Vector3 &p_vec3);
+	/// Transformed source surface whose vertices and indices have their space reserved at the given offsets of the geometry arrays.
+	struct Surface {
+		Vector<Vector3> vertices;
+		/// Empty for surfaces without indices, those add one vertex per face corner.
+		Vector<int> indices;
+		Transform3D xform;
+		bool swap_vertex_winding = false;
+		int64_t vertex_offset = 0;
+		int64_t index_offset = 0;
+	};
+
+	// While deferred the surfaces only reserve their space so they can be written in parallel afterwards.
+	bool defer_surfaces = false;
+	LocalVector<Surface> deferred_surfaces;
+	HashMap<ObjectID, LocalVector<Array>> deferred_mesh_surface_arrays;
+	float *deferred_vertices_ptrw = nullptr;
+	int *deferred_indices_ptrw = nullptr;
+
+	void _add_surface(const Vector<Vector3> &p_vertices, const Vector<int> &p_indices, const Transform3D &p_xform, bool p_swap_vertex_winding);
+	static void _write_surface(const Surface &p_surface, float *r_vertices, int *r_indices);
+	void _write_deferred_surface(uint32_t p_index, Surface *p_surfaces);
+	void _flush_deferred_surfaces();
+	void _flush_deferred_surfaces_for_read() const;
+
 	void _add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform);
 	void _add_mesh_array(const Array &p_array, const Transform3D &p_xform);
 	void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform);
@@ -94,6 +119,11 @@ public:
 
 	void merge(const Ref<NavigationMeshSourceGeometryData3D> &p_other_geometry);
 
+	// Used by the source geometry parsing, the added geometry is only written to the arrays by `end_deferred_surfaces()`,
+	// or earlier when something reads the arrays meanwhile.
+	void begin_deferred_surfaces();
+	int end_deferred_surfaces(bool p_use_threads);
+
 	void add_projected_obstruction(const Vector<Vector3> &p_vertices, float p_elevation, float p_height, bool p_carve);
 	Vector<ProjectedObstruction> _get_projected_obstructions() const;
 
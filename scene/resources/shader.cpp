@@ -129,6 +129,9 @@ void Shader::set_code(const String &p_code) {
 	if (shader_rid.is_valid()) {
 		RenderingServer::get_singleton()->shader_set_code(shader_rid, preprocessed_code);
 		preprocessed_code = String();
+	} else if (!preprocessed_code.is_empty() && RenderingServer::get_singleton()) {
+		// The server shader is only created once it's needed, start compiling the code in the background so it's ready by then.
+		RenderingServer::get_singleton()->shader_precompile_code(preprocessed_code);
 	}
 
 	emit_changed();
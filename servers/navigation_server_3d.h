@@ -84,6 +84,12 @@ public:
 	virtual void map_set_link_connection_radius(RID p_map, real_t p_connection_radius) = 0;
 	virtual real_t map_get_link_connection_radius(RID p_map) const = 0;
 
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
+	virtual void map_set_hierarchical_cluster_size(RID p_map, real_t p_cluster_size) = 0;
+	virtual real_t map_get_hierarchical_cluster_size(RID p_map) const = 0;
+
 	virtual Vector<Vector3> map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers = 1) = 0;
 
 	virtual Vector3 map_get_closest_point_to_segment(RID p_map, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision = false) const = 0;
@@ -278,6 +284,7 @@ public:
 	/* QUERY API */
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback = Callable()) = 0;
+	virtual Dictionary query_paths(const Ref<NavigationPathQueryParameters3D> &p_query_parameters, const PackedVector3Array &p_start_positions, const PackedVector3Array &p_target_positions, const Callable &p_callback = Callable()) = 0;
 
 	/* NAVMESH BAKE API */
 
@@ -326,6 +333,12 @@ public:
 		INFO_EDGE_CONNECTION_COUNT,
 		INFO_EDGE_FREE_COUNT,
 		INFO_OBSTACLE_COUNT,
+		INFO_SYNC_USEC,
+		INFO_SYNC_EDGE_CONNECTION_USEC,
+		INFO_SYNC_LINK_CONNECTION_USEC,
+		INFO_SYNC_REGION_REBUILD_COUNT,
+		INFO_SYNC_EDGE_MERGE_COUNT,
+		INFO_SYNC_LINK_REBUILD_COUNT,
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) const = 0;
@@ -0,0 +1,67 @@
+/**************************************************************************/
+/*  physics_ray_results.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+
+#pragma once
+
+#include "core/math/vector3.h"
+#include "core/variant/dictionary.h"
+#include "core/variant/typed_array.h"
+
+// Builds the dictionaries returned by `intersect_ray()` and `intersect_rays()`, shared by the 2D and 3D direct space states.
+class PhysicsRayResults {
+public:
+	template <typename TRayResult>
+	static Dictionary to_dictionary(const TRayResult &p_result) {
+		Dictionary d;
+		d["position"] = p_result.position;
+		d["normal"] = p_result.normal;
+		// Only 3D ray results carry a face index.
+		if constexpr (std::is_same_v<decltype(TRayResult::position), Vector3>) {
+			d["face_index"] = p_result.face_index;
+		}
+		d["collider_id"] = p_result.collider_id;
+		d["collider"] = p_result.collider;
+		d["shape"] = p_result.shape;
+		d["rid"] = p_result.rid;
+		return d;
+	}
+
+	// Rays that did not hit anything get an empty dictionary.
+	template <typename TRayResult>
+	static TypedArray<Dictionary> to_dictionaries(const TRayResult *p_results, const bool *p_hits, int p_count) {
+		TypedArray<Dictionary> ret;
+		ret.resize(p_count);
+		for (int i = 0; i < p_count; i++) {
+			ret[i] = p_hits[i] ? to_dictionary(p_results[i]) : Dictionary();
+		}
+		return ret;
+	}
+};
@@ -33,7 +33,9 @@
 #include "physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/string/string_builder.h"
 #include "core/variant/typed_array.h"
+#include "servers/physics_ray_results.h"
 
 void PhysicsServer3DRenderingServerHandler::set_vertex(int p_vertex_id, const Vector3 &p_vertex) {
 	GDVIRTUAL_CALL(_set_vertex, p_vertex_id, p_vertex);
@@ -89,6 +91,68 @@ Object *PhysicsDirectBodyState3D::get_contact_collider_object(int p_contact_idx)
 	return obj;
 }
 
+Dictionary PhysicsDirectBodyState3D::get_contacts() const {
+	const int contact_count = get_contact_count();
+
+	PackedVector3Array local_positions;
+	PackedVector3Array local_normals;
+	PackedVector3Array local_velocities;
+	PackedInt32Array local_shapes;
+	PackedVector3Array impulses;
+	Array colliders;
+	PackedInt64Array collider_ids;
+	PackedVector3Array collider_positions;
+	PackedVector3Array collider_velocities;
+	PackedInt32Array collider_shapes;
+
+	local_positions.resize(contact_count);
+	local_normals.resize(contact_count);
+	local_velocities.resize(contact_count);
+	local_shapes.resize(contact_count);
+	impulses.resize(contact_count);
+	colliders.resize(contact_count);
+	collider_ids.resize(contact_count);
+	collider_positions.resize(contact_count);
+	collider_velocities.resize(contact_count);
+	collider_shapes.resize(contact_count);
+
+	Vector3 *local_positions_ptr = local_positions.ptrw();
+	Vector3 *local_normals_ptr = local_normals.ptrw();
+	Vector3 *local_velocities_ptr = local_velocities.ptrw();
+	int32_t *local_shapes_ptr = local_shapes.ptrw();
+	Vector3 *impulses_ptr = impulses.ptrw();
+	int64_t *collider_ids_ptr = collider_ids.ptrw();
+	Vector3 *collider_positions_ptr = collider_positions.ptrw();
+	Vector3 *collider_velocities_ptr = collider_velocities.ptrw();
+	int32_t *collider_shapes_ptr = collider_shapes.ptrw();
+
+	for (int i = 0; i < contact_count; i++) {
+		local_positions_ptr[i] = get_contact_local_position(i);
+		local_normals_ptr[i] = get_contact_local_normal(i);
+		local_velocities_ptr[i] = get_contact_local_velocity_at_position(i);
+		local_shapes_ptr[i] = get_contact_local_shape(i);
+		impulses_ptr[i] = get_contact_impulse(i);
+		colliders[i] = get_contact_collider(i);
+		collider_ids_ptr[i] = (int64_t)get_contact_collider_id(i);
+		collider_positions_ptr[i] = get_contact_collider_position(i);
+		collider_velocities_ptr[i] = get_contact_collider_velocity_at_position(i);
+		collider_shapes_ptr[i] = get_contact_collider_shape(i);
+	}
+
+	Dictionary contacts;
+	contacts["local_positions"] = local_positions;
+	contacts["local_normals"] = local_normals;
+	contacts["local_velocities"] = local_velocities;
+	contacts["local_shapes"] = local_shapes;
+	contacts["impulses"] = impulses;
+	contacts["colliders"] = colliders;
+	contacts["collider_ids"] = collider_ids;
+	contacts["collider_positions"] = collider_positions;
+	contacts["collider_velocities"] = collider_velocities;
+	contacts["collider_shapes"] = collider_shapes;
+	return contacts;
+}
+
 PhysicsServer3D *PhysicsServer3D::get_singleton() {
 	return singleton;
 }
@@ -151,6 +215,7 @@ void PhysicsDirectBodyState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_contact_collider_object", "contact_idx"), &PhysicsDirectBodyState3D::get_contact_collider_object);
 	ClassDB::bind_method(D_METHOD("get_contact_collider_shape", "contact_idx"), &PhysicsDirectBodyState3D::get_contact_collider_shape);
 	ClassDB::bind_method(D_METHOD("get_contact_collider_velocity_at_position", "contact_idx"), &PhysicsDirectBodyState3D::get_contact_collider_velocity_at_position);
+	ClassDB::bind_method(D_METHOD("get_contacts"), &PhysicsDirectBodyState3D::get_contacts);
 	ClassDB::bind_method(D_METHOD("get_step"), &PhysicsDirectBodyState3D::get_step);
 	ClassDB::bind_method(D_METHOD("integrate_forces"), &PhysicsDirectBodyState3D::integrate_forces);
 	ClassDB::bind_method(D_METHOD("get_space_state"), &PhysicsDirectBodyState3D::get_space_state);
@@ -354,6 +419,33 @@ void PhysicsShapeQueryParameters3D::_bind_methods() {
 
 /////////////////////////////////////
 
+TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_rays(const TypedArray<PhysicsRayQueryParameters3D> &p_ray_queries) {
+	const int count = p_ray_queries.size();
+
+	LocalVector<RayParameters> parameters;
+	parameters.resize(count);
+	for (int i = 0; i < count; i++) {
+		Ref<PhysicsRayQueryParameters3D> ray_query = p_ray_queries[i];
+		ERR_FAIL_COND_V(ray_query.is_null(), TypedArray<Dictionary>());
+		parameters[i] = ray_query->get_parameters();
+	}
+
+	LocalVector<RayResult> results;
+	results.resize(count);
+	LocalVector<bool> hits;
+	hits.resize(count);
+
+	intersect_rays(parameters.ptr(), count, results.ptr(), hits.ptr());
+
+	return PhysicsRayResults::to_dictionaries(results.ptr(), hits.ptr(), count);
+}
+
+void PhysicsDirectSpaceState3D::intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_hits) {
+	for (int i = 0; i < p_count; i++) {
+		r_hits[i] = intersect_ray(p_parameters[i], r_results[i]);
+	}
+}
+
 Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryParameters3D> &p_ray_query) {
 	ERR_FAIL_COND_V(p_ray_query.is_null(), Dictionary());
 
@@ -364,16 +456,7 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(const Ref<PhysicsRayQueryPa
 		return Dictionary();
 	}
 
-	Dictionary d;
-	d["position"] = result.position;
-	d["normal"] = result.normal;
-	d["face_index"] = result.face_index;
-	d["collider_id"] = result.collider_id;
-	d["collider"] = result.collider;
-	d["shape"] = result.shape;
-	d["rid"] = result.rid;
-
-	return d;
+	return PhysicsRayResults::to_dictionary(result);
 }
 
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results) {
@@ -481,6 +564,7 @@ PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters"), &PhysicsDirectSpaceState3D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -688,6 +772,70 @@ RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	}
 }
 
+PackedByteArray PhysicsServer3D::space_save_state(RID p_space) const {
+	ERR_FAIL_V_MSG(PackedByteArray(), "Space state snapshots are not supported by this physics server.");
+}
+
+bool PhysicsServer3D::space_restore_state(RID p_space, const PackedByteArray &p_state) {
+	ERR_FAIL_V_MSG(false, "Space state snapshots are not supported by this physics server.");
+}
+
+Dictionary PhysicsServer3D::space_get_profiling_info(RID p_space) const {
+	return Dictionary();
+}
+
+void PhysicsServer3D::_add_trace_event(const char *p_name, RID p_space, uint64_t p_begin_usec, uint64_t p_end_usec) {
+	if (!tracing || trace_events.size() >= MAX_TRACE_EVENTS) {
+		return;
+	}
+
+	TraceEvent event;
+	event.name = p_name;
+	event.space_id = p_space.get_id();
+	event.begin_usec = p_begin_usec;
+	event.duration_usec = p_end_usec - p_begin_usec;
+	trace_events.push_back(event);
+}
+
+void PhysicsServer3D::start_trace() {
+	trace_events.clear();
+	tracing = true;
+}
+
+String PhysicsServer3D::stop_trace() {
+	tracing = false;
+
+	// Every space gets its own track, numbered in order of appearance.
+	HashMap<uint64_t, int> space_tracks;
+	StringBuilder json;
+	json.append("{\"traceEvents\":[");
+
+	for (uint32_t i = 0; i < trace_events.size(); i++) {
+		const TraceEvent &event = trace_events[i];
+
+		const int *track_ptr = space_tracks.getptr(event.space_id);
+		int track = 0;
+		if (track_ptr) {
+			track = *track_ptr;
+		} else {
+			track = space_tracks.size();
+			space_tracks.insert(event.space_id, track);
+			if (i > 0) {
+				json.append(",");
+			}
+			json.append(vformat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"Space %d\"}}", track, (int64_t)event.space_id));
+		}
+
+		json.append(vformat(",{\"name\":\"%s\",\"cat\":\"physics_3d\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%d,\"dur\":%d}", event.name, track, (int64_t)event.begin_usec, (int64_t)event.duration_usec));
+	}
+
+	json.append("],\"displayTimeUnit\":\"ms\"}");
+
+	trace_events.reset();
+
+	return json.as_string();
+}
+
 void PhysicsServer3D::_bind_methods() {
 #ifndef _3D_DISABLED
 
@@ -715,6 +863,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -1043,6 +1193,10 @@ void PhysicsServer3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_process_info", "process_info"), &PhysicsServer3D::get_process_info);
 
+	ClassDB::bind_method(D_METHOD("space_get_profiling_info", "space"), &PhysicsServer3D::space_get_profiling_info);
+	ClassDB::bind_method(D_METHOD("start_trace"), &PhysicsServer3D::start_trace);
+	ClassDB::bind_method(D_METHOD("stop_trace"), &PhysicsServer3D::stop_trace);
+
 	BIND_ENUM_CONSTANT(SHAPE_WORLD_BOUNDARY);
 	BIND_ENUM_CONSTANT(SHAPE_SEPARATION_RAY);
 	BIND_ENUM_CONSTANT(SHAPE_SPHERE);
@@ -1146,6 +1300,7 @@ PhysicsServer3D::PhysicsServer3D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_separation", PROPERTY_HINT_RANGE, "0,0.1,0.001,or_greater"), 0.05);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.001,0.1,0.001,or_greater"), 0.01);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/3d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "physics/3d/solver/parallel_island_min_constraints", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), 256);
 }
 
 PhysicsServer3D::~PhysicsServer3D() {
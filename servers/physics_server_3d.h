@@ -34,6 +34,7 @@
 
 #include "core/io/resource.h"
 #include "core/object/gdvirtual.gen.inc"
+#include "core/templates/local_vector.h"
 
 constexpr int MAX_CONTACTS_REPORTED_3D_MAX = 4096;
 
@@ -106,6 +107,8 @@ public:
 	virtual int get_contact_collider_shape(int p_contact_idx) const = 0;
 	virtual Vector3 get_contact_collider_velocity_at_position(int p_contact_idx) const = 0;
 
+	virtual Dictionary get_contacts() const;
+
 	virtual real_t get_step() const = 0;
 	virtual void integrate_forces();
 
@@ -123,6 +126,7 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(const Ref<PhysicsRayQueryParameters3D> &p_ray_query);
+	TypedArray<Dictionary> _intersect_rays(const TypedArray<PhysicsRayQueryParameters3D> &p_ray_queries);
 	TypedArray<Dictionary> _intersect_point(const Ref<PhysicsPointQueryParameters3D> &p_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(const Ref<PhysicsShapeQueryParameters3D> &p_shape_query);
@@ -159,6 +163,9 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Runs several ray queries at once, which implementations may process in parallel.
+	// `r_hits[i]` tells whether `p_parameters[i]` hit anything, `r_results[i]` is only valid if it did.
+	virtual void intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_hits);
 
 	struct ShapeResult {
 		RID rid;
@@ -237,6 +244,21 @@ class PhysicsServer3D : public Object {
 	virtual bool _body_test_motion(RID p_body, const Ref<PhysicsTestMotionParameters3D> &p_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
 
 protected:
+	struct TraceEvent {
+		const char *name = nullptr;
+		uint64_t space_id = 0;
+		uint64_t begin_usec = 0;
+		uint64_t duration_usec = 0;
+	};
+
+	static constexpr uint32_t MAX_TRACE_EVENTS = 1 << 20;
+
+	bool tracing = false;
+	LocalVector<TraceEvent> trace_events;
+
+	// Implementations call this while stepping; it is a no-op unless a trace was started.
+	void _add_trace_event(const char *p_name, RID p_space, uint64_t p_begin_usec, uint64_t p_end_usec);
+
 	static void _bind_methods();
 
 public:
@@ -307,6 +329,10 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	// Snapshots of the simulation state of a space, for rollback. Not supported by every physics server.
+	virtual PackedByteArray space_save_state(RID p_space) const;
+	virtual bool space_restore_state(RID p_space, const PackedByteArray &p_state);
+
 	//missing space parameters
 
 	/* AREA API */
@@ -819,6 +845,13 @@ public:
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
 
+	// Per-space counters and phase timings of the last step. Not supported by every physics server.
+	virtual Dictionary space_get_profiling_info(RID p_space) const;
+
+	// Records the step phases of every active space until stopped, and returns them as a Chrome trace.
+	virtual void start_trace();
+	virtual String stop_trace();
+
 	PhysicsServer3D();
 	~PhysicsServer3D();
 };
@@ -116,6 +116,9 @@ public:
 		return physics_server_3d->space_get_direct_state(p_space);
 	}
 
+	FUNC1RC(PackedByteArray, space_save_state, RID);
+	FUNC2R(bool, space_restore_state, RID, const PackedByteArray &);
+
 	FUNC2(space_set_debug_contacts, RID, int);
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), Vector<Vector3>());
@@ -404,6 +407,10 @@ public:
 		return physics_server_3d->get_process_info(p_info);
 	}
 
+	FUNC1RC(Dictionary, space_get_profiling_info, RID);
+	FUNC0(start_trace);
+	FUNC0R(String, stop_trace);
+
 	PhysicsServer3DWrapMT(PhysicsServer3D *p_contained, bool p_create_thread);
 	~PhysicsServer3DWrapMT();
 
@@ -0,0 +1,196 @@
+/**************************************************************************/
+/*  physics_space_state.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/variant/variant.h"
+
+// Binary space snapshots, shared by the 2D and 3D Godot Physics servers.
+// Snapshots are raw copies of the simulation state, they are only meant to be restored by the same build on the same platform.
+class PhysicsSpaceState {
+public:
+	static constexpr uint32_t VERSION = 1;
+
+	class Writer {
+		LocalVector<uint8_t> buffer;
+
+	public:
+		template <typename T>
+		_FORCE_INLINE_ void write(const T &p_value) {
+			uint32_t offset = buffer.size();
+			buffer.resize(offset + sizeof(T));
+			memcpy(buffer.ptr() + offset, &p_value, sizeof(T));
+		}
+
+		PackedByteArray get_state() const {
+			PackedByteArray state;
+			state.resize(buffer.size());
+			memcpy(state.ptrw(), buffer.ptr(), buffer.size());
+			return state;
+		}
+
+		Writer(uint32_t p_magic, uint32_t p_reserve) {
+			buffer.reserve(p_reserve + 3 * sizeof(uint32_t));
+			write(p_magic);
+			write(VERSION);
+			write((uint32_t)sizeof(real_t));
+		}
+	};
+
+	class Reader {
+		const uint8_t *data = nullptr;
+		uint32_t size = 0;
+		uint32_t offset = 0;
+
+	public:
+		template <typename T>
+		_FORCE_INLINE_ bool read(T &r_value) {
+			if (offset + sizeof(T) > size) {
+				return false;
+			}
+			memcpy(&r_value, data + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+		template <typename T, typename... R>
+		_FORCE_INLINE_ bool read(T &r_value, R &...r_rest) {
+			return read(r_value) && read(r_rest...);
+		}
+
+		_FORCE_INLINE_ bool is_at_end() const { return offset == size; }
+
+		// Checks the header written by Writer, so a state from another server or build is rejected before it's parsed.
+		bool read_header(uint32_t p_magic) {
+			uint32_t magic = 0;
+			uint32_t version = 0;
+			uint32_t real_size = 0;
+			ERR_FAIL_COND_V_MSG(!read(magic) || magic != p_magic, false, "Invalid space state.");
+			ERR_FAIL_COND_V_MSG(!read(version) || version != VERSION, false, "Space state was saved by a different version of the engine.");
+			ERR_FAIL_COND_V_MSG(!read(real_size) || real_size != sizeof(real_t), false, "Space state was saved with a different floating-point precision.");
+			return true;
+		}
+
+		Reader(const PackedByteArray &p_state) {
+			data = p_state.ptr();
+			size = p_state.size();
+		}
+	};
+
+	// Bodies of a space, sorted by RID so that equal simulation states give equal snapshots.
+	template <typename TBody, typename TObject>
+	static void get_bodies(const HashSet<TObject *> &p_objects, LocalVector<TBody *> &r_bodies) {
+		for (TObject *object : p_objects) {
+			if (object->get_type() == TObject::TYPE_BODY) {
+				r_bodies.push_back(static_cast<TBody *>(object));
+			}
+		}
+
+		struct BodyComparator {
+			_FORCE_INLINE_ bool operator()(const TBody *p_a, const TBody *p_b) const {
+				return p_a->get_self().get_id() < p_b->get_self().get_id();
+			}
+		};
+		r_bodies.template sort_custom<BodyComparator>();
+	}
+
+	template <typename TBody>
+	static void write_bodies(Writer &p_writer, const LocalVector<TBody *> &p_bodies) {
+		p_writer.write(p_bodies.size());
+		for (const TBody *body : p_bodies) {
+			typename TBody::SnapshotState state;
+			body->get_snapshot_state(state);
+			p_writer.write(body->get_self().get_id());
+			p_writer.write(state.transform);
+			p_writer.write(state.inv_transform);
+			p_writer.write(state.new_transform);
+			p_writer.write(state.linear_velocity);
+			p_writer.write(state.angular_velocity);
+			p_writer.write(state.applied_force);
+			p_writer.write(state.applied_torque);
+			p_writer.write(state.still_time);
+			p_writer.write((uint8_t)state.active);
+		}
+	}
+
+	// Bodies removed from the space since the state was saved are skipped.
+	template <typename TBody, typename TObject>
+	static bool read_bodies(Reader &p_reader, const HashSet<TObject *> &p_objects, LocalVector<Pair<TBody *, typename TBody::SnapshotState>> &r_states) {
+		HashMap<uint64_t, TBody *> bodies_by_id;
+		for (TObject *object : p_objects) {
+			if (object->get_type() == TObject::TYPE_BODY) {
+				bodies_by_id.insert(object->get_self().get_id(), static_cast<TBody *>(object));
+			}
+		}
+
+		uint32_t body_count = 0;
+		ERR_FAIL_COND_V_MSG(!p_reader.read(body_count), false, "Invalid space state.");
+
+		r_states.reserve(bodies_by_id.size());
+		for (uint32_t i = 0; i < body_count; i++) {
+			uint64_t id = 0;
+			typename TBody::SnapshotState state;
+			uint8_t active = 0;
+			bool valid = p_reader.read(id, state.transform, state.inv_transform, state.new_transform,
+					state.linear_velocity, state.angular_velocity, state.applied_force, state.applied_torque,
+					state.still_time, active);
+			ERR_FAIL_COND_V_MSG(!valid, false, "Invalid space state.");
+			state.active = active;
+
+			TBody **body = bodies_by_id.getptr(id);
+			if (body) {
+				r_states.push_back({ *body, state });
+			}
+		}
+		return true;
+	}
+
+	// Matches saved states to the objects of the space in a single pass, both lists must be sorted by key.
+	// Calls p_apply(object, state) for each object, with a null state if it didn't exist when the state was saved.
+	template <typename TKey, typename TState, typename TItem, typename TGetKey, typename TApply>
+	static void apply_sorted(const LocalVector<Pair<TKey, TState>> &p_states, const LocalVector<TItem> &p_items, TGetKey p_get_key, TApply p_apply) {
+		uint32_t state_index = 0;
+		for (const TItem &item : p_items) {
+			TKey key = p_get_key(item);
+			while (state_index < p_states.size() && p_states[state_index].first < key) {
+				state_index++;
+			}
+			if (state_index < p_states.size() && p_states[state_index].first == key) {
+				p_apply(item, &p_states[state_index].second);
+			} else {
+				p_apply(item, nullptr);
+			}
+		}
+	}
+};
@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -250,7 +251,12 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		// Something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			if (cull_threaded) {
+				// The redraw counter is not thread-safe, request it once culling threads are done.
+				cull_redraw_requested.set();
+			} else {
+				RenderingServerDefault::redraw_request();
+			}
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -277,7 +283,13 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		}
 
 		if (ci->visibility_notifier) {
-			if (!ci->visibility_notifier->visible_element.in_list()) {
+			if (cull_threaded) {
+				MutexLock lock(visibility_notifier_mutex);
+				if (!ci->visibility_notifier->visible_element.in_list()) {
+					visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+					ci->visibility_notifier->just_visible = true;
+				}
+			} else if (!ci->visibility_notifier->visible_element.in_list()) {
 				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
 				ci->visibility_notifier->just_visible = true;
 			}
@@ -444,8 +456,42 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			SortArray<Item *, ItemYSort> sorter;
 			sorter.sort(child_items, child_item_count);
 
-			for (i = 0; i < child_item_count; i++) {
-				_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+			bool threaded = _can_cull_children_threaded(child_item_count);
+			if (threaded) {
+				// Repeated items read the final transform of their repeat source, which may be
+				// culled by another chunk once the children are flattened and sorted.
+				for (i = 0; i < child_item_count; i++) {
+					if (child_items[i]->repeat_source_item) {
+						threaded = false;
+						break;
+					}
+				}
+			}
+			if (threaded) {
+				// Y-sorted children are flattened, only the children of the items that don't sort them are culled from them.
+				for (i = 0; i < child_item_count; i++) {
+					if (!_prepare_threaded_cull(child_items[i], !child_items[i]->sort_y)) {
+						threaded = false;
+						break;
+					}
+				}
+			}
+
+			if (threaded) {
+				ThreadedCullData cull_data;
+				cull_data.child_items = child_items;
+				cull_data.child_item_count = child_item_count;
+				cull_data.is_y_sorted = true;
+				cull_data.xform = final_xform;
+				cull_data.clip_rect = p_clip_rect;
+				cull_data.modulate = modulate;
+				cull_data.canvas_clip = (Item *)ci->final_clip_owner;
+				cull_data.canvas_cull_mask = p_canvas_cull_mask;
+				_cull_canvas_item_children(cull_data, r_z_list, r_z_last_list);
+			} else {
+				for (i = 0; i < child_item_count; i++) {
+					_cull_canvas_item(child_items[i], final_xform * child_items[i]->ysort_xform, p_clip_rect, modulate * child_items[i]->ysort_modulate, child_items[i]->ysort_parent_abs_z_index, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, (Item *)child_items[i]->material_owner, true, p_canvas_cull_mask, child_items[i]->repeat_size, child_items[i]->repeat_times, child_items[i]->repeat_source_item);
+				}
 			}
 		} else {
 			RendererCanvasRender::Item *canvas_group_from = nullptr;
@@ -465,6 +511,36 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = r_z_last_list[zidx];
 		}
 
+		bool threaded = _can_cull_children_threaded(child_item_count);
+		for (int i = 0; threaded && i < child_item_count; i++) {
+			threaded = _prepare_threaded_cull(child_items[i], true);
+		}
+
+		if (threaded) {
+			ThreadedCullData cull_data;
+			cull_data.child_items = child_items;
+			cull_data.child_item_count = child_item_count;
+			cull_data.xform = final_xform;
+			cull_data.clip_rect = p_clip_rect;
+			cull_data.modulate = modulate;
+			cull_data.z = p_z;
+			cull_data.canvas_clip = (Item *)ci->final_clip_owner;
+			cull_data.material_owner = p_material_owner;
+			cull_data.canvas_cull_mask = p_canvas_cull_mask;
+			cull_data.repeat_size = repeat_size;
+			cull_data.repeat_times = repeat_times;
+			cull_data.repeat_source_item = repeat_source_item;
+
+			cull_data.filter = use_canvas_group ? CULL_CHILD_FILTER_ALL : CULL_CHILD_FILTER_BEHIND;
+			_cull_canvas_item_children(cull_data, r_z_list, r_z_last_list);
+			_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+			if (!use_canvas_group) {
+				cull_data.filter = CULL_CHILD_FILTER_NOT_BEHIND;
+				_cull_canvas_item_children(cull_data, r_z_list, r_z_last_list);
+			}
+			return;
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -481,6 +557,90 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 }
 
+bool RendererCanvasCull::_prepare_threaded_cull(Item *p_item, bool p_recursive) {
+	if (!p_item->visible) {
+		return true;
+	}
+
+	// The mesh, multimesh and particles AABB getters may update the dirty storage state,
+	// so the rects that use them must not be computed from the worker threads.
+	if (!p_item->custom_rect && (p_item->update_when_visible || p_item->skeleton.is_valid())) {
+		// These rects are computed again on every cull.
+		for (const Item::Command *c = p_item->commands; c; c = c->next) {
+			if (c->type == Item::Command::TYPE_MESH || c->type == Item::Command::TYPE_MULTIMESH || c->type == Item::Command::TYPE_PARTICLES) {
+				return false;
+			}
+		}
+	} else {
+		// Refresh the cached rect.
+		p_item->get_rect();
+	}
+
+	if (p_recursive) {
+		for (Item *child : p_item->child_items) {
+			if (!_prepare_threaded_cull(child, true)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void RendererCanvasCull::_cull_canvas_item_children_threaded(uint32_t p_chunk, ThreadedCullData *p_data) {
+	CullChunk &chunk = cull_chunks[p_chunk];
+	RendererCanvasRender::Item **chunk_z_list = chunk.z_list.ptr();
+	RendererCanvasRender::Item **chunk_z_last_list = chunk.z_last_list.ptr();
+	memset(chunk_z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+	memset(chunk_z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+
+	uint32_t from = p_chunk * p_data->child_item_count / p_data->chunk_count;
+	uint32_t to = (p_chunk + 1 == p_data->chunk_count) ? p_data->child_item_count : ((p_chunk + 1) * p_data->child_item_count / p_data->chunk_count);
+
+	for (uint32_t i = from; i < to; i++) {
+		Item *child = p_data->child_items[i];
+		if (p_data->is_y_sorted) {
+			_cull_canvas_item(child, p_data->xform * child->ysort_xform, p_data->clip_rect, p_data->modulate * child->ysort_modulate, child->ysort_parent_abs_z_index, chunk_z_list, chunk_z_last_list, p_data->canvas_clip, (Item *)child->material_owner, true, p_data->canvas_cull_mask, child->repeat_size, child->repeat_times, child->repeat_source_item);
+			continue;
+		}
+
+		if ((p_data->filter == CULL_CHILD_FILTER_BEHIND && !child->behind) || (p_data->filter == CULL_CHILD_FILTER_NOT_BEHIND && child->behind)) {
+			continue;
+		}
+		_cull_canvas_item(child, p_data->xform, p_data->clip_rect, p_data->modulate, p_data->z, chunk_z_list, chunk_z_last_list, p_data->canvas_clip, p_data->material_owner, false, p_data->canvas_cull_mask, p_data->repeat_size, p_data->repeat_times, p_data->repeat_source_item);
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_item_children(ThreadedCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	p_data.chunk_count = MIN(cull_chunks.size(), p_data.child_item_count);
+
+	cull_threaded = true;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_children_threaded, &p_data, p_data.chunk_count, -1, true, SNAME("CullCanvasItems"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	cull_threaded = false;
+
+	// Splice the chunk lists in chunk order, which is the order single-threaded culling would have appended them.
+	for (int i = 0; i < z_range; i++) {
+		for (uint32_t j = 0; j < p_data.chunk_count; j++) {
+			const CullChunk &chunk = cull_chunks[j];
+			if (!chunk.z_list[i]) {
+				continue;
+			}
+			if (r_z_last_list[i]) {
+				r_z_last_list[i]->next = chunk.z_list[i];
+			} else {
+				r_z_list[i] = chunk.z_list[i];
+			}
+			r_z_last_list[i] = chunk.z_last_list[i];
+		}
+	}
+
+	if (cull_redraw_requested.is_set()) {
+		cull_redraw_requested.clear();
+		RenderingServerDefault::redraw_request();
+	}
+}
+
 void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("> Render Canvas");
 
@@ -2774,6 +2934,18 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	disable_scale = false;
 
+	// Only worth splitting when there is more than one thread to cull on.
+	uint32_t thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	if (thread_count > 1) {
+		cull_chunks.resize(thread_count);
+		for (CullChunk &chunk : cull_chunks) {
+			chunk.z_list.resize(z_range);
+			chunk.z_last_list.resize(z_range);
+		}
+	}
+	cull_thread_threshold = GLOBAL_GET("rendering/2d/canvas_cull/threaded_cull_minimum_items");
+	cull_thread_threshold = MAX(cull_thread_threshold, thread_count);
+
 	debug_redraw_time = GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "debug/canvas_items/debug_redraw_time", PROPERTY_HINT_RANGE, "0.1,2,0.001,or_greater"), 1.0);
 	debug_redraw_color = GLOBAL_DEF(PropertyInfo(Variant::COLOR, "debug/canvas_items/debug_redraw_color"), Color(1.0, 0.2, 0.2, 0.5));
 }
@@ -30,7 +30,9 @@
 
 #pragma once
 
+#include "core/os/mutex.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 #include "servers/rendering/instance_uniforms.h"
@@ -200,6 +202,7 @@ public:
 
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
+	BinaryMutex visibility_notifier_mutex;
 
 	_FORCE_INLINE_ void _attach_canvas_item_for_draw(Item *ci, Item *p_canvas_clip, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list, const Transform2D &p_transform, const Rect2 &p_clip_rect, Rect2 p_global_rect, const Color &modulate, int p_z, RendererCanvasCull::Item *p_material_owner, bool p_use_canvas_group, RendererCanvasRender::Item *r_canvas_group_from);
 
@@ -216,6 +219,55 @@ private:
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
+	/* THREADED CULLING */
+
+	// Large child lists are split into contiguous chunks culled on worker threads.
+	// Every chunk appends into its own z-lists, which are then spliced back
+	// into the parent z-lists in chunk order, so draw order matches single-threaded culling.
+
+	enum CullChildFilter {
+		CULL_CHILD_FILTER_ALL,
+		CULL_CHILD_FILTER_BEHIND,
+		CULL_CHILD_FILTER_NOT_BEHIND,
+	};
+
+	struct CullChunk {
+		LocalVector<RendererCanvasRender::Item *> z_list;
+		LocalVector<RendererCanvasRender::Item *> z_last_list;
+	};
+
+	struct ThreadedCullData {
+		Item **child_items = nullptr;
+		uint32_t child_item_count = 0;
+		uint32_t chunk_count = 0;
+		CullChildFilter filter = CULL_CHILD_FILTER_ALL;
+		bool is_y_sorted = false;
+
+		Transform2D xform;
+		Rect2 clip_rect;
+		Color modulate;
+		int z = 0;
+		Item *canvas_clip = nullptr;
+		Item *material_owner = nullptr;
+		uint32_t canvas_cull_mask = 0;
+		Point2 repeat_size;
+		int repeat_times = 1;
+		RendererCanvasRender::Item *repeat_source_item = nullptr;
+	};
+
+	LocalVector<CullChunk> cull_chunks;
+	uint32_t cull_thread_threshold = 0;
+	bool cull_threaded = false;
+	SafeFlag cull_redraw_requested;
+
+	_FORCE_INLINE_ bool _can_cull_children_threaded(int p_child_item_count) const {
+		return !cull_threaded && cull_chunks.size() > 1 && uint32_t(p_child_item_count) >= cull_thread_threshold;
+	}
+	// Refreshes the rects of the item and its subtree, returns false if culling them needs the storage on worker threads.
+	bool _prepare_threaded_cull(Item *p_item, bool p_recursive);
+	void _cull_canvas_item_children_threaded(uint32_t p_chunk, ThreadedCullData *p_data);
+	void _cull_canvas_item_children(ThreadedCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list);
+
 	Transform2D _current_camera_transform;
 
 public:
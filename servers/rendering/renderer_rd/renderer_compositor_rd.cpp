@@ -305,6 +305,12 @@ RendererCompositorRD::RendererCompositorRD() {
 			} else {
 				shader_cache_user_dir = shader_cache_user_dir.path_join("shader_cache");
 				ShaderRD::set_shader_cache_user_dir(shader_cache_user_dir);
+
+				// Results of the shader language front end are cached next to the compiled variants.
+				String compiler_cache_dir = shader_cache_user_dir.path_join("shader_compiler");
+				if (DirAccess::dir_exists_absolute(compiler_cache_dir) || DirAccess::make_dir_absolute(compiler_cache_dir) == OK) {
+					ShaderCompiler::set_result_cache_dir(compiler_cache_dir);
+				}
 			}
 		}
 
@@ -352,5 +358,6 @@ RendererCompositorRD::~RendererCompositorRD() {
 	memdelete(uniform_set_cache);
 	memdelete(framebuffer_cache);
 	ShaderRD::set_shader_cache_user_dir(String());
+	ShaderCompiler::set_result_cache_dir(String());
 	ShaderRD::set_shader_cache_res_dir(String());
 }
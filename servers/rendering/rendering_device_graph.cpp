@@ -245,7 +245,15 @@ int32_t RenderingDeviceGraph::_add_to_command_list(int32_t p_command_index, int3
 void RenderingDeviceGraph::_add_adjacent_command(int32_t p_previous_command_index, int32_t p_command_index, RecordedCommand *r_command) {
 	const uint32_t previous_command_data_offset = command_data_offsets[p_previous_command_index];
 	RecordedCommand &previous_command = *reinterpret_cast<RecordedCommand *>(&command_data[previous_command_data_offset]);
-	previous_command.adjacent_command_list_index = _add_to_command_list(p_command_index, previous_command.adjacent_command_list_index);
+
+	// Commands are added to the graph one at a time, so if the previous command already depends on this one, the edge is
+	// guaranteed to be at the head of its adjacency list. Skipping it keeps the graph free of duplicate edges when both
+	// commands share more than one resource.
+	const int32_t previous_adjacent_index = previous_command.adjacent_command_list_index;
+	if (previous_adjacent_index < 0 || command_list_nodes[previous_adjacent_index].command_index != p_command_index) {
+		previous_command.adjacent_command_list_index = _add_to_command_list(p_command_index, previous_adjacent_index);
+	}
+
 	previous_command.next_stages = previous_command.next_stages | r_command->self_stages;
 	r_command->previous_stages = r_command->previous_stages | previous_command.self_stages;
 }
@@ -2242,15 +2250,37 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 
 	thread_local LocalVector<RecordedCommandSort> commands_sorted;
 	if (p_reorder_commands) {
-		thread_local LocalVector<int64_t> command_stack;
-		thread_local LocalVector<int32_t> sorted_command_indices;
+		thread_local LocalVector<RecordedCommandSort> commands_unsorted;
+		thread_local LocalVector<int32_t> command_stack;
 		thread_local LocalVector<uint32_t> command_degrees;
+		thread_local LocalVector<uint32_t> command_bucket_offsets;
 		int32_t adjacency_list_index = 0;
 		int32_t command_index;
 
+		// Batch buffer, texture, draw lists and compute operations together.
+		const uint32_t PriorityTable[RecordedCommand::TYPE_MAX] = {
+			0, // TYPE_NONE
+			1, // TYPE_BUFFER_CLEAR
+			1, // TYPE_BUFFER_COPY
+			1, // TYPE_BUFFER_GET_DATA
+			1, // TYPE_BUFFER_UPDATE
+			4, // TYPE_COMPUTE_LIST
+			3, // TYPE_DRAW_LIST
+			2, // TYPE_TEXTURE_CLEAR
+			2, // TYPE_TEXTURE_COPY
+			2, // TYPE_TEXTURE_GET_DATA
+			2, // TYPE_TEXTURE_RESOLVE
+			2, // TYPE_TEXTURE_UPDATE
+			2, // TYPE_CAPTURE_TIMESTAMP
+			5, // TYPE_DRIVER_CALLBACK
+		};
+
+		const uint32_t PriorityCount = 6;
+
 		// Count all the incoming connections to every node by traversing their adjacency list.
 		command_degrees.resize(command_count);
 		memset(command_degrees.ptr(), 0, sizeof(uint32_t) * command_degrees.size());
+		commands_unsorted.resize(command_count);
 		for (uint32_t i = 0; i < command_count; i++) {
 			const RecordedCommand &recorded_command = *reinterpret_cast<const RecordedCommand *>(&command_data[command_data_offsets[i]]);
 			adjacency_list_index = recorded_command.adjacent_command_list_index;
@@ -2260,6 +2290,10 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 				command_degrees[command_list_node.command_index] += 1;
 				adjacency_list_index = command_list_node.next_list_index;
 			}
+
+			commands_unsorted[i].level = 0;
+			commands_unsorted[i].priority = PriorityTable[recorded_command.type];
+			commands_unsorted[i].index = i;
 		}
 
 		// Push to the stack all nodes that have no incoming connections.
@@ -2270,14 +2304,16 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 			}
 		}
 
-		sorted_command_indices.clear();
+		// A command is only popped once all the commands it depends on have been visited, so its level is final at that point
+		// and can be propagated to its adjacents in the same pass.
+		uint32_t max_level = 0;
 		while (!command_stack.is_empty()) {
 			// Pop command from the stack.
 			command_index = command_stack[command_stack.size() - 1];
 			command_stack.resize(command_stack.size() - 1);
 
-			// Add it to the sorted commands.
-			sorted_command_indices.push_back(command_index);
+			const uint32_t next_command_level = commands_unsorted[command_index].level + 1;
+			max_level = MAX(max_level, next_command_level - 1);
 
 			// Search for its adjacents and lower their degree for every visit. If the degree reaches zero, we push the command to the stack.
 			const uint32_t command_data_offset = command_data_offsets[command_index];
@@ -2285,6 +2321,11 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 			adjacency_list_index = recorded_command.adjacent_command_list_index;
 			while (adjacency_list_index >= 0) {
 				const RecordedCommandListNode &command_list_node = command_list_nodes[adjacency_list_index];
+				uint32_t &adjacent_command_level = commands_unsorted[command_list_node.command_index].level;
+				if (adjacent_command_level < next_command_level) {
+					adjacent_command_level = next_command_level;
+				}
+
 				uint32_t &command_degree = command_degrees[command_list_node.command_index];
 				DEV_ASSERT(command_degree > 0);
 				command_degree--;
@@ -2296,45 +2337,25 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 			}
 		}
 
-		// Batch buffer, texture, draw lists and compute operations together.
-		const uint32_t PriorityTable[RecordedCommand::TYPE_MAX] = {
-			0, // TYPE_NONE
-			1, // TYPE_BUFFER_CLEAR
-			1, // TYPE_BUFFER_COPY
-			1, // TYPE_BUFFER_GET_DATA
-			1, // TYPE_BUFFER_UPDATE
-			4, // TYPE_COMPUTE_LIST
-			3, // TYPE_DRAW_LIST
-			2, // TYPE_TEXTURE_CLEAR
-			2, // TYPE_TEXTURE_COPY
-			2, // TYPE_TEXTURE_GET_DATA
-			2, // TYPE_TEXTURE_RESOLVE
-			2, // TYPE_TEXTURE_UPDATE
-			2, // TYPE_CAPTURE_TIMESTAMP
-			5, // TYPE_DRIVER_CALLBACK
-		};
+		// Levels are bounded by the command count and priorities by the table above, so the commands can be ordered with a
+		// counting sort over (level, priority) instead of a comparison sort. Commands are distributed in index order, which
+		// yields the same order as sorting by (level, priority, index).
+		const uint32_t bucket_count = (max_level + 1) * PriorityCount;
+		command_bucket_offsets.resize(bucket_count + 1);
+		memset(command_bucket_offsets.ptr(), 0, sizeof(uint32_t) * command_bucket_offsets.size());
+		for (uint32_t i = 0; i < command_count; i++) {
+			command_bucket_offsets[commands_unsorted[i].level * PriorityCount + commands_unsorted[i].priority + 1]++;
+		}
+
+		for (uint32_t i = 1; i <= bucket_count; i++) {
+			command_bucket_offsets[i] += command_bucket_offsets[i - 1];
+		}
 
 		commands_sorted.clear();
 		commands_sorted.resize(command_count);
-
 		for (uint32_t i = 0; i < command_count; i++) {
-			const int32_t sorted_command_index = sorted_command_indices[i];
-			const uint32_t command_data_offset = command_data_offsets[sorted_command_index];
-			const RecordedCommand recorded_command = *reinterpret_cast<const RecordedCommand *>(&command_data[command_data_offset]);
-			const uint32_t next_command_level = commands_sorted[sorted_command_index].level + 1;
-			adjacency_list_index = recorded_command.adjacent_command_list_index;
-			while (adjacency_list_index >= 0) {
-				const RecordedCommandListNode &command_list_node = command_list_nodes[adjacency_list_index];
-				uint32_t &adjacent_command_level = commands_sorted[command_list_node.command_index].level;
-				if (adjacent_command_level < next_command_level) {
-					adjacent_command_level = next_command_level;
-				}
-
-				adjacency_list_index = command_list_node.next_list_index;
-			}
-
-			commands_sorted[sorted_command_index].index = sorted_command_index;
-			commands_sorted[sorted_command_index].priority = PriorityTable[recorded_command.type];
+			const RecordedCommandSort &command_sort = commands_unsorted[i];
+			commands_sorted[command_bucket_offsets[command_sort.level * PriorityCount + command_sort.priority]++] = command_sort;
 		}
 	} else {
 		commands_sorted.clear();
@@ -2358,13 +2379,6 @@ void RenderingDeviceGraph::end(bool p_reorder_commands, bool p_full_barriers, RD
 		}
 
 		if (p_reorder_commands) {
-#if PRINT_RENDER_GRAPH
-			print_line("BEFORE SORT");
-			_print_render_commands(commands_sorted.ptr(), command_count);
-#endif
-
-			commands_sorted.sort();
-
 #if PRINT_RENDER_GRAPH
 			print_line("AFTER SORT");
 			_print_render_commands(commands_sorted.ptr(), command_count);
@@ -38,6 +38,7 @@
 #include "renderer_viewport.h"
 #include "rendering_server_globals.h"
 #include "servers/rendering/renderer_compositor.h"
+#include "servers/rendering/shader_compiler.h"
 #include "servers/rendering_server.h"
 #include "servers/server_wrap_mt_common.h"
 
@@ -272,6 +273,12 @@ public:
 	}
 
 	FUNC2(shader_set_code, RID, const String &)
+
+	virtual void shader_precompile_code(const String &p_code, const Callable &p_on_ready = Callable()) override {
+		// Runs on worker threads, doesn't go through the command queue.
+		ShaderCompiler::precompile_async(p_code, p_on_ready);
+	}
+
 	FUNC2(shader_set_path_hint, RID, const String &)
 	FUNC1RC(String, shader_get_code, RID)
 
@@ -30,6 +30,11 @@
 
 #include "shader_compiler.h"
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/string/string_builder.h"
+#include "core/version.h"
 #include "servers/rendering/rendering_server_globals.h"
 #include "servers/rendering/shader_types.h"
 
@@ -446,6 +451,30 @@ static String _get_global_shader_uniform_from_type_and_index(const String &p_buf
 	}
 }
 
+void ShaderCompiler::_apply_render_modes(const Vector<StringName> &p_render_modes, const Vector<StringName> &p_stencil_modes, int p_stencil_reference, IdentifierActions &p_actions) {
+	for (int i = 0; i < p_render_modes.size(); i++) {
+		if (p_actions.render_mode_flags.has(p_render_modes[i])) {
+			*p_actions.render_mode_flags[p_render_modes[i]] = true;
+		}
+
+		if (p_actions.render_mode_values.has(p_render_modes[i])) {
+			Pair<int *, int> &p = p_actions.render_mode_values[p_render_modes[i]];
+			*p.first = p.second;
+		}
+	}
+
+	for (int i = 0; i < p_stencil_modes.size(); i++) {
+		if (p_actions.stencil_mode_values.has(p_stencil_modes[i])) {
+			Pair<int *, int> &p = p_actions.stencil_mode_values[p_stencil_modes[i]];
+			*p.first = p.second;
+		}
+	}
+
+	if (p_actions.stencil_reference && p_stencil_reference != -1) {
+		*p_actions.stencil_reference = p_stencil_reference;
+	}
+}
+
 String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, GeneratedCode &r_gen_code, IdentifierActions &p_actions, const DefaultIdentifierActions &p_default_actions, bool p_assigning, bool p_use_scope) {
 	String code;
 
@@ -460,31 +489,11 @@ String ShaderCompiler::_dump_node_code(const SL::Node *p_node, int p_level, Gene
 					r_gen_code.defines.push_back(p_default_actions.render_mode_defines[pnode->render_modes[i]]);
 					used_rmode_defines.insert(pnode->render_modes[i]);
 				}
-
-				if (p_actions.render_mode_flags.has(pnode->render_modes[i])) {
-					*p_actions.render_mode_flags[pnode->render_modes[i]] = true;
-				}
-
-				if (p_actions.render_mode_values.has(pnode->render_modes[i])) {
-					Pair<int *, int> &p = p_actions.render_mode_values[pnode->render_modes[i]];
-					*p.first = p.second;
-				}
 			}
 
-			// Stencil modes.
+			// Render mode, stencil mode and stencil reference values.
 
-			for (int i = 0; i < pnode->stencil_modes.size(); i++) {
-				if (p_actions.stencil_mode_values.has(pnode->stencil_modes[i])) {
-					Pair<int *, int> &p = p_actions.stencil_mode_values[pnode->stencil_modes[i]];
-					*p.first = p.second;
-				}
-			}
-
-			// Stencil reference value.
-
-			if (p_actions.stencil_reference && pnode->stencil_reference != -1) {
-				*p_actions.stencil_reference = pnode->stencil_reference;
-			}
+			_apply_render_modes(pnode->render_modes, pnode->stencil_modes, pnode->stencil_reference, p_actions);
 
 			// structs
 
@@ -1476,17 +1485,527 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
+String ShaderCompiler::result_cache_dir;
+BinaryMutex ShaderCompiler::result_cache_write_mutex;
+HashMap<String, ShaderCompiler::CachedResult> ShaderCompiler::result_cache_writes;
+WorkerThreadPool::TaskID ShaderCompiler::result_cache_write_task = WorkerThreadPool::INVALID_TASK_ID;
+bool ShaderCompiler::result_cache_writing = false;
+uint32_t ShaderCompiler::result_cache_writes_since_prune = RESULT_CACHE_PRUNE_INTERVAL;
+
+static const char *result_cache_file_header = "GDSR";
+static const uint32_t result_cache_file_version = 1;
+
+String ShaderCompiler::_get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const {
+	// The engine version is part of the key, so results from other builds are never reused.
+	StringBuilder hash_build;
+	hash_build.append("[version]");
+	hash_build.append(GODOT_VERSION_FULL_BUILD);
+	hash_build.append(GODOT_VERSION_HASH);
+	hash_build.append(itos(result_cache_file_version));
+	hash_build.append("[mode]");
+	hash_build.append(itos(p_mode));
+	hash_build.append(RS::get_singleton()->is_low_end() ? "low_end" : "");
+	hash_build.append("[default_actions]");
+	hash_build.append(actions_hash);
+
+	// Only the set of identifiers matters here, the pointers are rebound on every call.
+	hash_build.append("[actions]");
+	for (const KeyValue<StringName, Stage> &E : p_actions->entry_point_stages) {
+		hash_build.append(String(E.key) + ":" + itos(E.value) + ";");
+	}
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->render_mode_values) {
+		hash_build.append(String(E.key) + "=" + itos(E.value.second) + ";");
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->render_mode_flags) {
+		hash_build.append(String(E.key) + ";");
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->usage_flag_pointers) {
+		hash_build.append(String(E.key) + ";");
+	}
+	for (const KeyValue<StringName, bool *> &E : p_actions->write_flag_pointers) {
+		hash_build.append(String(E.key) + ";");
+	}
+	for (const KeyValue<StringName, Pair<int *, int>> &E : p_actions->stencil_mode_values) {
+		hash_build.append(String(E.key) + "=" + itos(E.value.second) + ";");
+	}
+	hash_build.append(p_actions->stencil_reference ? "stencil_reference" : "");
+
+	hash_build.append("[code]");
+	hash_build.append(p_code);
+
+	return hash_build.as_string().sha256_text();
+}
+
+void ShaderCompiler::_apply_cached_result(const CachedResult &p_result, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	r_gen_code = p_result.gen_code;
+
+	_apply_render_modes(p_result.render_modes, p_result.stencil_modes, p_result.stencil_reference, *p_actions);
+
+	for (const StringName &E : p_result.usage_flags) {
+		*p_actions->usage_flag_pointers[E] = true;
+	}
+	for (const StringName &E : p_result.write_flags) {
+		*p_actions->write_flag_pointers[E] = true;
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_result.uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+}
+
+static void _store_string_names(Ref<FileAccess> p_file, const Vector<StringName> &p_names) {
+	p_file->store_32(p_names.size());
+	for (const StringName &E : p_names) {
+		p_file->store_pascal_string(E);
+	}
+}
+
+static Vector<StringName> _get_string_names(Ref<FileAccess> p_file) {
+	Vector<StringName> names;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		names.push_back(p_file->get_pascal_string());
+	}
+	return names;
+}
+
+static void _store_strings(Ref<FileAccess> p_file, const Vector<String> &p_strings) {
+	p_file->store_32(p_strings.size());
+	for (const String &E : p_strings) {
+		p_file->store_pascal_string(E);
+	}
+}
+
+static Vector<String> _get_strings(Ref<FileAccess> p_file) {
+	Vector<String> strings;
+	uint32_t count = p_file->get_32();
+	for (uint32_t i = 0; i < count && !p_file->eof_reached(); i++) {
+		strings.push_back(p_file->get_pascal_string());
+	}
+	return strings;
+}
+
+bool ShaderCompiler::_load_cached_result(const String &p_key, CachedResult &r_result) {
+	if (result_cache_dir.is_empty()) {
+		return false;
+	}
+
+	{
+		MutexLock lock(result_cache_write_mutex);
+		const CachedResult *queued = result_cache_writes.getptr(p_key);
+		if (queued) {
+			r_result = *queued;
+			return true;
+		}
+	}
+
+	Ref<FileAccess> f = FileAccess::open(result_cache_dir.path_join(p_key + ".cache"), FileAccess::READ);
+	if (f.is_null()) {
+		return false;
+	}
+
+	char header[5] = { 0, 0, 0, 0, 0 };
+	f->get_buffer((uint8_t *)header, 4);
+	ERR_FAIL_COND_V(header != String(result_cache_file_header), false);
+
+	if (f->get_32() != result_cache_file_version) {
+		return false; // Wrong version.
+	}
+
+	GeneratedCode &gen_code = r_result.gen_code;
+	gen_code.defines = _get_strings(f);
+
+	uint32_t texture_count = f->get_32();
+	gen_code.texture_uniforms.resize(texture_count);
+	for (uint32_t i = 0; i < texture_count; i++) {
+		GeneratedCode::Texture &texture = gen_code.texture_uniforms.write[i];
+		texture.name = f->get_pascal_string();
+		texture.type = SL::DataType(f->get_32());
+		texture.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		texture.use_color = f->get_8();
+		texture.filter = SL::TextureFilter(f->get_32());
+		texture.repeat = SL::TextureRepeat(f->get_32());
+		texture.global = f->get_8();
+		texture.array_size = f->get_32();
+	}
+
+	uint32_t offset_count = f->get_32();
+	gen_code.uniform_offsets.resize(offset_count);
+	for (uint32_t i = 0; i < offset_count; i++) {
+		gen_code.uniform_offsets.write[i] = f->get_32();
+	}
+	gen_code.uniform_total_size = f->get_32();
+	gen_code.uniforms = f->get_pascal_string();
+	for (int i = 0; i < STAGE_MAX; i++) {
+		gen_code.stage_globals[i] = f->get_pascal_string();
+	}
+
+	uint32_t code_count = f->get_32();
+	for (uint32_t i = 0; i < code_count; i++) {
+		String name = f->get_pascal_string();
+		gen_code.code[name] = f->get_pascal_string();
+	}
+
+	uint8_t uses = f->get_8();
+	gen_code.uses_global_textures = uses & (1 << 0);
+	gen_code.uses_fragment_time = uses & (1 << 1);
+	gen_code.uses_vertex_time = uses & (1 << 2);
+	gen_code.uses_screen_texture_mipmaps = uses & (1 << 3);
+	gen_code.uses_screen_texture = uses & (1 << 4);
+	gen_code.uses_depth_texture = uses & (1 << 5);
+	gen_code.uses_normal_roughness_texture = uses & (1 << 6);
+
+	r_result.render_modes = _get_string_names(f);
+	r_result.stencil_modes = _get_string_names(f);
+	r_result.stencil_reference = int32_t(f->get_32());
+	r_result.usage_flags = _get_string_names(f);
+	r_result.write_flags = _get_string_names(f);
+
+	uint32_t uniform_count = f->get_32();
+	for (uint32_t i = 0; i < uniform_count; i++) {
+		StringName name = f->get_pascal_string();
+		SL::ShaderNode::Uniform uniform;
+		uniform.order = int32_t(f->get_32());
+		uniform.prop_order = int32_t(f->get_32());
+		uniform.texture_order = int32_t(f->get_32());
+		uniform.texture_binding = int32_t(f->get_32());
+		uniform.type = SL::DataType(f->get_32());
+		uniform.precision = SL::DataPrecision(f->get_32());
+		uniform.array_size = int32_t(f->get_32());
+		uint32_t default_value_count = f->get_32();
+		uniform.default_value.resize(default_value_count);
+		for (uint32_t j = 0; j < default_value_count; j++) {
+			uniform.default_value.write[j].uint = f->get_32();
+		}
+		uniform.scope = SL::ShaderNode::Uniform::Scope(f->get_32());
+		uniform.hint = SL::ShaderNode::Uniform::Hint(f->get_32());
+		uniform.use_color = f->get_8();
+		uniform.filter = SL::TextureFilter(f->get_32());
+		uniform.repeat = SL::TextureRepeat(f->get_32());
+		for (int j = 0; j < 3; j++) {
+			uniform.hint_range[j] = f->get_float();
+		}
+		uniform.hint_enum_names = _get_strings(f);
+		uniform.instance_index = int32_t(f->get_32());
+		uniform.group = f->get_pascal_string();
+		uniform.subgroup = f->get_pascal_string();
+		r_result.uniforms.insert(name, uniform);
+	}
+
+	// A truncated file is treated as a miss.
+	f->get_32();
+	return !f->eof_reached();
+}
+
+void ShaderCompiler::_save_cached_result(const String &p_key, const CachedResult &p_result) {
+	if (result_cache_dir.is_empty()) {
+		return;
+	}
+
+	Ref<FileAccess> f = FileAccess::open(result_cache_dir.path_join(p_key + ".cache"), FileAccess::WRITE);
+	ERR_FAIL_COND(f.is_null());
+
+	f->store_buffer((const uint8_t *)result_cache_file_header, 4);
+	f->store_32(result_cache_file_version);
+
+	const GeneratedCode &gen_code = p_result.gen_code;
+	_store_strings(f, gen_code.defines);
+
+	f->store_32(gen_code.texture_uniforms.size());
+	for (const GeneratedCode::Texture &texture : gen_code.texture_uniforms) {
+		f->store_pascal_string(texture.name);
+		f->store_32(texture.type);
+		f->store_32(texture.hint);
+		f->store_8(texture.use_color);
+		f->store_32(texture.filter);
+		f->store_32(texture.repeat);
+		f->store_8(texture.global);
+		f->store_32(texture.array_size);
+	}
+
+	f->store_32(gen_code.uniform_offsets.size());
+	for (uint32_t offset : gen_code.uniform_offsets) {
+		f->store_32(offset);
+	}
+	f->store_32(gen_code.uniform_total_size);
+	f->store_pascal_string(gen_code.uniforms);
+	for (int i = 0; i < STAGE_MAX; i++) {
+		f->store_pascal_string(gen_code.stage_globals[i]);
+	}
+
+	f->store_32(gen_code.code.size());
+	for (const KeyValue<String, String> &E : gen_code.code) {
+		f->store_pascal_string(E.key);
+		f->store_pascal_string(E.value);
+	}
+
+	uint8_t uses = 0;
+	uses |= gen_code.uses_global_textures ? (1 << 0) : 0;
+	uses |= gen_code.uses_fragment_time ? (1 << 1) : 0;
+	uses |= gen_code.uses_vertex_time ? (1 << 2) : 0;
+	uses |= gen_code.uses_screen_texture_mipmaps ? (1 << 3) : 0;
+	uses |= gen_code.uses_screen_texture ? (1 << 4) : 0;
+	uses |= gen_code.uses_depth_texture ? (1 << 5) : 0;
+	uses |= gen_code.uses_normal_roughness_texture ? (1 << 6) : 0;
+	f->store_8(uses);
+
+	_store_string_names(f, p_result.render_modes);
+	_store_string_names(f, p_result.stencil_modes);
+	f->store_32(uint32_t(p_result.stencil_reference));
+	_store_string_names(f, p_result.usage_flags);
+	_store_string_names(f, p_result.write_flags);
+
+	f->store_32(p_result.uniforms.size());
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_result.uniforms) {
+		const SL::ShaderNode::Uniform &uniform = E.value;
+		f->store_pascal_string(E.key);
+		f->store_32(uint32_t(uniform.order));
+		f->store_32(uint32_t(uniform.prop_order));
+		f->store_32(uint32_t(uniform.texture_order));
+		f->store_32(uint32_t(uniform.texture_binding));
+		f->store_32(uniform.type);
+		f->store_32(uniform.precision);
+		f->store_32(uint32_t(uniform.array_size));
+		f->store_32(uniform.default_value.size());
+		for (const SL::Scalar &value : uniform.default_value) {
+			f->store_32(value.uint);
+		}
+		f->store_32(uniform.scope);
+		f->store_32(uniform.hint);
+		f->store_8(uniform.use_color);
+		f->store_32(uniform.filter);
+		f->store_32(uniform.repeat);
+		for (int j = 0; j < 3; j++) {
+			f->store_float(uniform.hint_range[j]);
+		}
+		_store_strings(f, uniform.hint_enum_names);
+		f->store_32(uint32_t(uniform.instance_index));
+		f->store_pascal_string(uniform.group);
+		f->store_pascal_string(uniform.subgroup);
+	}
+	// Sentinel so the reader can tell a complete file from a truncated one.
+	f->store_32(0);
+}
+
+void ShaderCompiler::_queue_cached_result_write(const String &p_key, const CachedResult &p_result) {
+	if (result_cache_dir.is_empty()) {
+		return;
+	}
+
+	WorkerThreadPool::TaskID previous_task = WorkerThreadPool::INVALID_TASK_ID;
+	{
+		MutexLock lock(result_cache_write_mutex);
+		result_cache_writes.insert(p_key, p_result);
+		if (!result_cache_writing) {
+			// The previous writer ran out of work and is exiting (or gone), start a new one.
+			result_cache_writing = true;
+			previous_task = result_cache_write_task;
+			result_cache_write_task = WorkerThreadPool::get_singleton()->add_native_task(&ShaderCompiler::_write_cached_results_task, nullptr, false, "Write shader compiler cache");
+		}
+	}
+
+	if (previous_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(previous_task);
+	}
+}
+
+void ShaderCompiler::_write_cached_results_task(void *p_userdata) {
+	while (true) {
+		String key;
+		CachedResult result;
+		bool prune = false;
+		{
+			MutexLock lock(result_cache_write_mutex);
+			if (result_cache_writes.is_empty()) {
+				if (result_cache_writes_since_prune < RESULT_CACHE_PRUNE_INTERVAL) {
+					result_cache_writing = false;
+					return;
+				}
+				result_cache_writes_since_prune = 0;
+				prune = true;
+			} else {
+				HashMap<String, CachedResult>::ConstIterator E = result_cache_writes.begin();
+				key = E->key;
+				result = E->value;
+			}
+		}
+
+		if (prune) {
+			// Results queued meanwhile are picked up on the next iteration.
+			_prune_result_cache_dir();
+			continue;
+		}
+
+		_save_cached_result(key, result);
+
+		MutexLock lock(result_cache_write_mutex);
+		// Only drop the entry once it can be read back from disk.
+		result_cache_writes.erase(key);
+		result_cache_writes_since_prune++;
+	}
+}
+
+void ShaderCompiler::_flush_cached_result_writes() {
+	WorkerThreadPool::TaskID task = WorkerThreadPool::INVALID_TASK_ID;
+	{
+		MutexLock lock(result_cache_write_mutex);
+		task = result_cache_write_task;
+		result_cache_write_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+	if (task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
+void ShaderCompiler::_prune_result_cache_dir() {
+	Ref<DirAccess> da = DirAccess::open(result_cache_dir);
+	ERR_FAIL_COND(da.is_null());
+
+	struct CacheFile {
+		String path;
+		uint64_t modified_time = 0;
+		uint64_t size = 0;
+
+		bool operator<(const CacheFile &p_other) const {
+			return modified_time < p_other.modified_time;
+		}
+	};
+
+	LocalVector<CacheFile> files;
+	uint64_t total_size = 0;
+
+	da->list_dir_begin();
+	for (String name = da->get_next(); !name.is_empty(); name = da->get_next()) {
+		if (da->current_is_dir() || name.get_extension() != "cache") {
+			continue;
+		}
+		CacheFile file;
+		file.path = result_cache_dir.path_join(name);
+		Ref<FileAccess> f = FileAccess::open(file.path, FileAccess::READ);
+		if (f.is_null()) {
+			continue;
+		}
+		file.size = f->get_length();
+		file.modified_time = FileAccess::get_modified_time(file.path);
+		total_size += file.size;
+		files.push_back(file);
+	}
+	da->list_dir_end();
+
+	if (total_size <= RESULT_CACHE_DIR_MAX_SIZE) {
+		return;
+	}
+
+	// Least recently written first. Results that are still in use get written again
+	// after being evicted, so this approximates least recently used.
+	files.sort();
+	const uint64_t target_size = RESULT_CACHE_DIR_MAX_SIZE - RESULT_CACHE_DIR_MAX_SIZE / 4;
+	uint32_t removed = 0;
+	for (const CacheFile &file : files) {
+		if (total_size <= target_size) {
+			break;
+		}
+		if (DirAccess::remove_absolute(file.path) == OK) {
+			total_size -= file.size;
+			removed++;
+		}
+	}
+	print_verbose(vformat("ShaderCompiler: Removed %d stale entries from the result cache.", removed));
+}
+
+void ShaderCompiler::set_result_cache_dir(const String &p_dir) {
+	// Pending results belong to the old directory, finish them before switching.
+	_flush_cached_result_writes();
+
+	result_cache_dir = p_dir;
+
+	MutexLock lock(result_cache_write_mutex);
+	// Check the size of the new directory with the first batch of writes.
+	result_cache_writes_since_prune = RESULT_CACHE_PRUNE_INTERVAL;
+}
+
+const String &ShaderCompiler::get_result_cache_dir() {
+	return result_cache_dir;
+}
+
+bool ShaderCompiler::_get_cached_result(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	WorkerThreadPool::TaskID pending_task = WorkerThreadPool::INVALID_TASK_ID;
+	{
+		MutexLock lock(result_cache_mutex);
+		const CachedResult *cached = result_cache.getptr(p_key);
+		if (cached) {
+			_apply_cached_result(*cached, p_actions, r_gen_code);
+			return true;
+		}
+		WorkerThreadPool::TaskID *task = pending_precompiles.getptr(p_key);
+		if (task) {
+			pending_task = *task;
+			pending_precompiles.erase(p_key);
+		}
+	}
+
+	if (pending_task != WorkerThreadPool::INVALID_TASK_ID) {
+		// The same code is being compiled on a worker thread already, wait for it instead of doing the work twice.
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pending_task);
+
+		MutexLock lock(result_cache_mutex);
+		const CachedResult *cached = result_cache.getptr(p_key);
+		if (cached) {
+			_apply_cached_result(*cached, p_actions, r_gen_code);
+			return true;
+		}
+	}
+
+	CachedResult loaded;
+	if (_load_cached_result(p_key, loaded)) {
+		_apply_cached_result(loaded, p_actions, r_gen_code);
+		MutexLock lock(result_cache_mutex);
+		result_cache.insert(p_key, loaded);
+		return true;
+	}
+
+	return false;
+}
+
+void ShaderCompiler::_store_result(const String &p_key, const CachedResult &p_result) {
+	_queue_cached_result_write(p_key, p_result);
+
+	MutexLock lock(result_cache_mutex);
+	result_cache.insert(p_key, p_result);
+}
+
 Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	String cache_key = _get_cache_key(p_mode, p_code, p_actions);
+
+	if (_get_cached_result(cache_key, p_actions, r_gen_code)) {
+		return OK;
+	}
+
+	_register_actions_template(p_mode, *p_actions);
+
+	CachedResult result;
+	bool cacheable = false;
+	Error err = _compile(p_mode, p_code, p_actions, p_path, r_gen_code, _get_global_shader_uniform_type, true, result, cacheable);
+	if (err == OK && cacheable) {
+		_store_result(cache_key, result);
+	}
+	return err;
+}
+
+Error ShaderCompiler::_compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code, ShaderLanguage::GlobalShaderUniformGetTypeFunc p_global_uniform_type_func, bool p_print_errors, CachedResult &r_result, bool &r_cacheable) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
 	info.stencil_modes = ShaderTypes::get_singleton()->get_stencil_modes(p_mode);
 	info.shader_types = ShaderTypes::get_singleton()->get_types();
-	info.global_shader_uniform_type_func = _get_global_shader_uniform_type;
+	info.global_shader_uniform_type_func = p_global_uniform_type_func;
 	info.base_varying_index = actions.base_varying_index;
 
 	Error err = parser.compile(p_code, info);
 
+	if (err != OK && !p_print_errors) {
+		return err;
+	}
+
 	if (err != OK) {
 		Vector<ShaderLanguage::FilePosition> include_positions = parser.get_include_positions();
 
@@ -1581,15 +2100,228 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 
 	shader = parser.get_shader();
 	function = nullptr;
+
+	// Route usage and write flags through local storage, so the flags raised
+	// by this shader can be recorded for the result cache.
+	IdentifierActions recorded_actions = *p_actions;
+	HashMap<StringName, bool> usage_flags;
+	HashMap<StringName, bool> write_flags;
+	for (KeyValue<StringName, bool *> &E : recorded_actions.usage_flag_pointers) {
+		E.value = &usage_flags.insert(E.key, false)->value;
+	}
+	for (KeyValue<StringName, bool *> &E : recorded_actions.write_flag_pointers) {
+		E.value = &write_flags.insert(E.key, false)->value;
+	}
+
 	// Return value only relevant within nested calls.
-	_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, *p_actions, actions, false);
+	_ALLOW_DISCARD_ _dump_node_code(shader, 1, r_gen_code, recorded_actions, actions, false);
+
+	CachedResult &result = r_result;
+	for (const KeyValue<StringName, bool> &E : usage_flags) {
+		if (E.value) {
+			*p_actions->usage_flag_pointers[E.key] = true;
+			result.usage_flags.push_back(E.key);
+		}
+	}
+	for (const KeyValue<StringName, bool> &E : write_flags) {
+		if (E.value) {
+			*p_actions->write_flag_pointers[E.key] = true;
+			result.write_flags.push_back(E.key);
+		}
+	}
+
+	// Global uniform types come from the project settings rather than the code, so these results can't be keyed by the code alone.
+	bool cacheable = true;
+	Vector<StringName> uniform_names;
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : shader->uniforms) {
+		if (E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL) {
+			cacheable = false;
+			break;
+		}
+		uniform_names.push_back(E.key);
+	}
+	uniform_names.sort_custom<StringName::AlphCompare>(); // Same insertion order as _dump_node_code().
+
+	for (const StringName &E : uniform_names) {
+		// Mirrors the uniforms inserted into the actions by _dump_node_code().
+		const SL::ShaderNode::Uniform &uniform = shader->uniforms[E];
+		if (uniform.scope == SL::ShaderNode::Uniform::SCOPE_INSTANCE || (uniform.hint != SL::ShaderNode::Uniform::HINT_SCREEN_TEXTURE && uniform.hint != SL::ShaderNode::Uniform::HINT_NORMAL_ROUGHNESS_TEXTURE && uniform.hint != SL::ShaderNode::Uniform::HINT_DEPTH_TEXTURE)) {
+			result.uniforms.insert(E, uniform);
+		}
+	}
+
+	if (cacheable) {
+		result.gen_code = r_gen_code;
+		result.render_modes = shader->render_modes;
+		result.stencil_modes = shader->stencil_modes;
+		result.stencil_reference = shader->stencil_reference;
+	}
+	r_cacheable = cacheable;
 
 	return OK;
 }
 
+/* ASYNC PRECOMPILATION */
+
+BinaryMutex ShaderCompiler::mode_compilers_mutex;
+ShaderCompiler *ShaderCompiler::mode_compilers[RS::SHADER_MAX] = {};
+
+void ShaderCompiler::_register_actions_template(RS::ShaderMode p_mode, const IdentifierActions &p_actions) {
+	ERR_FAIL_INDEX(p_mode, RS::SHADER_MAX);
+	{
+		MutexLock lock(result_cache_mutex);
+		if (has_actions_template[p_mode]) {
+			return;
+		}
+		actions_templates[p_mode] = p_actions;
+		has_actions_template[p_mode] = true;
+	}
+
+	MutexLock lock(mode_compilers_mutex);
+	mode_compilers[p_mode] = this;
+}
+
+ShaderLanguage::DataType ShaderCompiler::_get_no_global_shader_uniform_type(const StringName &p_name) {
+	// Global shader parameters live in the material storage, which can't be accessed from worker threads.
+	return ShaderLanguage::TYPE_MAX;
+}
+
+void ShaderCompiler::_precompile_task(void *p_userdata) {
+	PrecompileTask *task = (PrecompileTask *)p_userdata;
+
+	// Every identifier action points to scratch storage, only the recorded result is kept.
+	IdentifierActions scratch_actions = task->actions;
+	HashMap<StringName, int> scratch_values;
+	HashMap<StringName, bool> scratch_flags;
+	HashMap<StringName, SL::ShaderNode::Uniform> scratch_uniforms;
+	int scratch_stencil_reference = -1;
+	for (KeyValue<StringName, Pair<int *, int>> &E : scratch_actions.render_mode_values) {
+		E.value.first = &scratch_values.insert(E.key, 0)->value;
+	}
+	for (KeyValue<StringName, Pair<int *, int>> &E : scratch_actions.stencil_mode_values) {
+		E.value.first = &scratch_values.insert(E.key, 0)->value;
+	}
+	for (KeyValue<StringName, bool *> &E : scratch_actions.render_mode_flags) {
+		E.value = &scratch_flags.insert(E.key, false)->value;
+	}
+	for (KeyValue<StringName, bool *> &E : scratch_actions.usage_flag_pointers) {
+		E.value = &scratch_flags.insert(E.key, false)->value;
+	}
+	for (KeyValue<StringName, bool *> &E : scratch_actions.write_flag_pointers) {
+		E.value = &scratch_flags.insert(E.key, false)->value;
+	}
+	if (scratch_actions.stencil_reference) {
+		scratch_actions.stencil_reference = &scratch_stencil_reference;
+	}
+	scratch_actions.uniforms = &scratch_uniforms;
+
+	ShaderCompiler compiler;
+	compiler.initialize(task->owner->actions);
+
+	GeneratedCode gen_code;
+	CachedResult result;
+	bool cacheable = false;
+	Error err = compiler._compile(task->mode, task->code, &scratch_actions, String(), gen_code, _get_no_global_shader_uniform_type, false, result, cacheable);
+	if (err == OK && cacheable) {
+		task->owner->_store_result(task->key, result);
+	}
+
+	if (task->on_ready.is_valid()) {
+		task->on_ready.call_deferred(err == OK);
+	}
+	memdelete(task);
+}
+
+void ShaderCompiler::_collect_finished_precompiles() {
+	LocalVector<WorkerThreadPool::TaskID> finished;
+	{
+		MutexLock lock(result_cache_mutex);
+		LocalVector<String> finished_keys;
+		for (const KeyValue<String, WorkerThreadPool::TaskID> &E : pending_precompiles) {
+			if (WorkerThreadPool::get_singleton()->is_task_completed(E.value)) {
+				finished_keys.push_back(E.key);
+				finished.push_back(E.value);
+			}
+		}
+		for (const String &E : finished_keys) {
+			pending_precompiles.erase(E);
+		}
+	}
+
+	// Completed tasks still have to be waited on to be released.
+	for (WorkerThreadPool::TaskID E : finished) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(E);
+	}
+}
+
+void ShaderCompiler::precompile_async(const String &p_code, const Callable &p_on_ready) {
+	String type = ShaderLanguage::get_shader_type(p_code);
+	RS::ShaderMode mode = RS::SHADER_MAX;
+	if (type == "canvas_item") {
+		mode = RS::SHADER_CANVAS_ITEM;
+	} else if (type == "particles") {
+		mode = RS::SHADER_PARTICLES;
+	} else if (type == "spatial") {
+		mode = RS::SHADER_SPATIAL;
+	} else if (type == "sky") {
+		mode = RS::SHADER_SKY;
+	} else if (type == "fog") {
+		mode = RS::SHADER_FOG;
+	}
+
+	MutexLock lock(mode_compilers_mutex);
+	ShaderCompiler *owner = mode < RS::SHADER_MAX ? mode_compilers[mode] : nullptr;
+	if (!owner) {
+		// No shader of this mode was compiled yet, so there's nothing to compile against.
+		if (p_on_ready.is_valid()) {
+			p_on_ready.call_deferred(false);
+		}
+		return;
+	}
+
+	owner->_collect_finished_precompiles();
+
+	PrecompileTask *task = memnew(PrecompileTask);
+	task->owner = owner;
+	task->mode = mode;
+	task->code = p_code;
+	task->on_ready = p_on_ready;
+	{
+		MutexLock cache_lock(owner->result_cache_mutex);
+		task->actions = owner->actions_templates[mode];
+		task->key = owner->_get_cache_key(mode, p_code, &task->actions);
+		if (owner->result_cache.has(task->key) || owner->pending_precompiles.has(task->key)) {
+			memdelete(task);
+			if (p_on_ready.is_valid()) {
+				p_on_ready.call_deferred(true);
+			}
+			return;
+		}
+		owner->pending_precompiles[task->key] = WorkerThreadPool::get_singleton()->add_native_task(&ShaderCompiler::_precompile_task, task, false, SNAME("ShaderPrecompile"));
+	}
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
 
+	StringBuilder hash_build;
+	for (const KeyValue<StringName, String> &E : actions.renames) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	for (const KeyValue<StringName, String> &E : actions.render_mode_defines) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	for (const KeyValue<StringName, String> &E : actions.usage_defines) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	for (const KeyValue<StringName, String> &E : actions.custom_samplers) {
+		hash_build.append(String(E.key) + "=" + E.value + ";");
+	}
+	hash_build.append(vformat("%d;%d;%d;%d;%d;%d;%d;", actions.default_filter, actions.default_repeat, actions.base_texture_binding_index, actions.texture_layout_set, actions.base_varying_index, actions.apply_luminance_multiplier, actions.check_multiview_samplers));
+	hash_build.append(actions.base_uniform_string + ";" + actions.global_buffer_array_variable + ";" + actions.instance_uniform_index_variable);
+	actions_hash = hash_build.as_string().sha256_text();
+	result_cache.clear();
+
 	time_name = "TIME";
 
 	List<String> func_list;
@@ -1614,3 +2346,26 @@ void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 
 ShaderCompiler::ShaderCompiler() {
 }
+
+ShaderCompiler::~ShaderCompiler() {
+	{
+		MutexLock lock(mode_compilers_mutex);
+		for (int i = 0; i < RS::SHADER_MAX; i++) {
+			if (mode_compilers[i] == this) {
+				mode_compilers[i] = nullptr;
+			}
+		}
+	}
+
+	LocalVector<WorkerThreadPool::TaskID> pending;
+	{
+		MutexLock lock(result_cache_mutex);
+		for (const KeyValue<String, WorkerThreadPool::TaskID> &E : pending_precompiles) {
+			pending.push_back(E.value);
+		}
+		pending_precompiles.clear();
+	}
+	for (WorkerThreadPool::TaskID E : pending) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(E);
+	}
+}
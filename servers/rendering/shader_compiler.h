@@ -30,6 +30,9 @@
 
 #pragma once
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/lru.h"
 #include "core/templates/pair.h"
 #include "servers/rendering/shader_language.h"
 #include "servers/rendering_server.h"
@@ -128,9 +131,95 @@ private:
 
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
+	/* RESULT CACHE */
+
+	// Everything a successful compile produces, including the side effects on the
+	// IdentifierActions, so it can be replayed without parsing the code again.
+	struct CachedResult {
+		GeneratedCode gen_code;
+		Vector<StringName> render_modes;
+		Vector<StringName> stencil_modes;
+		int stencil_reference = -1;
+		Vector<StringName> usage_flags;
+		Vector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	};
+
+	static constexpr int RESULT_CACHE_CAPACITY = 256;
+	// Once the files in the result cache directory exceed this size, the oldest ones are
+	// deleted until a quarter of it is free again.
+	static constexpr uint64_t RESULT_CACHE_DIR_MAX_SIZE = 64 * 1024 * 1024;
+	// Number of files written between two checks of the directory size.
+	static constexpr uint32_t RESULT_CACHE_PRUNE_INTERVAL = 64;
+
+	static String result_cache_dir;
+
+	// Results are written to disk by a single worker task, so compiling never waits on file IO.
+	// Queued results stay readable until they are written.
+	static BinaryMutex result_cache_write_mutex;
+	static HashMap<String, CachedResult> result_cache_writes;
+	static WorkerThreadPool::TaskID result_cache_write_task;
+	static bool result_cache_writing;
+	static uint32_t result_cache_writes_since_prune;
+
+	String actions_hash;
+	BinaryMutex result_cache_mutex;
+	LRUCache<String, CachedResult> result_cache{ RESULT_CACHE_CAPACITY };
+
+	/* ASYNC PRECOMPILATION */
+
+	// Code handed to precompile_async() is parsed and generated on worker threads by a
+	// throwaway compiler, using the identifier actions captured on the first compile of each mode.
+	// The result lands in the owner's result cache, so the later synchronous compile is a cache hit.
+	struct PrecompileTask {
+		ShaderCompiler *owner = nullptr;
+		RS::ShaderMode mode = RS::SHADER_MAX;
+		String code;
+		String key;
+		IdentifierActions actions;
+		Callable on_ready;
+	};
+
+	static BinaryMutex mode_compilers_mutex;
+	static ShaderCompiler *mode_compilers[RS::SHADER_MAX];
+
+	IdentifierActions actions_templates[RS::SHADER_MAX];
+	bool has_actions_template[RS::SHADER_MAX] = {};
+	HashMap<String, WorkerThreadPool::TaskID> pending_precompiles;
+
+	void _register_actions_template(RS::ShaderMode p_mode, const IdentifierActions &p_actions);
+	void _collect_finished_precompiles();
+	static void _precompile_task(void *p_userdata);
+	static ShaderLanguage::DataType _get_no_global_shader_uniform_type(const StringName &p_name);
+
+	Error _compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code, ShaderLanguage::GlobalShaderUniformGetTypeFunc p_global_uniform_type_func, bool p_print_errors, CachedResult &r_result, bool &r_cacheable);
+	bool _get_cached_result(const String &p_key, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	void _store_result(const String &p_key, const CachedResult &p_result);
+
+	String _get_cache_key(RS::ShaderMode p_mode, const String &p_code, const IdentifierActions *p_actions) const;
+	static void _apply_render_modes(const Vector<StringName> &p_render_modes, const Vector<StringName> &p_stencil_modes, int p_stencil_reference, IdentifierActions &p_actions);
+	static void _apply_cached_result(const CachedResult &p_result, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+	static bool _load_cached_result(const String &p_key, CachedResult &r_result);
+	static void _save_cached_result(const String &p_key, const CachedResult &p_result);
+	static void _queue_cached_result_write(const String &p_key, const CachedResult &p_result);
+	static void _write_cached_results_task(void *p_userdata);
+	static void _flush_cached_result_writes();
+	static void _prune_result_cache_dir();
+
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
 	void initialize(DefaultIdentifierActions p_actions);
+
+	// Directory where compile results are persisted between runs. Empty disables persistence.
+	static void set_result_cache_dir(const String &p_dir);
+	static const String &get_result_cache_dir();
+
+	// Thread-safe. Parses and generates preprocessed code on a worker thread, calling p_on_ready(bool success) deferred when done.
+	// Only the front end runs ahead of time, the renderer still creates the shader version and compiles its variants when the
+	// code is set on a shader. Does nothing (p_on_ready gets false) until a shader of the same mode was compiled once, which
+	// the renderers do for their default shaders when they initialize.
+	static void precompile_async(const String &p_code, const Callable &p_on_ready = Callable());
 	ShaderCompiler();
+	~ShaderCompiler();
 };
@@ -40,6 +40,7 @@
 #define HAS_WARNING(flag) (warning_flags & flag)
 
 SafeNumeric<int> ShaderLanguage::instance_counter;
+HashMap<StringName, LocalVector<int>> ShaderLanguage::builtin_func_map;
 
 String ShaderLanguage::get_operator_text(Operator p_op) {
 	static const char *op_names[OP_MAX] = { "==",
@@ -729,9 +730,8 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 
 					static bool suffix_lut[CASE_MAX][127];
 
-					if (!is_const_suffix_lut_initialized) {
-						is_const_suffix_lut_initialized = true;
-
+					// Shaders may be parsed on several threads at once, rely on static initialization to fill the table once.
+					static const bool suffix_lut_initialized = []() {
 						for (int i = 0; i < 127; i++) {
 							char t = char(i);
 
@@ -741,7 +741,9 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 							suffix_lut[CASE_SIGN_AFTER_EXPONENT][i] = t == 'f';
 							suffix_lut[CASE_NONE][i] = false;
 						}
-					}
+						return true;
+					}();
+					(void)suffix_lut_initialized;
 
 					String str;
 					int i = 0;
@@ -902,25 +904,23 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 
 				if (is_ascii_identifier_char(GETCHAR(0))) {
 					// parse identifier
-					String str;
+					int from = char_idx;
 
 					while (is_ascii_identifier_char(GETCHAR(0))) {
-						str += char32_t(GETCHAR(0));
 						char_idx++;
 					}
 
-					//see if keyword
-					//should be converted to a static map
-					int idx = 0;
+					String str = code.substr(from, char_idx - from);
 
-					while (keyword_list[idx].text) {
-						if (str == keyword_list[idx].text) {
-							return _make_token(keyword_list[idx].token);
-						}
-						idx++;
+					//see if keyword
+					const TokenType *keyword = _get_keyword_map().getptr(str);
+					if (keyword) {
+						return _make_token(*keyword);
 					}
 
-					str = str.replace("dus_", "_");
+					if (str.contains("dus_")) {
+						str = str.replace("dus_", "_");
+					}
 
 					return _make_token(TK_IDENTIFIER, str);
 				}
@@ -940,6 +940,21 @@ ShaderLanguage::Token ShaderLanguage::_get_token() {
 #undef GETCHAR
 }
 
+const HashMap<String, ShaderLanguage::TokenType> &ShaderLanguage::_get_keyword_map() {
+	// Every identifier is checked against the keywords, so they're indexed once.
+	// Static initialization is thread-safe, shaders may be parsed on several threads.
+	static const HashMap<String, TokenType> keyword_map = []() {
+		HashMap<String, TokenType> map;
+		for (int idx = 0; keyword_list[idx].text; idx++) {
+			if (!map.has(keyword_list[idx].text)) {
+				map.insert(keyword_list[idx].text, keyword_list[idx].token);
+			}
+		}
+		return map;
+	}();
+	return keyword_map;
+}
+
 bool ShaderLanguage::_lookup_next(Token &r_tk) {
 	TkPos pre_pos = _get_tkpos();
 	int line = pre_pos.tk_line;
@@ -3549,7 +3564,6 @@ const ShaderLanguage::BuiltinEntry ShaderLanguage::frag_only_func_defs[] = {
 	{ nullptr }
 };
 
-bool ShaderLanguage::is_const_suffix_lut_initialized = false;
 
 bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionInfo &p_function_info, OperatorNode *p_func, DataType *r_ret_type, StringName *r_ret_type_str, bool *r_is_custom_function) {
 	ERR_FAIL_COND_V(p_func->op != OP_CALL && p_func->op != OP_CONSTRUCT, false);
@@ -3604,207 +3618,201 @@ bool ShaderLanguage::_validate_function_call(BlockNode *p_block, const FunctionI
 	bool unsupported_builtin = false;
 	int builtin_idx = 0;
 
-	if (argcount <= 4) {
+	const LocalVector<int> *builtin_overloads = argcount <= 4 ? builtin_func_map.getptr(name) : nullptr;
+	if (builtin_overloads) {
 		// test builtins
-		int idx = 0;
-
-		while (builtin_func_defs[idx].name) {
+		for (int idx : *builtin_overloads) {
 			if (completion_class != builtin_func_defs[idx].tag) {
-				idx++;
 				continue;
 			}
 
-			if (name == builtin_func_defs[idx].name) {
-				failed_builtin = true;
-				bool fail = false;
-				for (int i = 0; i < argcount; i++) {
-					if (p_func->arguments[i + 1]->type == Node::NODE_TYPE_ARRAY) {
-						const ArrayNode *anode = static_cast<const ArrayNode *>(p_func->arguments[i + 1]);
-						if (anode->call_expression == nullptr && !anode->is_indexed()) {
-							fail = true;
-							break;
-						}
-					}
-					if (get_scalar_type(args[i]) == args[i] && p_func->arguments[i + 1]->type == Node::NODE_TYPE_CONSTANT && convert_constant(static_cast<ConstantNode *>(p_func->arguments[i + 1]), builtin_func_defs[idx].args[i])) {
-						//all good, but needs implicit conversion later
-					} else if (args[i] != builtin_func_defs[idx].args[i]) {
+			failed_builtin = true;
+			bool fail = false;
+			for (int i = 0; i < argcount; i++) {
+				if (p_func->arguments[i + 1]->type == Node::NODE_TYPE_ARRAY) {
+					const ArrayNode *anode = static_cast<const ArrayNode *>(p_func->arguments[i + 1]);
+					if (anode->call_expression == nullptr && !anode->is_indexed()) {
 						fail = true;
 						break;
 					}
 				}
+				if (get_scalar_type(args[i]) == args[i] && p_func->arguments[i + 1]->type == Node::NODE_TYPE_CONSTANT && convert_constant(static_cast<ConstantNode *>(p_func->arguments[i + 1]), builtin_func_defs[idx].args[i])) {
+					//all good, but needs implicit conversion later
+				} else if (args[i] != builtin_func_defs[idx].args[i]) {
+					fail = true;
+					break;
+				}
+			}
 
-				if (!fail) {
-					if (RenderingServer::get_singleton()->is_low_end()) {
-						if (builtin_func_defs[idx].high_end) {
-							fail = true;
-							unsupported_builtin = true;
-							builtin_idx = idx;
-						}
+			if (!fail) {
+				if (RenderingServer::get_singleton()->is_low_end()) {
+					if (builtin_func_defs[idx].high_end) {
+						fail = true;
+						unsupported_builtin = true;
+						builtin_idx = idx;
 					}
 				}
+			}
 
-				if (!fail && argcount < 4 && builtin_func_defs[idx].args[argcount] != TYPE_VOID) {
-					fail = true; //make sure the number of arguments matches
-				}
+			if (!fail && argcount < 4 && builtin_func_defs[idx].args[argcount] != TYPE_VOID) {
+				fail = true; //make sure the number of arguments matches
+			}
 
-				if (!fail) {
-					{
-						int constarg_idx = 0;
-						while (builtin_func_const_args[constarg_idx].name) {
-							if (String(name) == builtin_func_const_args[constarg_idx].name) {
-								int arg = builtin_func_const_args[constarg_idx].arg + 1;
-								if (p_func->arguments.size() <= arg) {
-									break;
-								}
+			if (!fail) {
+				{
+					int constarg_idx = 0;
+					while (builtin_func_const_args[constarg_idx].name) {
+						if (String(name) == builtin_func_const_args[constarg_idx].name) {
+							int arg = builtin_func_const_args[constarg_idx].arg + 1;
+							if (p_func->arguments.size() <= arg) {
+								break;
+							}
 
-								int min = builtin_func_const_args[constarg_idx].min;
-								int max = builtin_func_const_args[constarg_idx].max;
+							int min = builtin_func_const_args[constarg_idx].min;
+							int max = builtin_func_const_args[constarg_idx].max;
 
-								bool error = false;
-								Vector<Scalar> values = _get_node_values(p_block, p_function_info, p_func->arguments[arg]);
-								if (p_func->arguments[arg]->get_datatype() == TYPE_INT && !values.is_empty()) {
-									if (values[0].sint < min || values[0].sint > max) {
-										error = true;
-									}
-								} else {
+							bool error = false;
+							Vector<Scalar> values = _get_node_values(p_block, p_function_info, p_func->arguments[arg]);
+							if (p_func->arguments[arg]->get_datatype() == TYPE_INT && !values.is_empty()) {
+								if (values[0].sint < min || values[0].sint > max) {
 									error = true;
 								}
+							} else {
+								error = true;
+							}
 
-								if (error) {
-									_set_error(vformat(RTR("Expected integer constant within [%d..%d] range."), min, max));
-									return false;
-								}
+							if (error) {
+								_set_error(vformat(RTR("Expected integer constant within [%d..%d] range."), min, max));
+								return false;
 							}
-							constarg_idx++;
 						}
+						constarg_idx++;
 					}
+				}
 
-					//make sure its not an out argument used in the wrong way
-					int outarg_idx = 0;
-					while (builtin_func_out_args[outarg_idx].name) {
-						if (String(name) == builtin_func_out_args[outarg_idx].name) {
-							for (int arg = 0; arg < BuiltinFuncOutArgs::MAX_ARGS; arg++) {
-								int arg_idx = builtin_func_out_args[outarg_idx].arguments[arg];
-								if (arg_idx == -1) {
-									break;
+				//make sure its not an out argument used in the wrong way
+				int outarg_idx = 0;
+				while (builtin_func_out_args[outarg_idx].name) {
+					if (String(name) == builtin_func_out_args[outarg_idx].name) {
+						for (int arg = 0; arg < BuiltinFuncOutArgs::MAX_ARGS; arg++) {
+							int arg_idx = builtin_func_out_args[outarg_idx].arguments[arg];
+							if (arg_idx == -1) {
+								break;
+							}
+							if (arg_idx < argcount) {
+								if (p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_VARIABLE && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_MEMBER && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_ARRAY) {
+									_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
+									return false;
 								}
-								if (arg_idx < argcount) {
-									if (p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_VARIABLE && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_MEMBER && p_func->arguments[arg_idx + 1]->type != Node::NODE_TYPE_ARRAY) {
-										_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
-										return false;
-									}
 
-									if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
-										ArrayNode *mn = static_cast<ArrayNode *>(p_func->arguments[arg_idx + 1]);
-										if (mn->is_const) {
-											fail = true;
-										}
-									} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
-										MemberNode *mn = static_cast<MemberNode *>(p_func->arguments[arg_idx + 1]);
-										if (mn->basetype_const) {
-											fail = true;
-										}
-									} else { // TYPE_VARIABLE
-										VariableNode *vn = static_cast<VariableNode *>(p_func->arguments[arg_idx + 1]);
-										if (vn->is_const) {
+								if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
+									ArrayNode *mn = static_cast<ArrayNode *>(p_func->arguments[arg_idx + 1]);
+									if (mn->is_const) {
+										fail = true;
+									}
+								} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
+									MemberNode *mn = static_cast<MemberNode *>(p_func->arguments[arg_idx + 1]);
+									if (mn->basetype_const) {
+										fail = true;
+									}
+								} else { // TYPE_VARIABLE
+									VariableNode *vn = static_cast<VariableNode *>(p_func->arguments[arg_idx + 1]);
+									if (vn->is_const) {
+										fail = true;
+									} else {
+										StringName varname = vn->name;
+										if (shader->uniforms.has(varname)) {
 											fail = true;
 										} else {
-											StringName varname = vn->name;
-											if (shader->uniforms.has(varname)) {
-												fail = true;
-											} else {
-												if (shader->varyings.has(varname)) {
-													_set_error(vformat(RTR("Varyings cannot be passed for the '%s' parameter."), "out"));
-													return false;
-												}
-												if (p_function_info.built_ins.has(varname)) {
-													BuiltInInfo info = p_function_info.built_ins[varname];
-													if (info.constant) {
-														fail = true;
-													}
+											if (shader->varyings.has(varname)) {
+												_set_error(vformat(RTR("Varyings cannot be passed for the '%s' parameter."), "out"));
+												return false;
+											}
+											if (p_function_info.built_ins.has(varname)) {
+												BuiltInInfo info = p_function_info.built_ins[varname];
+												if (info.constant) {
+													fail = true;
 												}
 											}
 										}
 									}
-									if (fail) {
-										_set_error(vformat(RTR("A constant value cannot be passed for the '%s' parameter."), "out"));
+								}
+								if (fail) {
+									_set_error(vformat(RTR("A constant value cannot be passed for the '%s' parameter."), "out"));
+									return false;
+								}
+
+								StringName var_name;
+								if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
+									var_name = static_cast<const ArrayNode *>(p_func->arguments[arg_idx + 1])->name;
+								} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
+									Node *n = static_cast<const MemberNode *>(p_func->arguments[arg_idx + 1])->owner;
+									while (n->type == Node::NODE_TYPE_MEMBER) {
+										n = static_cast<const MemberNode *>(n)->owner;
+									}
+									if (n->type != Node::NODE_TYPE_VARIABLE && n->type != Node::NODE_TYPE_ARRAY) {
+										_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
 										return false;
 									}
-
-									StringName var_name;
-									if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_ARRAY) {
-										var_name = static_cast<const ArrayNode *>(p_func->arguments[arg_idx + 1])->name;
-									} else if (p_func->arguments[arg_idx + 1]->type == Node::NODE_TYPE_MEMBER) {
-										Node *n = static_cast<const MemberNode *>(p_func->arguments[arg_idx + 1])->owner;
-										while (n->type == Node::NODE_TYPE_MEMBER) {
-											n = static_cast<const MemberNode *>(n)->owner;
-										}
-										if (n->type != Node::NODE_TYPE_VARIABLE && n->type != Node::NODE_TYPE_ARRAY) {
-											_set_error(vformat(RTR("Argument %d of function '%s' is not a variable, array, or member."), arg_idx + 1, String(name)));
-											return false;
-										}
-										if (n->type == Node::NODE_TYPE_VARIABLE) {
-											var_name = static_cast<const VariableNode *>(n)->name;
-										} else { // TYPE_ARRAY
-											var_name = static_cast<const ArrayNode *>(n)->name;
-										}
-									} else { // TYPE_VARIABLE
-										var_name = static_cast<const VariableNode *>(p_func->arguments[arg_idx + 1])->name;
+									if (n->type == Node::NODE_TYPE_VARIABLE) {
+										var_name = static_cast<const VariableNode *>(n)->name;
+									} else { // TYPE_ARRAY
+										var_name = static_cast<const ArrayNode *>(n)->name;
 									}
-									const BlockNode *b = p_block;
-									bool valid = false;
-									while (b) {
-										if (b->variables.has(var_name) || p_function_info.built_ins.has(var_name)) {
-											valid = true;
-											break;
-										}
-										if (b->parent_function) {
-											for (int i = 0; i < b->parent_function->arguments.size(); i++) {
-												if (b->parent_function->arguments[i].name == var_name) {
-													valid = true;
-													break;
-												}
+								} else { // TYPE_VARIABLE
+									var_name = static_cast<const VariableNode *>(p_func->arguments[arg_idx + 1])->name;
+								}
+								const BlockNode *b = p_block;
+								bool valid = false;
+								while (b) {
+									if (b->variables.has(var_name) || p_function_info.built_ins.has(var_name)) {
+										valid = true;
+										break;
+									}
+									if (b->parent_function) {
+										for (int i = 0; i < b->parent_function->arguments.size(); i++) {
+											if (b->parent_function->arguments[i].name == var_name) {
+												valid = true;
+												break;
 											}
 										}
-										b = b->parent_block;
 									}
+									b = b->parent_block;
+								}
 
-									if (!valid) {
-										_set_error(vformat(RTR("Argument %d of function '%s' can only take a local variable, array, or member."), arg_idx + 1, String(name)));
-										return false;
-									}
+								if (!valid) {
+									_set_error(vformat(RTR("Argument %d of function '%s' can only take a local variable, array, or member."), arg_idx + 1, String(name)));
+									return false;
 								}
 							}
 						}
-						outarg_idx++;
 					}
-					//implicitly convert values if possible
-					for (int i = 0; i < argcount; i++) {
-						if (get_scalar_type(args[i]) != args[i] || args[i] == builtin_func_defs[idx].args[i] || p_func->arguments[i + 1]->type != Node::NODE_TYPE_CONSTANT) {
-							//can't do implicit conversion here
-							continue;
-						}
-
-						//this is an implicit conversion
-						ConstantNode *constant = static_cast<ConstantNode *>(p_func->arguments[i + 1]);
-						ConstantNode *conversion = alloc_node<ConstantNode>();
+					outarg_idx++;
+				}
+				//implicitly convert values if possible
+				for (int i = 0; i < argcount; i++) {
+					if (get_scalar_type(args[i]) != args[i] || args[i] == builtin_func_defs[idx].args[i] || p_func->arguments[i + 1]->type != Node::NODE_TYPE_CONSTANT) {
+						//can't do implicit conversion here
+						continue;
+					}
 
-						conversion->datatype = builtin_func_defs[idx].args[i];
-						conversion->values.resize(1);
+					//this is an implicit conversion
+					ConstantNode *constant = static_cast<ConstantNode *>(p_func->arguments[i + 1]);
+					ConstantNode *conversion = alloc_node<ConstantNode>();
 
-						convert_constant(constant, builtin_func_defs[idx].args[i], conversion->values.ptrw());
-						p_func->arguments.write[i + 1] = conversion;
-					}
+					conversion->datatype = builtin_func_defs[idx].args[i];
+					conversion->values.resize(1);
 
-					if (r_ret_type) {
-						*r_ret_type = builtin_func_defs[idx].rettype;
-					}
+					convert_constant(constant, builtin_func_defs[idx].args[i], conversion->values.ptrw());
+					p_func->arguments.write[i + 1] = conversion;
+				}
 
-					return true;
+				if (r_ret_type) {
+					*r_ret_type = builtin_func_defs[idx].rettype;
 				}
-			}
 
-			idx++;
+				return true;
+			}
 		}
 	}
 
@@ -6490,15 +6498,16 @@ ShaderLanguage::Node *ShaderLanguage::_parse_expression(BlockNode *p_block, cons
 				bool is_local = false;
 
 				if (p_block && p_block->block_tag != SubClassTag::TAG_GLOBAL) {
-					int idx = 0;
 					bool found = false;
 
-					while (builtin_func_defs[idx].name) {
-						if (builtin_func_defs[idx].tag == p_block->block_tag && builtin_func_defs[idx].name == identifier) {
-							found = true;
-							break;
+					const LocalVector<int> *builtin_overloads = builtin_func_map.getptr(identifier);
+					if (builtin_overloads) {
+						for (int idx : *builtin_overloads) {
+							if (builtin_func_defs[idx].tag == p_block->block_tag) {
+								found = true;
+								break;
+							}
 						}
-						idx++;
 					}
 					if (!found) {
 						_set_error(vformat(RTR("Unknown identifier in expression: '%s'."), String(identifier)));
@@ -12062,6 +12071,7 @@ ShaderLanguage::ShaderLanguage() {
 			if (builtin_func_defs[idx].tag == SubClassTag::TAG_GLOBAL) {
 				global_func_set.insert(builtin_func_defs[idx].name);
 			}
+			builtin_func_map[StringName(builtin_func_defs[idx].name)].push_back(idx);
 			idx++;
 		}
 	}
@@ -12083,5 +12093,6 @@ ShaderLanguage::~ShaderLanguage() {
 	instance_counter.decrement();
 	if (instance_counter.get() == 0) {
 		global_func_set.clear();
+		builtin_func_map.clear();
 	}
 }
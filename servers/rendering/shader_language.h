@@ -976,6 +976,7 @@ private:
 	};
 
 	static const KeyWord keyword_list[];
+	static const HashMap<String, TokenType> &_get_keyword_map();
 
 	GlobalShaderUniformGetTypeFunc global_shader_uniform_get_type_func = nullptr;
 
@@ -1196,8 +1197,9 @@ private:
 	static const BuiltinFuncOutArgs builtin_func_out_args[];
 	static const BuiltinFuncConstArgs builtin_func_const_args[];
 	static const BuiltinEntry frag_only_func_defs[];
-
-	static bool is_const_suffix_lut_initialized;
+	// Maps a built-in function name to the indices of its overloads in builtin_func_defs, in declaration order.
+	// Built by the first instance and cleared with the last one, like global_func_set.
+	static HashMap<StringName, LocalVector<int>> builtin_func_map;
 
 	Error _validate_precision(DataType p_type, DataPrecision p_precision);
 	bool _compare_datatypes(DataType p_datatype_a, String p_datatype_name_a, int p_array_size_a, DataType p_datatype_b, String p_datatype_name_b, int p_array_size_b);
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/math/a_star.h"
+#include "core/math/a_star_grid_2d.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -212,6 +214,147 @@ TEST_CASE("[AStar3D] Add/Remove") {
 	// It's been great work, cheers. \(^ ^)/
 }
 
+TEST_CASE("[AStar3D] Frozen graph") {
+	ABCX abcx;
+	Vector<int64_t> path = abcx.get_id_path(ABCX::X, ABCX::C);
+	abcx.freeze();
+	CHECK(abcx.is_frozen());
+	CHECK(abcx.get_point_count() == 4);
+	CHECK(abcx.are_points_connected(ABCX::A, ABCX::X));
+	CHECK_FALSE(abcx.are_points_connected(ABCX::X, ABCX::B));
+	CHECK(abcx.get_id_path(ABCX::X, ABCX::C) == path);
+
+	// The topology can't change while frozen.
+	ERR_PRINT_OFF;
+	abcx.connect_points(ABCX::X, ABCX::C);
+	ERR_PRINT_ON;
+	CHECK_FALSE(abcx.are_points_connected(ABCX::X, ABCX::C));
+
+	abcx.set_point_disabled(ABCX::B);
+	CHECK(abcx.get_id_path(ABCX::X, ABCX::C).size() == 3);
+	abcx.set_point_disabled(ABCX::B, false);
+
+	abcx.unfreeze();
+	CHECK_FALSE(abcx.is_frozen());
+	CHECK(abcx.are_points_connected(ABCX::A, ABCX::X));
+	CHECK(abcx.are_points_connected(ABCX::B, ABCX::C));
+	CHECK(abcx.get_id_path(ABCX::X, ABCX::C) == path);
+
+	// A random graph with one way connections should give the same paths frozen.
+	AStar3D a;
+	Math::seed(0);
+	for (int i = 0; i < 200; i++) {
+		a.add_point(i, Vector3(Math::rand() % 100, Math::rand() % 100, Math::rand() % 100));
+	}
+	for (int i = 0; i < 600; i++) {
+		const int u = Math::rand() % 200;
+		const int v = Math::rand() % 200;
+		if (u != v) {
+			a.connect_points(u, v, i % 2);
+		}
+	}
+	Vector<Vector<int64_t>> paths;
+	for (int i = 0; i < 50; i++) {
+		paths.push_back(a.get_id_path(i, 199 - i, i % 3 == 0));
+	}
+	a.freeze();
+	for (int i = 0; i < 50; i++) {
+		CHECK(a.get_id_path(i, 199 - i, i % 3 == 0) == paths[i]);
+	}
+}
+
+TEST_CASE("[AStarGrid2D] Batch id paths") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(0, 0, 32, 32));
+	grid->update();
+	grid->fill_solid_region(Rect2i(8, 0, 1, 30));
+	grid->fill_solid_region(Rect2i(20, 2, 1, 30));
+
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	for (int i = 0; i < 16; i++) {
+		from_ids.push_back(Vector2i(i % 8, i * 2));
+		to_ids.push_back(Vector2i(31 - i, 31 - i * 2));
+	}
+	from_ids.push_back(Vector2i(4, 4));
+	to_ids.push_back(Vector2i(4, 4));
+
+	TypedArray<Array> paths = grid->get_id_paths(from_ids, to_ids);
+	REQUIRE(paths.size() == from_ids.size());
+	for (int i = 0; i < from_ids.size(); i++) {
+		const TypedArray<Vector2i> path = paths[i];
+		CHECK(path == grid->get_id_path(from_ids[i], to_ids[i]));
+		CHECK(path.size() > 0);
+	}
+
+	ERR_PRINT_OFF;
+	to_ids.remove_at(0);
+	CHECK(grid->get_id_paths(from_ids, to_ids).is_empty());
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[AStarGrid2D] Flow field") {
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(0, 0, 24, 24));
+	grid->update();
+	grid->fill_solid_region(Rect2i(6, 0, 1, 20));
+	grid->fill_solid_region(Rect2i(14, 4, 1, 20));
+	grid->set_point_weight_scale(Vector2i(10, 10), 4.0);
+
+	TypedArray<Vector2i> goals = { Vector2i(22, 2) };
+	grid->update_flow_field(goals);
+	CHECK(grid->get_flow_distance(Vector2i(22, 2)) == 0);
+	CHECK(grid->get_flow_direction(Vector2i(22, 2)) == Vector2i());
+	CHECK(Math::is_inf(grid->get_flow_distance(Vector2i(6, 6))));
+
+	// Following the flow directions reaches the goal as fast as a path search.
+	for (const Vector2i &start : { Vector2i(0, 0), Vector2i(3, 12), Vector2i(10, 23), Vector2i(20, 20) }) {
+		const TypedArray<Vector2i> path = grid->get_id_path(start, Vector2i(22, 2));
+		real_t path_cost = 0;
+		for (int i = 1; i < path.size(); i++) {
+			const Vector2i from = path[i - 1];
+			const Vector2i to = path[i];
+			path_cost += Vector2(from).distance_to(Vector2(to)) * grid->get_point_weight_scale(to);
+		}
+		CHECK(grid->get_flow_distance(start) == doctest::Approx(path_cost));
+
+		Vector2i cell = start;
+		for (int i = 0; i < 24 * 24 && cell != Vector2i(22, 2); i++) {
+			cell += grid->get_flow_direction(cell);
+		}
+		CHECK(cell == Vector2i(22, 2));
+	}
+
+	// Updating after changes repairs the field to the same result as computing it from scratch.
+	grid->set_point_solid(Vector2i(6, 21));
+	grid->fill_solid_region(Rect2i(6, 20, 1, 4));
+	grid->fill_solid_region(Rect2i(15, 10, 4, 1));
+	grid->set_point_solid(Vector2i(14, 10), false);
+	grid->update_flow_field(goals);
+	LocalVector<real_t> repaired_distances;
+	for (int y = 0; y < 24; y++) {
+		for (int x = 0; x < 24; x++) {
+			repaired_distances.push_back(grid->get_flow_distance(Vector2i(x, y)));
+		}
+	}
+	grid->clear_flow_field();
+	grid->update_flow_field(goals);
+	bool match = true;
+	for (int y = 0; y < 24; y++) {
+		for (int x = 0; x < 24; x++) {
+			const real_t distance = grid->get_flow_distance(Vector2i(x, y));
+			const real_t repaired_distance = repaired_distances[y * 24 + x];
+			if (Math::is_inf(distance) ? !Math::is_inf(repaired_distance) : !Math::is_equal_approx(distance, repaired_distance)) {
+				match = false;
+			}
+		}
+	}
+	CHECK_MESSAGE(match, "Repaired flow field matches a full update.");
+	CHECK(Math::is_inf(grid->get_flow_distance(Vector2i(0, 0))));
+}
+
 TEST_CASE("[Stress][AStar3D] Find paths") {
 	// Random stress tests with Floyd-Warshall.
 	constexpr int N = 30;
@@ -356,4 +499,156 @@ TEST_CASE("[Stress][AStar3D] Find paths") {
 		CHECK_MESSAGE(match, "Found all paths.");
 	}
 }
+
+TEST_CASE("[Stress][AStar3D] Find paths on a frozen graph") {
+	// A 100x100 grid with random weights, searched between random points before and after freezing.
+	constexpr int SIZE = 100;
+	constexpr int QUERIES = 500;
+	Math::seed(0);
+
+	AStar3D a;
+	for (int y = 0; y < SIZE; y++) {
+		for (int x = 0; x < SIZE; x++) {
+			a.add_point(y * SIZE + x, Vector3(x, y, 0), 1 + Math::rand() % 4);
+			if (x > 0) {
+				a.connect_points(y * SIZE + x, y * SIZE + x - 1);
+			}
+			if (y > 0) {
+				a.connect_points(y * SIZE + x, (y - 1) * SIZE + x);
+			}
+		}
+	}
+	int64_t from[QUERIES];
+	int64_t to[QUERIES];
+	for (int i = 0; i < QUERIES; i++) {
+		from[i] = Math::rand() % (SIZE * SIZE);
+		to[i] = Math::rand() % (SIZE * SIZE);
+	}
+
+	Vector<Vector<int64_t>> paths;
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < QUERIES; i++) {
+		paths.push_back(a.get_id_path(from[i], to[i]));
+	}
+	const uint64_t unfrozen_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	a.freeze();
+	bool match = true;
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < QUERIES; i++) {
+		match = match && a.get_id_path(from[i], to[i]) == paths[i];
+	}
+	const uint64_t frozen_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	print_verbose(vformat("%d paths on %d points: %d usec unfrozen, %d usec frozen.", QUERIES, SIZE * SIZE, unfrozen_usec, frozen_usec));
+	CHECK_MESSAGE(match, "Frozen graph found the same paths.");
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Batch id paths") {
+	// A 256x256 grid with random solid points, searched between random points one by one and as one batch.
+	constexpr int SIZE = 256;
+	constexpr int QUERIES = 256;
+	Math::seed(0);
+
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(0, 0, SIZE, SIZE));
+	grid->update();
+	for (int i = 0; i < SIZE * SIZE / 5; i++) {
+		grid->set_point_solid(Vector2i(Math::rand() % SIZE, Math::rand() % SIZE));
+	}
+	TypedArray<Vector2i> from_ids;
+	TypedArray<Vector2i> to_ids;
+	for (int i = 0; i < QUERIES; i++) {
+		const Vector2i from = Vector2i(Math::rand() % SIZE, Math::rand() % SIZE);
+		const Vector2i to = Vector2i(Math::rand() % SIZE, Math::rand() % SIZE);
+		grid->set_point_solid(from, false);
+		grid->set_point_solid(to, false);
+		from_ids.push_back(from);
+		to_ids.push_back(to);
+	}
+
+	Vector<TypedArray<Vector2i>> paths;
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < QUERIES; i++) {
+		paths.push_back(grid->get_id_path(from_ids[i], to_ids[i], true));
+	}
+	const uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	const TypedArray<Array> batch_paths = grid->get_id_paths(from_ids, to_ids, true);
+	const uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	print_verbose(vformat("%d paths on a %dx%d grid: %d usec one by one, %d usec as a batch.", QUERIES, SIZE, SIZE, single_usec, batch_usec));
+	REQUIRE(batch_paths.size() == QUERIES);
+	bool match = true;
+	for (int i = 0; i < QUERIES; i++) {
+		match = match && TypedArray<Vector2i>(batch_paths[i]) == paths[i];
+	}
+	CHECK_MESSAGE(match, "Batch found the same paths.");
+}
+
+TEST_CASE("[Stress][AStarGrid2D] Flow field") {
+	// Agents on a 256x256 grid with random solid points heading to one goal, with path searches and with a flow field.
+	constexpr int SIZE = 256;
+	constexpr int AGENTS = 256;
+	const Vector2i goal = Vector2i(SIZE / 2, SIZE / 2);
+	Math::seed(0);
+
+	Ref<AStarGrid2D> grid;
+	grid.instantiate();
+	grid->set_region(Rect2i(0, 0, SIZE, SIZE));
+	grid->update();
+	for (int i = 0; i < SIZE * SIZE / 5; i++) {
+		grid->set_point_solid(Vector2i(Math::rand() % SIZE, Math::rand() % SIZE));
+	}
+	grid->set_point_solid(goal, false);
+	Vector<Vector2i> agents;
+	for (int i = 0; i < AGENTS; i++) {
+		const Vector2i agent = Vector2i(Math::rand() % SIZE, Math::rand() % SIZE);
+		grid->set_point_solid(agent, false);
+		agents.push_back(agent);
+	}
+
+	uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (const Vector2i &agent : agents) {
+		grid->get_id_path(agent, goal);
+	}
+	const uint64_t path_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	const TypedArray<Vector2i> goals = { goal };
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	grid->update_flow_field(goals);
+	const uint64_t full_update_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	// A few local changes next to the goal.
+	for (int i = 0; i < 8; i++) {
+		grid->set_point_solid(goal + Vector2i(i - 4, 3));
+	}
+	start_usec = OS::get_singleton()->get_ticks_usec();
+	grid->update_flow_field(goals);
+	const uint64_t repair_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	LocalVector<real_t> repaired_distances;
+	for (int y = 0; y < SIZE; y++) {
+		for (int x = 0; x < SIZE; x++) {
+			repaired_distances.push_back(grid->get_flow_distance(Vector2i(x, y)));
+		}
+	}
+	grid->clear_flow_field();
+	grid->update_flow_field(goals);
+	bool match = true;
+	for (int y = 0; y < SIZE; y++) {
+		for (int x = 0; x < SIZE; x++) {
+			const real_t distance = grid->get_flow_distance(Vector2i(x, y));
+			const real_t repaired_distance = repaired_distances[y * SIZE + x];
+			if (Math::is_inf(distance) ? !Math::is_inf(repaired_distance) : !Math::is_equal_approx(distance, repaired_distance)) {
+				match = false;
+			}
+		}
+	}
+
+	print_verbose(vformat("%d agents on a %dx%d grid: %d usec of path searches, %d usec for a full flow field update, %d usec to repair it.", AGENTS, SIZE, SIZE, path_usec, full_update_usec, repair_usec));
+	CHECK_MESSAGE(match, "Repaired flow field matches a full update.");
+}
 } // namespace TestAStar
@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  test_shader_language.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "servers/rendering/shader_language.h"
+#include "servers/rendering/shader_types.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderLanguage {
+
+TEST_CASE("[SceneTree][Stress][ShaderLanguage] Compile a large shader") {
+	// A spatial shader with 200 functions that call a handful of built-in functions each.
+	String code = "shader_type spatial;\n\nuniform vec4 tint : source_color;\n\n";
+	for (int i = 0; i < 200; i++) {
+		code += vformat("float function_%d(vec3 p_position) {\n\treturn sin(p_position.x * %d.0) + dot(normalize(p_position), vec3(0.5)) + clamp(p_position.y, 0.0, 1.0) * mix(0.25, 0.75, fract(p_position.z));\n}\n\n", i, i + 1);
+	}
+	code += "void fragment() {\n\tfloat value = 0.0;\n";
+	for (int i = 0; i < 200; i++) {
+		code += vformat("\tvalue += function_%d(VERTEX);\n", i);
+	}
+	code += "\tALBEDO = mix(tint.rgb, vec3(value), 0.5);\n}\n";
+
+	ShaderLanguage::ShaderCompileInfo info;
+	info.functions = ShaderTypes::get_singleton()->get_functions(RS::SHADER_SPATIAL);
+	info.render_modes = ShaderTypes::get_singleton()->get_modes(RS::SHADER_SPATIAL);
+	info.stencil_modes = ShaderTypes::get_singleton()->get_stencil_modes(RS::SHADER_SPATIAL);
+	info.shader_types = ShaderTypes::get_singleton()->get_types();
+
+	bool compiled = true;
+	const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 20; i++) {
+		ShaderLanguage shader_language;
+		compiled = compiled && shader_language.compile(code, info) == OK;
+	}
+	const uint64_t compile_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+	print_verbose(vformat("20 compilations of a shader of %d characters: %d usec.", code.length(), compile_usec));
+	CHECK_MESSAGE(compiled, "Shader compiled.");
+}
+
+} // namespace TestShaderLanguage
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/os/os.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -50,6 +51,41 @@ public:
 	Variant function1_latest_arg0;
 };
 
+class SourceGeometryParserMock : public Object {
+	GDCLASS(SourceGeometryParserMock, Object);
+
+public:
+	void parse(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_node) {
+		parsed_vertices = p_source_geometry_data->get_vertices();
+	}
+
+	Vector<float> parsed_vertices;
+};
+
+// A flat navigation mesh of p_size by p_size squares of one unit, with about a fifth of the squares left out at random.
+static Ref<NavigationMesh> create_grid_navigation_mesh(int p_size, Vector<bool> &r_cells) {
+	Ref<NavigationMesh> navigation_mesh;
+	navigation_mesh.instantiate();
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	r_cells.resize(p_size * p_size);
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			r_cells.write[z * p_size + x] = Math::rand() % 5 != 0;
+			if (r_cells[z * p_size + x]) {
+				const int index = z * (p_size + 1) + x;
+				navigation_mesh->add_polygon({ index, index + 1, index + p_size + 2, index + p_size + 1 });
+			}
+		}
+	}
+	return navigation_mesh;
+}
+
 TEST_SUITE("[Navigation3D]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -416,6 +452,56 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->free(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should make 3D avoidance agents avoid each other when other agents are far away") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		RID agent_1 = navigation_server->agent_create();
+		RID agent_2 = navigation_server->agent_create();
+		RID agent_far = navigation_server->agent_create();
+
+		navigation_server->map_set_active(map, true);
+
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_use_3d_avoidance(agent_1, true);
+		navigation_server->agent_set_position(agent_1, Vector3(0, 0, 0));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_velocity(agent_1, Vector3(1, 0, 0));
+		CallableMock agent_1_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_1, callable_mp(&agent_1_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_use_3d_avoidance(agent_2, true);
+		navigation_server->agent_set_position(agent_2, Vector3(2.5, 0, 0.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_velocity(agent_2, Vector3(-1, 0, 0));
+		CallableMock agent_2_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_2, callable_mp(&agent_2_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->agent_set_map(agent_far, map);
+		navigation_server->agent_set_avoidance_enabled(agent_far, true);
+		navigation_server->agent_set_use_3d_avoidance(agent_far, true);
+		navigation_server->agent_set_position(agent_far, Vector3(1000, 500, -1000));
+		navigation_server->agent_set_radius(agent_far, 1);
+
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(agent_1_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_2_avoidance_callback_mock.function1_calls, 1);
+		Vector3 agent_1_safe_velocity = agent_1_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_2_safe_velocity = agent_2_avoidance_callback_mock.function1_latest_arg0;
+		CHECK_MESSAGE(agent_1_safe_velocity.x > 0, "agent 1 should move a bit along desired velocity (+X)");
+		CHECK_MESSAGE(agent_2_safe_velocity.x < 0, "agent 2 should move a bit along desired velocity (-X)");
+		CHECK_FALSE_MESSAGE(agent_1_safe_velocity.is_equal_approx(Vector3(1, 0, 0)), "agent 1 should deviate from desired velocity to avoid agent 2");
+		CHECK_FALSE_MESSAGE(agent_2_safe_velocity.is_equal_approx(Vector3(-1, 0, 0)), "agent 2 should deviate from desired velocity to avoid agent 1");
+
+		navigation_server->free(agent_far);
+		navigation_server->free(agent_2);
+		navigation_server->free(agent_1);
+		navigation_server->free(map);
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -596,6 +682,17 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(source_geometry->get_indices().size(), 6);
 		}
 
+		SUBCASE("Parser callbacks should read the geometry parsed before them") {
+			SourceGeometryParserMock parser_mock;
+			RID parser = navigation_server->source_geometry_parser_create();
+			navigation_server->source_geometry_parser_set_callback(parser, callable_mp(&parser_mock, &SourceGeometryParserMock::parse));
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, mesh_instance);
+			navigation_server->free(parser);
+
+			// The mesh instance parser runs first, so the callback sees the finished plane vertices.
+			CHECK_EQ(parser_mock.parsed_vertices, source_geometry->get_vertices());
+		}
+
 		SUBCASE("Parsed geometry should be extendable with other geometry") {
 			source_geometry->merge(source_geometry); // Merging with itself.
 			const Vector<float> vertices = source_geometry->get_vertices();
@@ -658,6 +755,73 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_NE(navigation_server->map_get_closest_point(map, Vector3(0, 0, 0)), Vector3(0, 0, 0));
 		}
 
+		SUBCASE("Baking in tiles should cover the same area and reuse unchanged tiles") {
+			Ref<NavigationMesh> tiled_navigation_mesh = memnew(NavigationMesh);
+			tiled_navigation_mesh->set_tile_size(4.0);
+			navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+			CHECK_GT(tiled_navigation_mesh->get_polygon_count(), 2);
+
+			AABB bounds;
+			for (const Vector3 &vertex : navigation_mesh->get_vertices()) {
+				bounds.expand_to(vertex);
+			}
+			AABB tiled_bounds;
+			for (const Vector3 &vertex : tiled_navigation_mesh->get_vertices()) {
+				tiled_bounds.expand_to(vertex);
+			}
+			CHECK(bounds.position.distance_to(tiled_bounds.position) < navigation_mesh->get_cell_size());
+			CHECK(bounds.get_end().distance_to(tiled_bounds.get_end()) < navigation_mesh->get_cell_size());
+
+			// The path crosses the tile seams at x = 0 and z = 0.
+			navigation_server->region_set_navigation_mesh(region, tiled_navigation_mesh);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-3.5, 0, -3.5), Vector3(3.5, 0, 3.5), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].distance_to(Vector3(3.5, 0, 3.5)) < 0.1);
+
+			const Vector<Vector3> tiled_vertices = tiled_navigation_mesh->get_vertices();
+			const int tiled_polygon_count = tiled_navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(tiled_navigation_mesh->get_vertices(), tiled_vertices);
+			CHECK_EQ(tiled_navigation_mesh->get_polygon_count(), tiled_polygon_count);
+
+			// The polygons that are away from the tile from (0, 0) to (4, 4) and its seams.
+			const auto get_untouched_polygons = [&]() {
+				const Vector<Vector3> vertices = tiled_navigation_mesh->get_vertices();
+				Vector<Vector<Vector3>> polygons;
+				for (int i = 0; i < tiled_navigation_mesh->get_polygon_count(); i++) {
+					Vector<Vector3> polygon;
+					bool untouched_x = true;
+					bool untouched_z = true;
+					for (int index : tiled_navigation_mesh->get_polygon(i)) {
+						polygon.push_back(vertices[index]);
+						untouched_x = untouched_x && vertices[index].x < -1.0;
+						untouched_z = untouched_z && vertices[index].z < -1.0;
+					}
+					if (untouched_x || untouched_z) {
+						polygons.push_back(polygon);
+					}
+				}
+				return polygons;
+			};
+			const Vector<Vector<Vector3>> untouched_polygons = get_untouched_polygons();
+			REQUIRE_NE(untouched_polygons.size(), 0);
+
+			// An obstruction in the middle of the tile from (0, 0) to (4, 4) only changes that tile.
+			Vector<Vector3> obstruction_vertices = { Vector3(1.75, 0, 1.75), Vector3(2.25, 0, 1.75), Vector3(2.25, 0, 2.25), Vector3(1.75, 0, 2.25) };
+			source_geometry->add_projected_obstruction(obstruction_vertices, -1.0, 2.0, false);
+			navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+			CHECK_NE(tiled_navigation_mesh->get_vertices(), tiled_vertices);
+			CHECK_EQ(get_untouched_polygons(), untouched_polygons);
+		}
+
+		SUBCASE("Parsed source geometry should match the mesh added directly") {
+			Ref<NavigationMeshSourceGeometryData3D> direct_source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			direct_source_geometry->add_mesh(plane_mesh, mesh_instance->get_global_transform());
+			CHECK_EQ(source_geometry->get_vertices(), direct_source_geometry->get_vertices());
+			CHECK_EQ(source_geometry->get_indices(), direct_source_geometry->get_indices());
+		}
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
@@ -702,6 +866,62 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 2, 1), Vector3(1, 1, 1), true), Vector3());
 		}
 
+		SUBCASE("Hierarchical pathfinding should yield a path to the same end position") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-4, 0, -4), Vector3(10, 0, 10), true);
+			navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+			navigation_server->map_set_hierarchical_cluster_size(map, 2.0);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+			CHECK_EQ(navigation_server->map_get_hierarchical_cluster_size(map), doctest::Approx(2.0));
+
+			const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(map, Vector3(-4, 0, -4), Vector3(10, 0, 10), true);
+			CHECK_NE(hierarchical_path.size(), 0);
+			CHECK_EQ(hierarchical_path[0], path[0]);
+			CHECK_EQ(hierarchical_path[hierarchical_path.size() - 1], path[path.size() - 1]);
+		}
+
+		SUBCASE("Map synchronization should only rebuild the connections of the changed regions") {
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_REGION_REBUILD_COUNT), 1);
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), true);
+
+			RID other_region = navigation_server->region_create();
+			navigation_server->region_set_use_async_iterations(other_region, false);
+			navigation_server->region_set_transform(other_region, Transform3D(Basis(), Vector3(100, 0, 0)));
+			navigation_server->region_set_map(other_region, map);
+			navigation_server->region_set_navigation_mesh(other_region, navigation_mesh);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_REGION_COUNT), 2);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_REGION_REBUILD_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_EDGE_MERGE_COUNT), 0);
+			CHECK_EQ(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), true), path);
+
+			navigation_server->free(other_region);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_REGION_COUNT), 1);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_SYNC_REGION_REBUILD_COUNT), 0);
+			CHECK_EQ(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), true), path);
+		}
+
+		SUBCASE("Batch query should yield one path per position pair") {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			PackedVector3Array start_positions = { Vector3(0, 0, 0), Vector3(-4, 0, -4), Vector3(2, 0, 2) };
+			PackedVector3Array target_positions = { Vector3(10, 0, 10), Vector3(4, 0, 4), Vector3(2, 0, 2) };
+			Dictionary result = navigation_server->query_paths(query_parameters, start_positions, target_positions);
+
+			PackedInt32Array path_offsets = result["path_offsets"];
+			PackedFloat32Array path_lengths = result["path_lengths"];
+			PackedVector3Array path_points = result["path_points"];
+			CHECK_EQ(path_offsets.size(), 4);
+			CHECK_EQ(path_lengths.size(), 3);
+			CHECK_EQ(path_offsets[3], path_points.size());
+
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-4, 0, -4), Vector3(4, 0, 4), true);
+			CHECK_EQ(path_offsets[2] - path_offsets[1], path.size());
+			CHECK_EQ(path_points[path_offsets[2] - 1], path[path.size() - 1]);
+			CHECK_GT(path_lengths[1], 0);
+		}
+
 		SUBCASE("Elaborate query with 'CORRIDORFUNNEL' post-processing should yield non-empty result") {
 			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
 			query_parameters->set_map(map);
@@ -803,6 +1023,93 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Hierarchical pathfinding should find the same paths as a search on the whole map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A U-shaped route. With a cluster size of 4 the start and target polygons share the edge between the clusters at
+		// z < 4, but the polygon route detours through the cluster at z > 8 that is not part of their corridor.
+		const real_t polygon_bounds[][4] = {
+			{ 0, 0, 1, 1 }, // Start.
+			{ 0, 1, 1, 9 },
+			{ 0, 9, 1, 10 },
+			{ 1, 9, 2, 10 },
+			{ 2, 9, 3, 10 },
+			{ 2, 1, 3, 9 },
+			{ 2, 0, 3, 1 },
+			{ 3, 0, 6, 1 }, // Target.
+		};
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		for (const real_t *bounds : polygon_bounds) {
+			Vector<int> polygon;
+			for (const Vector3 &vertex : { Vector3(bounds[0], 0, bounds[1]), Vector3(bounds[2], 0, bounds[1]), Vector3(bounds[2], 0, bounds[3]), Vector3(bounds[0], 0, bounds[3]) }) {
+				int index = vertices.find(vertex);
+				if (index == -1) {
+					index = vertices.size();
+					vertices.push_back(vertex);
+				}
+				polygon.push_back(index);
+			}
+			navigation_mesh->add_polygon(polygon);
+		}
+		navigation_mesh->set_vertices(vertices);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->map_set_hierarchical_cluster_size(map, 4.0);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const auto query_path = [&](bool p_hierarchical, const Vector3 &p_target_position, int p_path_search_max_polygons) {
+			navigation_server->map_set_use_hierarchical_pathfinding(map, p_hierarchical);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			Ref<NavigationPathQueryParameters3D> query_parameters;
+			query_parameters.instantiate();
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(0.5, 0, 0.5));
+			query_parameters->set_target_position(p_target_position);
+			query_parameters->set_path_search_max_polygons(p_path_search_max_polygons);
+			Ref<NavigationPathQueryResult3D> query_result;
+			query_result.instantiate();
+			navigation_server->query_path(query_parameters, query_result);
+			return query_result->get_path();
+		};
+
+		SUBCASE("A route inside the corridor") {
+			const Vector<Vector3> path = query_path(false, Vector3(0.5, 0, 8.5), NavigationDefaults3D::path_search_max_polygons);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(0.5, 0, 8.5)));
+			CHECK_EQ(query_path(true, Vector3(0.5, 0, 8.5), NavigationDefaults3D::path_search_max_polygons), path);
+		}
+
+		SUBCASE("A route leaving the corridor") {
+			const Vector<Vector3> path = query_path(false, Vector3(4.5, 0, 0.5), NavigationDefaults3D::path_search_max_polygons);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(4.5, 0, 0.5)));
+			bool detours = false;
+			for (const Vector3 &point : path) {
+				detours = detours || point.z > 8.0;
+			}
+			CHECK(detours);
+			CHECK_EQ(query_path(true, Vector3(4.5, 0, 0.5), NavigationDefaults3D::path_search_max_polygons), path);
+		}
+
+		SUBCASE("A search stopped by the search limits") {
+			const Vector<Vector3> path = query_path(false, Vector3(4.5, 0, 0.5), 2);
+			CHECK_NE(path.size(), 0);
+			CHECK_EQ(query_path(true, Vector3(4.5, 0, 0.5), 2), path);
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -838,5 +1145,175 @@ TEST_SUITE("[Navigation3D]") {
 		Vector<Vector3> simplified_path = NavigationServer3D::get_singleton()->simplify_path(source_path, simplify_epsilon);
 		CHECK_EQ(simplified_path.size(), 4);
 	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Closest point queries on a large region") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		constexpr int SIZE = 128;
+		constexpr int QUERIES = 20000;
+		Math::seed(0);
+
+		Vector<bool> cells;
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(SIZE, cells);
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		LocalVector<Vector3> query_points;
+		for (int i = 0; i < QUERIES; i++) {
+			query_points.push_back(Vector3(Math::randf() * SIZE, 0.5, Math::randf() * SIZE));
+		}
+		LocalVector<Vector3> closest_points;
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		for (const Vector3 &query_point : query_points) {
+			closest_points.push_back(navigation_server->map_get_closest_point(map, query_point));
+		}
+		const uint64_t query_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		print_verbose(vformat("%d closest point queries on %d polygons: %d usec.", QUERIES, navigation_mesh->get_polygon_count(), query_usec));
+
+		// Points above a polygon are closest to the point right below them.
+		bool match = true;
+		for (int i = 0; i < QUERIES; i++) {
+			const Vector3 &query_point = query_points[i];
+			if (cells[(int)query_point.z * SIZE + (int)query_point.x]) {
+				match = match && closest_points[i].is_equal_approx(Vector3(query_point.x, 0, query_point.z));
+			}
+		}
+		CHECK_MESSAGE(match, "Found the closest points.");
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Hierarchical path queries on a large map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		constexpr int SIZE = 128;
+		constexpr int QUERIES = 200;
+		Math::seed(0);
+
+		Vector<bool> cells;
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(SIZE, cells);
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->map_set_hierarchical_cluster_size(map, 8.0);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+
+		LocalVector<Vector3> start_positions;
+		LocalVector<Vector3> target_positions;
+		for (int i = 0; i < QUERIES; i++) {
+			start_positions.push_back(Vector3(Math::randf() * SIZE, 0, Math::randf() * SIZE));
+			target_positions.push_back(Vector3(Math::randf() * SIZE, 0, Math::randf() * SIZE));
+		}
+		const auto query_paths = [&](bool p_hierarchical, LocalVector<Vector<Vector3>> &r_paths) {
+			navigation_server->map_set_use_hierarchical_pathfinding(map, p_hierarchical);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < QUERIES; i++) {
+				r_paths.push_back(navigation_server->map_get_path(map, start_positions[i], target_positions[i], true));
+			}
+			return OS::get_singleton()->get_ticks_usec() - start_usec;
+		};
+		LocalVector<Vector<Vector3>> paths;
+		const uint64_t flat_usec = query_paths(false, paths);
+		LocalVector<Vector<Vector3>> hierarchical_paths;
+		const uint64_t hierarchical_usec = query_paths(true, hierarchical_paths);
+		print_verbose(vformat("%d path queries on %d polygons: %d usec on the whole map, %d usec hierarchical.", QUERIES, navigation_mesh->get_polygon_count(), flat_usec, hierarchical_usec));
+
+		// Hierarchical paths may take another route, but have to reach the same end.
+		bool match = true;
+		for (int i = 0; i < QUERIES; i++) {
+			if (paths[i].is_empty() || hierarchical_paths[i].is_empty()) {
+				match = match && paths[i].is_empty() == hierarchical_paths[i].is_empty();
+			} else {
+				match = match && paths[i][paths[i].size() - 1].is_equal_approx(hierarchical_paths[i][hierarchical_paths[i].size() - 1]);
+			}
+		}
+		CHECK_MESSAGE(match, "Hierarchical paths reach the same ends.");
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Rebaking tiles after a local change") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(64.0, 0.001, 64.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		const uint64_t bake_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+		Ref<NavigationMesh> tiled_navigation_mesh = memnew(NavigationMesh);
+		tiled_navigation_mesh->set_tile_size(8.0);
+		start_usec = OS::get_singleton()->get_ticks_usec();
+		navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+		const uint64_t tiled_bake_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		const Vector<Vector3> tiled_vertices = tiled_navigation_mesh->get_vertices();
+
+		// An obstruction in the middle of the tile from (0, 0) to (8, 8).
+		Vector<Vector3> obstruction_vertices = { Vector3(3.5, 0, 3.5), Vector3(4.5, 0, 3.5), Vector3(4.5, 0, 4.5), Vector3(3.5, 0, 4.5) };
+		source_geometry->add_projected_obstruction(obstruction_vertices, -1.0, 2.0, false);
+		start_usec = OS::get_singleton()->get_ticks_usec();
+		navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+		const uint64_t tiled_rebake_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+
+		print_verbose(vformat("Baking a 64x64 plane: %d usec at once, %d usec in tiles, %d usec to rebake the tiles after a local change.", bake_usec, tiled_bake_usec, tiled_rebake_usec));
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+		CHECK_NE(tiled_vertices.size(), 0);
+		CHECK_NE(tiled_navigation_mesh->get_vertices(), tiled_vertices);
+	}
+
+	TEST_CASE("[Stress][NavigationServer3D] Avoidance of many agents") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		constexpr int AGENTS = 2048;
+		constexpr int STEPS = 30;
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		CallableMock avoidance_callback_mock;
+
+		// A crowd of 32x64 agents all heading to its center.
+		LocalVector<RID> agents;
+		for (int i = 0; i < AGENTS; i++) {
+			const Vector3 position = Vector3((i % 32) * 1.5, 0, (i / 32) * 1.5);
+			RID agent = navigation_server->agent_create();
+			navigation_server->agent_set_map(agent, map);
+			navigation_server->agent_set_avoidance_enabled(agent, true);
+			navigation_server->agent_set_position(agent, position);
+			navigation_server->agent_set_radius(agent, 0.5);
+			navigation_server->agent_set_neighbor_distance(agent, 5.0);
+			navigation_server->agent_set_velocity(agent, (Vector3(24, 0, 48) - position).limit_length(2.0));
+			navigation_server->agent_set_avoidance_callback(agent, callable_mp(&avoidance_callback_mock, &CallableMock::function1));
+			agents.push_back(agent);
+		}
+
+		const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < STEPS; i++) {
+			navigation_server->physics_process(1.0 / 60.0);
+		}
+		const uint64_t step_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		print_verbose(vformat("%d avoidance steps of %d agents: %d usec.", STEPS, AGENTS, step_usec));
+		CHECK_EQ(avoidance_callback_mock.function1_calls, (unsigned)(AGENTS * STEPS));
+
+		for (const RID &agent : agents) {
+			navigation_server->free(agent);
+		}
+		navigation_server->free(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
 }
 } //namespace TestNavigationServer3D